@@ -17,6 +17,44 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)processTouch:(CGPoint)touch withTapCount:(NSUInteger)tapCount;
 - (void)draw:(MTKView *)view;
 
+// JSON of live and peak bytes per buffer kind, texture level and format and CPU structure,
+// see memory_tracker.hpp
+- (NSString *)memoryReport;
+- (BOOL)writeMemoryReportToURL:(NSURL *)url error:(NSError **)error;
+
+// JSON report of per-phase load time and allocations, see load_benchmark.hpp
++ (nullable NSString *)runLoadBenchmarkWithAssetsURL:(NSURL *)assetsURL
+                                                cold:(BOOL)cold
+                                            runCount:(NSUInteger)runCount
+                                               error:(NSError **)error;
+
+// JSON report of block compression size and PSNR per texture, see compression_report.hpp
++ (nullable NSString *)runCompressionReportWithAssetsURL:(NSURL *)assetsURL
+                                                 quality:(BOOL)quality
+                                                   error:(NSError **)error;
+
+// JSON report of per-system update time of a scripted game, see simulation_benchmark.hpp,
+// fails if a steady state frame allocates and `requireZeroAllocations` is set
++ (nullable NSString *)runSimulationBenchmarkWithAssetsURL:(NSURL *)assetsURL
+                                                frameCount:(NSUInteger)frameCount
+                                    requireZeroAllocations:(BOOL)requireZeroAllocations
+                                                     error:(NSError **)error;
+
+// Packs the assets directory into its assets.pack, which is read instead of loose files from
+// then on. JSON report of entry count and sizes, see asset_storage.hpp
++ (nullable NSString *)buildPackWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error;
+
+// Cooks every texture of the assets directory to an .atex file next to its source, texture
+// managers load those instead. JSON report of the cooked files, see texture_cooker.hpp
++ (nullable NSString *)cookTexturesWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error;
+
+// JSON report of mip levels streamed for the cooked textures of the assets directory, generated
+// ones if there are none, see texture_streaming_benchmark.hpp
++ (nullable NSString *)runTextureStreamingBenchmarkWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error;
+
+// JSON report of virtual texture update time and page residency, see virtual_texture_benchmark.hpp
++ (nullable NSString *)runVirtualTextureBenchmarkWithError:(NSError **)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,15 +9,22 @@
 
 #include <filesystem>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 
+#include "asset_storage.hpp"
 #include "buffer_manager.h"
 #include "bullet_system.hpp"
 #include "camera_system.hpp"
+#include "compression_report.hpp"
 #include "enemy_system.hpp"
+#include "frame_arena.hpp"
 #include "game_restart_system.hpp"
+#include "hot_reload_system.hpp"
 #include "hud.h"
 #include "instanced_mesh_manager.hpp"
+#include "load_benchmark.hpp"
+#include "memory_tracker.hpp"
 #include "metal_context.h"
 #include "objc_ref.h"
 #include "player_animation_system.hpp"
@@ -26,16 +33,25 @@
 #include "resource_manager.hpp"
 #include "scene.hpp"
 #include "shooting_system.hpp"
+#include "simulation_benchmark.hpp"
+#include "texture_cooker.hpp"
 #include "texture_manager.h"
+#include "texture_streaming_benchmark.hpp"
 #include "timer.hpp"
+#include "virtual_texture_benchmark.hpp"
+#include "world_streaming_system.hpp"
 
 @implementation Game
 {
     std::filesystem::path assets_path;
+    // first member, managers report to it until they are gone
+    std::unique_ptr<angry::MemoryTracker> memory_tracker;
+    std::unique_ptr<angry::AssetStorage> asset_storage;
     std::unique_ptr<angry::BufferManager> buffer_manager;
     std::unique_ptr<angry::InstancedMeshManager> instanced_mesh_manager;
     std::unique_ptr<angry::TextureManager> texture_manager;
     std::unique_ptr<angry::ResourceManager> resource_manager;
+    std::unique_ptr<angry::FrameArena> frame_arena;
 
     std::unique_ptr<angry::PlayerInputSystem> player_input_system;
     std::unique_ptr<angry::CameraSystem> camera_system;
@@ -44,6 +60,8 @@
     std::unique_ptr<angry::BulletSystem> bullet_system;
     std::unique_ptr<angry::ShootingSystem> shooting_system;
     std::unique_ptr<angry::GameRestartSystem> game_restart_system;
+    std::unique_ptr<angry::WorldStreamingSystem> world_streaming_system;
+    std::unique_ptr<angry::HotReloadSystem> hot_reload_system;
 
     std::unique_ptr<angry::Renderer> renderer;
     std::unique_ptr<angry::Scene> scene;
@@ -63,36 +81,78 @@
     return self;
 }
 
+- (void)dealloc
+{
+    // members are destroyed after this, nothing reports to the tracker of a game that is gone
+    angry::MemoryTracker::set_current(nullptr);
+    [super dealloc];
+}
+
 - (BOOL)setup:(id<MTLDevice>)device error:(NSError **)error
 {
     using namespace angry;
 
+    memory_tracker = std::make_unique<MemoryTracker>();
+    MemoryTracker::set_current(memory_tracker.get());
+
     buffer_manager = std::make_unique<BufferManager>(device);
     instanced_mesh_manager = std::make_unique<InstancedMeshManager>();
-    texture_manager = std::make_unique<TextureManager>(device);
-    resource_manager = std::make_unique<ResourceManager>(*buffer_manager,
-                                                         *instanced_mesh_manager,
-                                                         *texture_manager);
-
+    frame_arena = std::make_unique<FrameArena>(FrameArena::Settings{});
     player_input_system = std::make_unique<PlayerInputSystem>();
     camera_system = std::make_unique<CameraSystem>();
-    player_animation_system = std::make_unique<PlayerAnimationSystem>(*buffer_manager);
+    player_animation_system = std::make_unique<PlayerAnimationSystem>(*buffer_manager, *frame_arena);
     enemy_system = std::make_unique<EnemySystem>();
     bullet_system = std::make_unique<BulletSystem>();
     shooting_system = std::make_unique<ShootingSystem>();
     game_restart_system = std::make_unique<GameRestartSystem>();
+    const WorldStreamingSystem::Settings world_streaming_settings;
+    world_streaming_system = std::make_unique<WorldStreamingSystem>(*buffer_manager, world_streaming_settings);
 
     try
     {
-        scene = std::make_unique<Scene>(resource_manager.get());
+        asset_storage = std::make_unique<AssetStorage>(assets_path);
+        // launch with -no-mipmaps to compare sampling bandwidth in a GPU frame capture
+        TextureManager::Settings texture_settings;
+        texture_settings.is_mipmapped = ![NSProcessInfo.processInfo.arguments containsObject:@"-no-mipmaps"];
+        // big devices keep more high levels of cooked textures resident
+        texture_settings.streaming.budget_bytes = size_t(NSProcessInfo.processInfo.physicalMemory / 16);
+        texture_settings.atlas_paths = {
+            assets_path / "Bullet" / "Bullet_D.png",
+            assets_path / "HUD" / "Button.png"
+        };
+        texture_manager = std::make_unique<TextureManager>(device, *asset_storage, texture_settings);
+        resource_manager = std::make_unique<ResourceManager>(*buffer_manager,
+                                                             *instanced_mesh_manager,
+                                                             *texture_manager,
+                                                             *asset_storage);
+
+        scene = std::make_unique<Scene>(resource_manager.get(),
+                                        WorldStreamingSystem::get_max_chunk_count(world_streaming_settings));
         scene->load(assets_path);
+        world_streaming_system->load(*scene);
 
         renderer = std::make_unique<Renderer>(buffer_manager.get(),
                                               instanced_mesh_manager.get(),
                                               texture_manager.get());
         renderer->setup(device);
 
-        hud = std::make_unique<HUD>(device, texture_manager.get(), assets_path);
+        // rasterized HUD fonts are kept in caches, the system may purge them at any time
+        NSURL* caches_url = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory
+                                                                inDomains:NSUserDomainMask].firstObject;
+        const std::filesystem::path cache_directory = caches_url != nil ? caches_url.path.UTF8String : "";
+        hud = std::make_unique<HUD>(device, texture_manager.get(), *asset_storage, assets_path, cache_directory);
+
+#if DEBUG
+        const auto& cache = texture_manager->get_cache_statistics();
+        NSLog(@"texture cache: %zu requests, %.0f%% hits, %zu bytes saved",
+              cache.request_count, 100.0 * cache.get_hit_rate(), cache.saved_bytes);
+
+        // cooked pack is not watched, only loose files
+        if (!asset_storage->has_pack())
+        {
+            hot_reload_system = std::make_unique<HotReloadSystem>(make_file_watcher(assets_path));
+        }
+#endif
     }
     catch (const std::runtime_error& e)
     {
@@ -118,9 +178,25 @@
         return;
     }
 
+    if (hot_reload_system)
+    {
+        try
+        {
+            hot_reload_system->update(*scene);
+        }
+        catch (const std::runtime_error& e)
+        {
+            NSLog(@"ERROR: %s", e.what());
+        }
+    }
+
+    // dynamic buffers written from here on belong to this frame
+    buffer_manager->begin_frame();
+
     // system order is important
     game_restart_system->update(*scene, _timer.get_delta_time());
     player_input_system->update(*scene, _timer.get_delta_time());
+    world_streaming_system->update(*scene);
     shooting_system->update(*scene, _timer);
     enemy_system->update(*scene, _timer.get_delta_time());
     camera_system->update(*scene, static_cast<float>(view.bounds.size.width / view.bounds.size.height));
@@ -129,6 +205,8 @@
 
     [self render:view];
 
+    // transient data of systems is not kept past the frame
+    frame_arena->reset();
     _timer.update();
 }
 
@@ -136,6 +214,8 @@
 {
     id<MTLCommandBuffer> command_buffer = [command_queue.get() commandBuffer];
     MTLRenderPassDescriptor* render_pass_descriptor = view.currentRenderPassDescriptor;
+    // the ring region of the frame is given back on completion even without a drawable
+    buffer_manager->end_frame(command_buffer);
     if (render_pass_descriptor == nil)
     {
         [command_buffer commit];
@@ -167,4 +247,171 @@
     [command_buffer commit];
 }
 
+- (NSString *)memoryReport
+{
+    if (!memory_tracker)
+    {
+        return @"{}";
+    }
+
+    if (scene)
+    {
+        scene->report_memory();
+    }
+
+    std::stringstream report;
+    memory_tracker->write_json(report);
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
+- (BOOL)writeMemoryReportToURL:(NSURL *)url error:(NSError **)error
+{
+    NSString* report = [self memoryReport];
+    return [report writeToURL:url atomically:YES encoding:NSUTF8StringEncoding error:error];
+}
+
++ (nullable NSString *)runLoadBenchmarkWithAssetsURL:(NSURL *)assetsURL
+                                                cold:(BOOL)cold
+                                            runCount:(NSUInteger)runCount
+                                               error:(NSError **)error
+{
+    angry::LoadBenchmarkSettings settings;
+    settings.assets_path = assetsURL.path.UTF8String;
+    settings.is_cold = cold;
+    settings.run_count = runCount;
+
+    std::stringstream report;
+    try
+    {
+        angry::run_load_benchmark(settings, report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)runCompressionReportWithAssetsURL:(NSURL *)assetsURL
+                                                 quality:(BOOL)quality
+                                                   error:(NSError **)error
+{
+    angry::CompressionReportSettings settings;
+    settings.assets_path = assetsURL.path.UTF8String;
+    settings.preset = quality ? angry::CompressionPreset::quality : angry::CompressionPreset::fast;
+
+    std::stringstream report;
+    try
+    {
+        angry::run_compression_report(settings, report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)runSimulationBenchmarkWithAssetsURL:(NSURL *)assetsURL
+                                                frameCount:(NSUInteger)frameCount
+                                    requireZeroAllocations:(BOOL)requireZeroAllocations
+                                                     error:(NSError **)error
+{
+    angry::SimulationBenchmarkSettings settings;
+    settings.assets_path = assetsURL.path.UTF8String;
+    settings.frame_count = frameCount;
+    settings.require_zero_allocations = requireZeroAllocations;
+
+    std::stringstream report;
+    try
+    {
+        angry::run_simulation_benchmark(settings, report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)buildPackWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error
+{
+    std::stringstream report;
+    try
+    {
+        angry::build_asset_pack(assetsURL.path.UTF8String, report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)cookTexturesWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error
+{
+    std::stringstream report;
+    try
+    {
+        angry::run_texture_cooker(assetsURL.path.UTF8String, angry::TextureCookSettings(), report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)runTextureStreamingBenchmarkWithAssetsURL:(NSURL *)assetsURL error:(NSError **)error
+{
+    angry::TextureStreamingBenchmarkSettings settings;
+    settings.assets_path = assetsURL.path.UTF8String;
+
+    std::stringstream report;
+    try
+    {
+        angry::run_texture_streaming_benchmark(settings, report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
++ (nullable NSString *)runVirtualTextureBenchmarkWithError:(NSError **)error
+{
+    std::stringstream report;
+    try
+    {
+        angry::run_virtual_texture_benchmark(angry::VirtualTextureBenchmarkSettings(), report);
+    }
+    catch (const std::runtime_error& e)
+    {
+        NSLog(@"ERROR: %s", e.what());
+        *error = [NSError errorWithDomain:@"AngryKit" code:0 userInfo:nil];
+        return nil;
+    }
+
+    return [NSString stringWithUTF8String:report.str().c_str()];
+}
+
 @end
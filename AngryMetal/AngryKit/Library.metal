@@ -60,7 +60,7 @@ vertex BasicOutputVertex basic_vertex_shader(BasicInputVertex input_vertex [[sta
     return output;
 }
 
-constexpr sampler basic_sampler(address::repeat, filter::linear);
+constexpr sampler basic_sampler(address::repeat, filter::linear, mip_filter::linear);
 constexpr sampler shadow_map_sampler(address::clamp_to_border, filter::nearest);
 
 float shadow_calculation_1(float bias, float4 frag_pos_light_space, float2 offset, depth2d<float, access::sample> shadow_map)
@@ -87,8 +87,9 @@ fragment half4 floor_fragment_shader(BasicOutputVertex input [[stage_in]],
     if (uniforms.use_light)
     {
         float3 light_direction = normalize(-uniforms.direction_light.direction);
-        float3 normal = normal_texture.sample(basic_sampler, input.uv).xyz;
-        normal = normalize(normal * 2.0f - 1.0f);
+        // z is rebuilt so two channel (BC5) normal maps work as well
+        float2 normal_xy = normal_texture.sample(basic_sampler, input.uv).xy * 2.0f - 1.0f;
+        float3 normal = float3(normal_xy, sqrt(saturate(1.0f - dot(normal_xy, normal_xy))));
         float diff = max(dot(normal, light_direction), 0.0f);
         float3 ambient = uniforms.ambient_color * color.xyz;
 
@@ -281,7 +282,7 @@ vertex BasicOutputVertex bullet_vertex_shader(BasicInputVertex input_vertex [[st
 {
     BasicOutputVertex output;
     output.position = uniforms.pv * model_matrix[iid] * float4(input_vertex.position, 1.0f);;
-    output.uv = input_vertex.uv;
+    output.uv = input_vertex.uv * uniforms.uv_transform.xy + uniforms.uv_transform.zw;
     return output;
 }
 
@@ -0,0 +1,73 @@
+//
+//  aligned_allocator.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace angry
+{
+
+// Metal wants constant buffer offsets aligned to 256 bytes on macOS, the CPU backend
+// keeps buffers and texture levels on the same boundary.
+constexpr size_t gpu_memory_alignment = 256;
+
+constexpr size_t align_size(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+template<typename T, size_t Alignment>
+class AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "alignment is not a power of two");
+
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+};
+
+template<typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+template<typename T, size_t Alignment = gpu_memory_alignment>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+}
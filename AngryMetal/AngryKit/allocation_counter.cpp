@@ -0,0 +1,134 @@
+//
+//  allocation_counter.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "allocation_counter.hpp"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace angry;
+
+namespace
+{
+
+thread_local AllocationCount thread_allocation_count;
+
+}
+
+#if defined(ANGRY_COUNT_ALLOCATIONS)
+
+namespace
+{
+
+void free_counted(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        thread_allocation_count.free_count += 1;
+    }
+    std::free(p);
+}
+
+}
+
+// nothrow variants forward to these by default
+
+void* operator new(std::size_t size)
+{
+    thread_allocation_count.count += 1;
+    thread_allocation_count.bytes += size;
+
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    free_counted(p);
+}
+
+// aligned buffers of the CPU backend
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    thread_allocation_count.count += 1;
+    thread_allocation_count.bytes += size;
+
+    void* p = nullptr;
+    if (posix_memalign(&p, std::max(std::size_t(alignment), sizeof(void*)), size == 0 ? 1 : size) != 0)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    free_counted(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    free_counted(p);
+}
+
+#endif
+
+bool angry::is_allocation_counting_enabled()
+{
+#if defined(ANGRY_COUNT_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCount angry::get_thread_allocation_count()
+{
+    return thread_allocation_count;
+}
@@ -0,0 +1,30 @@
+//
+//  allocation_counter.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace angry
+{
+
+struct AllocationCount
+{
+    size_t count = 0;
+    size_t bytes = 0;
+    // deletes of non null pointers
+    size_t free_count = 0;
+};
+
+// Global operator new is replaced only in builds with ANGRY_COUNT_ALLOCATIONS,
+// otherwise counts stay zero.
+bool is_allocation_counting_enabled();
+
+// Allocations made by the calling thread since it started.
+AllocationCount get_thread_allocation_count();
+
+}
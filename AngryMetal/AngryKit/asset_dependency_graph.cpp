@@ -0,0 +1,117 @@
+//
+//  asset_dependency_graph.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "asset_dependency_graph.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+
+using namespace angry;
+
+void AssetDependencyGraph::add_dependency(const std::filesystem::path& asset, const std::filesystem::path& dependency)
+{
+    auto& dependencies = _dependencies[asset];
+    if (std::find(dependencies.cbegin(), dependencies.cend(), dependency) != dependencies.cend())
+    {
+        return;
+    }
+    dependencies.push_back(dependency);
+    _dependents[dependency].push_back(asset);
+}
+
+std::vector<std::filesystem::path> AssetDependencyGraph::get_affected(const std::vector<std::filesystem::path>& changed) const
+{
+    // post order over dependents gives every asset before its dependencies, reversed at the end
+    std::map<std::filesystem::path, bool> visited;
+    std::vector<std::filesystem::path> order;
+    for (const auto& path : changed)
+    {
+        visit(_dependents, path, visited, order);
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<std::filesystem::path> AssetDependencyGraph::get_stale() const
+{
+    std::map<std::filesystem::path, bool> visited;
+    std::vector<std::filesystem::path> order;
+    for (const auto& p : _dependencies)
+    {
+        visit(_dependencies, p.first, visited, order);
+    }
+
+    // dependencies come first, stale assets are going to be rebuilt and count as new
+    std::map<std::filesystem::path, std::optional<std::filesystem::file_time_type>> times;
+    std::vector<std::filesystem::path> result;
+    for (const auto& node : order)
+    {
+        std::error_code error;
+        std::optional<std::filesystem::file_time_type> time = std::filesystem::last_write_time(node, error);
+        if (error)
+        {
+            time = std::nullopt;
+        }
+
+        auto i = _dependencies.find(node);
+        if (i != _dependencies.end())
+        {
+            const bool is_stale = !time || std::any_of(i->second.cbegin(), i->second.cend(), [&](const auto& d) {
+                const auto& t = times[d];
+                return !t || *t > *time;
+            });
+            if (is_stale)
+            {
+                result.push_back(node);
+                time = std::filesystem::file_time_type::max();
+            }
+        }
+
+        times[node] = time;
+    }
+    return result;
+}
+
+const std::vector<std::filesystem::path>& AssetDependencyGraph::get_dependencies(const std::filesystem::path& asset) const
+{
+    static const std::vector<std::filesystem::path> empty;
+    auto i = _dependencies.find(asset);
+    return i == _dependencies.end() ? empty : i->second;
+}
+
+void AssetDependencyGraph::visit(
+    const Edges& edges,
+    const std::filesystem::path& node,
+    std::map<std::filesystem::path, bool>& visited,
+    std::vector<std::filesystem::path>& order
+)
+{
+    // false while the node is on the stack
+    auto p = visited.emplace(node, false);
+    if (!p.second)
+    {
+        if (!p.first->second)
+        {
+            throw std::runtime_error("AssetDependencyGraph::visit() cycle at " + node.string());
+        }
+        return;
+    }
+
+    auto i = edges.find(node);
+    if (i != edges.end())
+    {
+        for (const auto& next : i->second)
+        {
+            visit(edges, next, visited, order);
+        }
+    }
+
+    visited[node] = true;
+    order.push_back(node);
+}
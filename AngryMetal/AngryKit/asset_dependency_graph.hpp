@@ -0,0 +1,47 @@
+//
+//  asset_dependency_graph.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <vector>
+
+namespace angry
+{
+
+// Which assets are built from which files, nodes are file paths.
+class AssetDependencyGraph final
+{
+public:
+    void add_dependency(const std::filesystem::path& asset, const std::filesystem::path& dependency);
+
+    // Changed files and everything depending on them, every asset comes after its dependencies.
+    std::vector<std::filesystem::path> get_affected(const std::vector<std::filesystem::path>& changed) const;
+
+    // Assets which are missing or older than any of their direct or indirect dependencies,
+    // a cooker rebuilds them in the returned order.
+    std::vector<std::filesystem::path> get_stale() const;
+
+    const std::vector<std::filesystem::path>& get_dependencies(const std::filesystem::path& asset) const;
+
+private:
+    using Edges = std::map<std::filesystem::path, std::vector<std::filesystem::path>>;
+
+    static void visit(
+        const Edges& edges,
+        const std::filesystem::path& node,
+        std::map<std::filesystem::path, bool>& visited,
+        std::vector<std::filesystem::path>& order
+    );
+
+private:
+    Edges _dependencies;
+    Edges _dependents;
+};
+
+}
@@ -0,0 +1,150 @@
+//
+//  asset_storage.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "asset_storage.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "on_exit.hpp"
+
+using namespace angry;
+
+AssetStorage::AssetStorage(const std::filesystem::path& assets_path)
+    : AssetStorage(assets_path, make_async_file_reader())
+{
+}
+
+AssetStorage::AssetStorage(const std::filesystem::path& assets_path, std::unique_ptr<AsyncFileReaderInterface> file_reader)
+    : _assets_path(assets_path), _file_reader(std::move(file_reader))
+{
+    const auto pack_path = assets_path / pack_file_name;
+    if (std::filesystem::exists(pack_path))
+    {
+        _pack = std::make_unique<PackReader>(pack_path, *_file_reader);
+    }
+}
+
+std::vector<uint8_t> AssetStorage::read(const std::filesystem::path& file_path) const
+{
+    return std::move(read(std::vector<std::filesystem::path>{file_path}).front());
+}
+
+std::vector<std::vector<uint8_t>> AssetStorage::read(const std::vector<std::filesystem::path>& file_paths) const
+{
+    std::vector<std::vector<uint8_t>> result(file_paths.size());
+    read(file_paths, [&](size_t index, std::vector<uint8_t>& data) {
+        result[index] = std::move(data);
+    });
+    return result;
+}
+
+void AssetStorage::read(const std::vector<std::filesystem::path>& file_paths, const ReadCallback& on_read) const
+{
+    if (_pack)
+    {
+        std::vector<const PackEntry*> entries;
+        entries.reserve(file_paths.size());
+        for (const auto& file_path : file_paths)
+        {
+            entries.push_back(&find_entry(file_path));
+        }
+        _pack->read(entries, on_read);
+        return;
+    }
+
+    std::vector<int> files(file_paths.size(), -1);
+    OnExit close_files([&files]() {
+        for (int file : files)
+        {
+            if (file >= 0)
+            {
+                close(file);
+            }
+        }
+    });
+
+    std::vector<std::vector<uint8_t>> data(file_paths.size());
+    std::vector<AsyncFileReaderInterface::Request> requests(file_paths.size());
+    for (size_t i = 0; i < file_paths.size(); i++)
+    {
+        struct stat file_stat;
+        files[i] = open(file_paths[i].c_str(), O_RDONLY);
+        if (files[i] < 0 || fstat(files[i], &file_stat) != 0)
+        {
+            std::stringstream t;
+            t << "AssetStorage::read() fail to open " << file_paths[i] << ", " << std::strerror(errno);
+            throw std::runtime_error(t.str());
+        }
+        data[i].resize(static_cast<size_t>(file_stat.st_size));
+
+        auto& request = requests[i];
+        request.file = files[i];
+        request.target = data[i].data();
+        request.size = data[i].size();
+        request.on_complete = [&, i]() {
+            on_read(i, data[i]);
+        };
+    }
+
+    _file_reader->read(requests);
+}
+
+bool AssetStorage::has_pack() const
+{
+    return _pack != nullptr;
+}
+
+const PackEntry& AssetStorage::find_entry(const std::filesystem::path& file_path) const
+{
+    const auto path = file_path.lexically_relative(_assets_path).generic_string();
+    const auto* entry = _pack->find(path);
+    if (entry == nullptr)
+    {
+        std::stringstream t;
+        t << "AssetStorage::find_entry() no entry for " << file_path;
+        throw std::runtime_error(t.str());
+    }
+    return *entry;
+}
+
+void angry::build_asset_pack(const std::filesystem::path& assets_path, std::ostream& output)
+{
+    const auto pack_path = assets_path / AssetStorage::pack_file_name;
+    write_pack(assets_path, pack_path);
+
+    // the game opens the pack the same way, a broken entry fails here and not at load
+    const auto file_reader = make_async_file_reader();
+    const PackReader pack(pack_path, *file_reader);
+    const auto& entries = pack.get_entries();
+
+    size_t bytes = 0;
+    size_t stored_bytes = 0;
+    size_t compressed_count = 0;
+    std::vector<const PackEntry*> reads;
+    for (const auto& entry : entries)
+    {
+        bytes += entry.size;
+        stored_bytes += entry.stored_size;
+        compressed_count += entry.codec == PackCodec::none ? 0 : 1;
+        reads.push_back(&entry);
+    }
+
+    pack.read(reads, [](size_t, std::vector<uint8_t>&) {});
+
+    output << "{\"entries\": " << entries.size()
+        << ", \"compressed_entries\": " << compressed_count
+        << ", \"bytes\": " << bytes
+        << ", \"stored_bytes\": " << stored_bytes
+        << ", \"file_bytes\": " << std::filesystem::file_size(pack_path) << "}\n";
+}
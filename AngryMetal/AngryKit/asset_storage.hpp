@@ -0,0 +1,63 @@
+//
+//  asset_storage.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "async_file_reader.hpp"
+#include "pack_file.hpp"
+
+namespace angry
+{
+
+// Reads assets from `assets.pack` if the assets directory has one, otherwise from loose files.
+// All reads go through AsyncFileReaderInterface.
+class AssetStorage final
+{
+public:
+    static constexpr const char* pack_file_name = "assets.pack";
+
+    // called on a worker thread with the data of `file_paths[index]`
+    using ReadCallback = std::function<void(size_t index, std::vector<uint8_t>& data)>;
+
+    explicit AssetStorage(const std::filesystem::path& assets_path);
+    AssetStorage(const std::filesystem::path& assets_path, std::unique_ptr<AsyncFileReaderInterface> file_reader);
+
+    AssetStorage(const AssetStorage&) = delete;
+    AssetStorage(AssetStorage&&) = delete;
+    AssetStorage& operator=(const AssetStorage&) = delete;
+    AssetStorage& operator=(AssetStorage&&) = delete;
+
+    // Paths are absolute paths inside the assets directory.
+    std::vector<uint8_t> read(const std::filesystem::path& file_path) const;
+    std::vector<std::vector<uint8_t>> read(const std::vector<std::filesystem::path>& file_paths) const;
+
+    // Reads all files in one batch, decoding can be done in `on_read` while other reads are in flight.
+    void read(const std::vector<std::filesystem::path>& file_paths, const ReadCallback& on_read) const;
+
+    bool has_pack() const;
+
+private:
+    const PackEntry& find_entry(const std::filesystem::path& file_path) const;
+
+private:
+    std::filesystem::path _assets_path;
+    std::unique_ptr<AsyncFileReaderInterface> _file_reader;
+    std::unique_ptr<PackReader> _pack;
+};
+
+// Packs every file of the assets directory into its `assets.pack`, AssetStorage reads from it
+// from then on. Reads every entry back and writes entry count and sizes as JSON.
+void build_asset_pack(const std::filesystem::path& assets_path, std::ostream& output);
+
+}
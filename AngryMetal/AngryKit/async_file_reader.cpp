@@ -0,0 +1,454 @@
+//
+//  async_file_reader.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "async_file_reader.hpp"
+
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace angry;
+
+namespace
+{
+
+void read_file(const AsyncFileReaderInterface::Request& request)
+{
+    uint8_t* target = request.target;
+    uint64_t offset = request.offset;
+    size_t size = request.size;
+    while (size > 0)
+    {
+        const auto count = pread(request.file, target, size, static_cast<off_t>(offset));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            std::stringstream t;
+            t << "read_file() fail to read, " << (count == 0 ? "unexpected end of file" : std::strerror(errno));
+            throw std::runtime_error(t.str());
+        }
+        target += count;
+        offset += count;
+        size -= count;
+    }
+}
+
+// tasks of one read() on the pool of the reader
+class TaskGroup final
+{
+public:
+    explicit TaskGroup(WorkerPool& workers) : _workers(workers)
+    {
+    }
+
+    ~TaskGroup()
+    {
+        // posted tasks point into the group and the requests
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]() { return _pending == 0; });
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&) = delete;
+
+    void post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending += 1;
+        }
+        _workers.post([this, task = std::move(task)]() {
+            std::exception_ptr error;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            // notified under the lock, the group is gone once wait() sees the last task
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (error && !_error)
+            {
+                _error = error;
+            }
+            _pending -= 1;
+            if (_pending == 0)
+            {
+                _condition.notify_all();
+            }
+        });
+    }
+
+    // returns when every posted task is done, the first failure is rethrown
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]() { return _pending == 0; });
+        if (_error)
+        {
+            std::rethrow_exception(_error);
+        }
+    }
+
+private:
+    WorkerPool& _workers;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    size_t _pending = 0;
+    std::exception_ptr _error;
+};
+
+#if defined(__linux__)
+
+class IoUringFileReader final : public AsyncFileReaderInterface
+{
+public:
+    explicit IoUringFileReader(unsigned int queue_depth);
+    ~IoUringFileReader();
+
+    IoUringFileReader(const IoUringFileReader&) = delete;
+    IoUringFileReader(IoUringFileReader&&) = delete;
+    IoUringFileReader& operator=(const IoUringFileReader&) = delete;
+    IoUringFileReader& operator=(IoUringFileReader&&) = delete;
+
+    void read(const std::vector<Request>& requests) override;
+
+private:
+    struct Progress
+    {
+        iovec vector;
+        uint64_t offset = 0;
+    };
+
+    void push(size_t index, int file, Progress& progress);
+    void submit(unsigned int count, unsigned int min_complete);
+    void release();
+
+private:
+    std::mutex _mutex;
+    WorkerPool _workers;
+
+    int _ring = -1;
+    io_uring_params _params;
+
+    void* _sq_memory = MAP_FAILED;
+    size_t _sq_size = 0;
+    void* _cq_memory = MAP_FAILED;
+    size_t _cq_size = 0;
+    io_uring_sqe* _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+
+    unsigned int* _sq_head = nullptr;
+    unsigned int* _sq_tail = nullptr;
+    unsigned int* _sq_mask = nullptr;
+    unsigned int* _sq_array = nullptr;
+    unsigned int* _cq_head = nullptr;
+    unsigned int* _cq_tail = nullptr;
+    unsigned int* _cq_mask = nullptr;
+    io_uring_cqe* _cqes = nullptr;
+};
+
+IoUringFileReader::IoUringFileReader(unsigned int queue_depth)
+{
+    std::memset(&_params, 0, sizeof(_params));
+    _ring = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &_params));
+    if (_ring < 0)
+    {
+        throw std::runtime_error("IoUringFileReader() io_uring is not available");
+    }
+
+    _sq_size = _params.sq_off.array + _params.sq_entries * sizeof(unsigned int);
+    _cq_size = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+    const bool is_single_mmap = (_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (is_single_mmap)
+    {
+        _sq_size = std::max(_sq_size, _cq_size);
+    }
+
+    _sq_memory = mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+    if (_sq_memory != MAP_FAILED && !is_single_mmap)
+    {
+        _cq_memory = mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_CQ_RING);
+    }
+    const size_t sqes_size = _params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = static_cast<io_uring_sqe*>(
+        mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES)
+    );
+
+    if (_sq_memory == MAP_FAILED || (!is_single_mmap && _cq_memory == MAP_FAILED) || _sqes == MAP_FAILED)
+    {
+        release();
+        throw std::runtime_error("IoUringFileReader() fail to map rings");
+    }
+
+    auto* sq = static_cast<uint8_t*>(_sq_memory);
+    _sq_head = reinterpret_cast<unsigned int*>(sq + _params.sq_off.head);
+    _sq_tail = reinterpret_cast<unsigned int*>(sq + _params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned int*>(sq + _params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned int*>(sq + _params.sq_off.array);
+
+    auto* cq = static_cast<uint8_t*>(is_single_mmap ? _sq_memory : _cq_memory);
+    _cq_head = reinterpret_cast<unsigned int*>(cq + _params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned int*>(cq + _params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned int*>(cq + _params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cq + _params.cq_off.cqes);
+}
+
+IoUringFileReader::~IoUringFileReader()
+{
+    release();
+}
+
+void IoUringFileReader::release()
+{
+    if (_sqes != MAP_FAILED)
+    {
+        munmap(_sqes, _params.sq_entries * sizeof(io_uring_sqe));
+        _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+    if (_cq_memory != MAP_FAILED)
+    {
+        munmap(_cq_memory, _cq_size);
+        _cq_memory = MAP_FAILED;
+    }
+    if (_sq_memory != MAP_FAILED)
+    {
+        munmap(_sq_memory, _sq_size);
+        _sq_memory = MAP_FAILED;
+    }
+    if (_ring >= 0)
+    {
+        close(_ring);
+        _ring = -1;
+    }
+}
+
+void IoUringFileReader::read(const std::vector<Request>& requests)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<Progress> progress(requests.size());
+    std::deque<size_t> pending;
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        progress[i].vector.iov_base = requests[i].target;
+        progress[i].vector.iov_len = requests[i].size;
+        progress[i].offset = requests[i].offset;
+        if (requests[i].size > 0)
+        {
+            pending.push_back(i);
+        }
+    }
+
+    TaskGroup tasks(_workers);
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        if (requests[i].size == 0 && requests[i].on_complete)
+        {
+            tasks.post(requests[i].on_complete);
+        }
+    }
+
+    std::exception_ptr error;
+    unsigned int in_flight = 0;
+    while ((!pending.empty() && !error) || in_flight > 0)
+    {
+        unsigned int count = 0;
+        while (!error && !pending.empty() && in_flight + count < _params.sq_entries)
+        {
+            const auto index = pending.front();
+            pending.pop_front();
+            push(index, requests[index].file, progress[index]);
+            count += 1;
+        }
+
+        try
+        {
+            submit(count, in_flight + count > 0 ? 1 : 0);
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            else
+            {
+                // waiting fails as well, submitted reads still complete into the ring
+                std::this_thread::yield();
+            }
+
+            // entries the kernel did not take are dropped so the next read does not submit them,
+            // taken ones still write to targets and progress and are reaped before returning
+            const unsigned int head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+            count -= *_sq_tail - head;
+            __atomic_store_n(_sq_tail, head, __ATOMIC_RELEASE);
+        }
+        in_flight += count;
+
+        unsigned int head = *_cq_head;
+        const unsigned int tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++)
+        {
+            const auto& cqe = _cqes[head & *_cq_mask];
+            const auto index = static_cast<size_t>(cqe.user_data);
+            in_flight -= 1;
+
+            auto& p = progress[index];
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+            {
+                pending.push_back(index);
+                continue;
+            }
+            if (cqe.res <= 0)
+            {
+                if (!error)
+                {
+                    std::stringstream t;
+                    t << "IoUringFileReader::read() fail to read, "
+                        << (cqe.res == 0 ? "unexpected end of file" : std::strerror(-cqe.res));
+                    error = std::make_exception_ptr(std::runtime_error(t.str()));
+                }
+                continue;
+            }
+
+            // short read, continue from where it stopped
+            const auto count = static_cast<size_t>(cqe.res);
+            if (count < p.vector.iov_len)
+            {
+                p.vector.iov_base = static_cast<uint8_t*>(p.vector.iov_base) + count;
+                p.vector.iov_len -= count;
+                p.offset += count;
+                pending.push_back(index);
+                continue;
+            }
+
+            if (requests[index].on_complete)
+            {
+                tasks.post(requests[index].on_complete);
+            }
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    try
+    {
+        tasks.wait();
+    }
+    catch (...)
+    {
+        if (!error)
+        {
+            error = std::current_exception();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void IoUringFileReader::push(size_t index, int file, Progress& progress)
+{
+    const unsigned int tail = *_sq_tail;
+    const unsigned int slot = tail & *_sq_mask;
+
+    auto& sqe = _sqes[slot];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = file;
+    sqe.addr = reinterpret_cast<uint64_t>(&progress.vector);
+    sqe.len = 1;
+    sqe.off = progress.offset;
+    sqe.user_data = index;
+
+    _sq_array[slot] = slot;
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+void IoUringFileReader::submit(unsigned int count, unsigned int min_complete)
+{
+    // submission can be partial, interrupted call submits nothing
+    do
+    {
+        const auto result = syscall(__NR_io_uring_enter, _ring, count, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (result < 0 && errno != EINTR)
+        {
+            std::stringstream t;
+            t << "IoUringFileReader::submit() " << std::strerror(errno);
+            throw std::runtime_error(t.str());
+        }
+        if (result == 0 && count > 0)
+        {
+            throw std::runtime_error("IoUringFileReader::submit() submission queue is stuck");
+        }
+        if (result > 0)
+        {
+            count -= static_cast<unsigned int>(result);
+        }
+    }
+    while (count > 0);
+}
+
+#endif
+
+}
+
+void BlockingFileReader::read(const std::vector<Request>& requests)
+{
+    TaskGroup tasks(_workers);
+    for (const auto& request : requests)
+    {
+        tasks.post([&request]() {
+            read_file(request);
+            if (request.on_complete)
+            {
+                request.on_complete();
+            }
+        });
+    }
+    tasks.wait();
+}
+
+std::unique_ptr<AsyncFileReaderInterface> angry::make_async_file_reader()
+{
+#if defined(__linux__)
+    try
+    {
+        return std::make_unique<IoUringFileReader>(64);
+    }
+    catch (const std::runtime_error&)
+    {
+        // seccomp or old kernel, fall back to blocking reads
+    }
+#endif
+    return std::make_unique<BlockingFileReader>();
+}
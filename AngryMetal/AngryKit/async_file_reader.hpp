@@ -0,0 +1,54 @@
+//
+//  async_file_reader.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "worker_pool.hpp"
+
+namespace angry
+{
+
+struct AsyncFileReaderInterface
+{
+    struct Request
+    {
+        int file = -1;
+        uint64_t offset = 0;
+        uint8_t* target = nullptr;
+        size_t size = 0;
+
+        // called on a worker of the reader as soon as `target` is filled, decoding continues here
+        std::function<void()> on_complete;
+    };
+
+    virtual ~AsyncFileReaderInterface() = default;
+
+    // Reads the whole batch and returns after every `on_complete` has finished,
+    // the first failure is rethrown.
+    virtual void read(const std::vector<Request>& requests) = 0;
+};
+
+// Blocking positioned reads on a worker pool, available everywhere.
+class BlockingFileReader final : public AsyncFileReaderInterface
+{
+public:
+    void read(const std::vector<Request>& requests) override;
+
+private:
+    WorkerPool _workers;
+};
+
+// io_uring on Linux if the kernel allows it, BlockingFileReader otherwise.
+std::unique_ptr<AsyncFileReaderInterface> make_async_file_reader();
+
+}
@@ -12,35 +12,84 @@
 #include <vector>
 
 #include "buffer_manager_interface.hpp"
+#include "deferred_release_queue.hpp"
+#include "frame_ring.hpp"
 #include "objc_ref.h"
+#include "slab_allocator.hpp"
+#include "slot_map.hpp"
 
 namespace angry
 {
 
+// Buffers are ranges of shared slabs, draws of meshes in one slab only move the offset.
+// Dynamic buffers live in a ring with a region per frame in flight.
 class BufferManager final : public BufferManagerInterface
 {
 public:
-    explicit BufferManager(id<MTLDevice> device);
+    explicit BufferManager(id<MTLDevice> device,
+                           const SlabAllocator::Settings& settings = SlabAllocator::Settings(),
+                           const FrameRing::Settings& frame_settings = FrameRing::Settings());
+    ~BufferManager() override;
 
     BufferManager(const BufferManager&) = delete;
     BufferManager(BufferManager&&) = delete;
     BufferManager& operator=(const BufferManager&) = delete;
     BufferManager& operator=(BufferManager&&) = delete;
 
-    size_t create_buffer(size_t size) override;
-    size_t create_buffer(const uint8_t* data, size_t size) override;
+    size_t create_buffer(size_t size, BufferUsage usage) override;
+    size_t create_buffer(const uint8_t* data, size_t size, BufferUsage usage) override;
+    size_t create_dynamic_buffer(size_t size, BufferUsage usage) override;
+    void release_buffer(size_t index) override;
 
+    void begin_frame() override;
+    // call before commit for every frame which was begun, the ring region of the frame is
+    // reused after the command buffer completes
+    void end_frame(id<MTLCommandBuffer> command_buffer);
+
+    // slab of the buffer, it starts at `get_buffer_offset`
     id<MTLBuffer> get_buffer(size_t index);
+    size_t get_buffer_offset(size_t index);
+    const SlabAllocator::Statistics& get_statistics() const;
+    const FrameRing& get_frame_ring() const;
 
 private:
     void* get_buffer_data(size_t size) override;
     size_t get_buffer_size(size_t index) override;
 
+    struct Buffer
+    {
+        SlabAllocator::Allocation allocation;
+        size_t size = 0;
+        // lives in the ring, the offset changes every frame
+        bool is_dynamic = false;
+        MemoryCategory category = MemoryCategory::vertex_buffers;
+        // what the category was charged
+        size_t tracked_bytes = 0;
+    };
+
+    size_t add_buffer(size_t size, BufferUsage usage);
+    size_t allocate_frame_memory(size_t size);
+    // gives the range back to the slab allocator
+    void free_buffer(const Buffer& buffer);
+    // memory of slabs and the ring no buffer is charged for, sampled after they change
+    void report_memory();
+
 private:
     id<MTLDevice> _device;
+    SlabAllocator _allocator;
 
     using BufferRef = objc::Ref<id<MTLBuffer>>;
-    std::vector<BufferRef> _buffers;
+    std::vector<BufferRef> _slabs;
+    SlotMap<Buffer> _buffers;
+    DeferredReleaseQueue<Buffer> _releases;
+
+    FrameRing _frame_ring;
+    BufferRef _ring;
+    std::vector<size_t> _dynamic_buffers;
+    size_t _dynamic_bytes = 0;
+    // what Metal allocated for the slabs, with page rounding
+    size_t _slab_bytes = 0;
+    dispatch_semaphore_t _frame_semaphore;
 };
 
 }
@@ -7,53 +7,256 @@
 
 #include "buffer_manager.h"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
+#include "aligned_allocator.hpp"
+
 using namespace angry;
 
-BufferManager::BufferManager(id<MTLDevice> device) : _device(device)
+BufferManager::BufferManager(id<MTLDevice> device,
+                             const SlabAllocator::Settings& settings,
+                             const FrameRing::Settings& frame_settings)
+    : _device(device), _allocator(settings), _frame_ring(frame_settings)
 {
+    _ring = [_device newBufferWithLength:_frame_ring.get_size() options:MTLStorageModeShared];
+    if (!_ring)
+    {
+        throw std::runtime_error("BufferManager::BufferManager() frame ring");
+    }
+
+    _frame_semaphore = dispatch_semaphore_create(long(_frame_ring.get_frame_count()));
+    report_memory();
 }
 
-size_t BufferManager::create_buffer(size_t size)
+BufferManager::~BufferManager()
 {
-    BufferRef buffer([_device newBufferWithLength:size options:MTLStorageModeShared]);
-    if (!buffer)
+    // libdispatch does not allow to free a semaphore below its initial value
+    const size_t frame_count = _frame_ring.get_frame_count();
+    for (size_t i = 0; i < frame_count; i++)
+    {
+        dispatch_semaphore_wait(_frame_semaphore, DISPATCH_TIME_FOREVER);
+    }
+    for (size_t i = 0; i < frame_count; i++)
     {
-        throw std::runtime_error("BufferManager::create_buffer");
+        dispatch_semaphore_signal(_frame_semaphore);
     }
+    dispatch_release(_frame_semaphore);
+}
 
-    size_t index = _buffers.size();
-    _buffers.push_back(buffer);
+size_t BufferManager::create_buffer(size_t size, BufferUsage usage)
+{
+    const size_t index = add_buffer(size, usage);
+    // a block of a released buffer keeps its content
+    std::memset(get_buffer_data(index), 0, size);
 
     return index;
 }
 
-size_t BufferManager::create_buffer(const uint8_t* data, size_t size)
+size_t BufferManager::create_buffer(const uint8_t* data, size_t size, BufferUsage usage)
 {
-    BufferRef buffer([_device newBufferWithBytes:data length:size options:MTLStorageModeShared]);
-    if (!buffer)
+    const size_t index = add_buffer(size, usage);
+    if (size > 0)
     {
-        throw std::runtime_error("BufferManager::create_buffer");
+        std::memcpy(get_buffer_data(index), data, size);
     }
 
-    size_t index = _buffers.size();
-    _buffers.push_back(buffer);
+    return index;
+}
 
+size_t BufferManager::create_dynamic_buffer(size_t size, BufferUsage usage)
+{
+    Buffer buffer;
+    buffer.allocation.offset = allocate_frame_memory(size);
+    buffer.size = size;
+    buffer.is_dynamic = true;
+    buffer.category = get_memory_category(usage, true);
+    buffer.tracked_bytes = align_size(size, gpu_memory_alignment) * _frame_ring.get_frame_count();
+    track_memory(buffer.category, buffer.tracked_bytes);
+    _dynamic_bytes += buffer.tracked_bytes;
+
+    const size_t index = _buffers.insert(buffer);
+    _dynamic_buffers.push_back(index);
+    report_memory();
     return index;
 }
 
+void BufferManager::release_buffer(size_t index)
+{
+    const Buffer buffer = _buffers.erase(index);
+    if (buffer.is_dynamic)
+    {
+        // ring memory is free with the next frame in this region
+        _dynamic_buffers.erase(std::find(_dynamic_buffers.begin(), _dynamic_buffers.end(), index));
+        untrack_memory(buffer.category, buffer.tracked_bytes);
+        _dynamic_bytes -= buffer.tracked_bytes;
+        report_memory();
+        return;
+    }
+
+    // command buffers retain slabs but not the range of one buffer, another buffer must not
+    // get it while a frame in flight may draw from it
+    const uint64_t frame = _frame_ring.get_statistics().frame_count;
+    if (frame == 0)
+    {
+        free_buffer(buffer);
+        return;
+    }
+    _releases.push(buffer, frame);
+}
+
+void BufferManager::begin_frame()
+{
+    // the CPU records this frame while the GPU works on the frames before
+    dispatch_semaphore_wait(_frame_semaphore, DISPATCH_TIME_FOREVER);
+
+    // frames before the oldest one in flight are done
+    _frame_ring.begin_frame();
+    const uint64_t frame = _frame_ring.get_statistics().frame_count;
+    if (frame >= _frame_ring.get_frame_count())
+    {
+        _releases.retire(frame - _frame_ring.get_frame_count(), [this](const Buffer& buffer) {
+            free_buffer(buffer);
+        });
+    }
+
+    for (size_t index : _dynamic_buffers)
+    {
+        auto& buffer = _buffers.get(index);
+        buffer.allocation.offset = allocate_frame_memory(buffer.size);
+    }
+}
+
+void BufferManager::end_frame(id<MTLCommandBuffer> command_buffer)
+{
+    dispatch_semaphore_t semaphore = _frame_semaphore;
+    [command_buffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+        dispatch_semaphore_signal(semaphore);
+    }];
+}
+
 id<MTLBuffer> BufferManager::get_buffer(size_t index)
 {
-    return _buffers[index].get();
+    const auto& buffer = _buffers.get(index);
+    if (buffer.is_dynamic)
+    {
+        return _ring.get();
+    }
+    return _slabs[buffer.allocation.slab].get();
+}
+
+size_t BufferManager::get_buffer_offset(size_t index)
+{
+    return _buffers.get(index).allocation.offset;
+}
+
+const SlabAllocator::Statistics& BufferManager::get_statistics() const
+{
+    return _allocator.get_statistics();
+}
+
+const FrameRing& BufferManager::get_frame_ring() const
+{
+    return _frame_ring;
 }
 
 void* BufferManager::get_buffer_data(size_t index)
 {
-    return _buffers[index].get().contents;
+    const auto& buffer = _buffers.get(index);
+    id<MTLBuffer> memory = buffer.is_dynamic ? _ring.get() : _slabs[buffer.allocation.slab].get();
+    return static_cast<uint8_t*>(memory.contents) + buffer.allocation.offset;
 }
 
 size_t BufferManager::get_buffer_size(size_t index)
 {
-    return _buffers[index].get().length;
+    return _buffers.get(index).size;
+}
+
+size_t BufferManager::add_buffer(size_t size, BufferUsage usage)
+{
+    bool is_new_slab = false;
+    const auto allocation = _allocator.allocate(size, is_new_slab);
+    if (is_new_slab)
+    {
+        BufferRef slab([_device newBufferWithLength:_allocator.get_slab_size(allocation.slab)
+                                            options:MTLStorageModeShared]);
+        if (!slab)
+        {
+            throw std::runtime_error("BufferManager::create_buffer");
+        }
+
+        _slab_bytes += slab.get().allocatedSize;
+        if (allocation.slab == _slabs.size())
+        {
+            _slabs.push_back(slab);
+        }
+        else
+        {
+            _slabs[allocation.slab] = slab;
+        }
+    }
+
+    Buffer buffer;
+    buffer.allocation = allocation;
+    buffer.size = size;
+    buffer.category = get_memory_category(usage, false);
+    buffer.tracked_bytes = allocation.capacity;
+    track_memory(buffer.category, buffer.tracked_bytes);
+    const size_t index = _buffers.insert(buffer);
+    report_memory();
+    return index;
+}
+
+size_t BufferManager::allocate_frame_memory(size_t size)
+{
+    if (auto offset = _frame_ring.allocate(size))
+    {
+        return *offset;
+    }
+
+    // command buffers retain the old ring for frames in flight, only what was written in this
+    // frame moves along
+    const size_t frame_offset = _frame_ring.get_frame_offset();
+    _frame_ring.grow(size);
+
+    BufferRef ring([_device newBufferWithLength:_frame_ring.get_size() options:MTLStorageModeShared]);
+    if (!ring)
+    {
+        throw std::runtime_error("BufferManager::allocate_frame_memory() frame ring");
+    }
+    std::memcpy(static_cast<uint8_t*>(ring.get().contents) + _frame_ring.get_frame_offset(),
+                static_cast<uint8_t*>(_ring.get().contents) + frame_offset,
+                _frame_ring.get_frame_used());
+    _ring = ring;
+
+    const size_t shift = _frame_ring.get_frame_offset() - frame_offset;
+    for (size_t index : _dynamic_buffers)
+    {
+        _buffers.get(index).allocation.offset += shift;
+    }
+    report_memory();
+
+    return *_frame_ring.allocate(size);
+}
+
+void BufferManager::free_buffer(const Buffer& buffer)
+{
+    untrack_memory(buffer.category, buffer.tracked_bytes);
+
+    const auto& allocation = buffer.allocation;
+    if (_allocator.release(allocation))
+    {
+        _slab_bytes -= _slabs[allocation.slab].get().allocatedSize;
+        _slabs[allocation.slab] = nil;
+    }
+    report_memory();
+}
+
+void BufferManager::report_memory()
+{
+    const size_t allocated_bytes = _allocator.get_statistics().allocated_bytes;
+    set_tracked_memory(MemoryCategory::slab_free, _slab_bytes - std::min(_slab_bytes, allocated_bytes));
+    const size_t ring_bytes = _ring.get().allocatedSize;
+    set_tracked_memory(MemoryCategory::frame_ring_free, ring_bytes - std::min(ring_bytes, _dynamic_bytes));
 }
@@ -10,9 +10,34 @@
 #include <cstdint>
 #include <memory>
 
+#include "memory_tracker.hpp"
+
 namespace angry
 {
 
+// what the buffer holds, only memory accounting looks at it
+enum class BufferUsage
+{
+    vertex,
+    index,
+    instance
+};
+
+inline MemoryCategory get_memory_category(BufferUsage usage, bool is_dynamic)
+{
+    switch (usage)
+    {
+        case BufferUsage::instance:
+            return MemoryCategory::instance_buffers;
+        case BufferUsage::index:
+            return is_dynamic ? MemoryCategory::dynamic_buffers : MemoryCategory::index_buffers;
+        case BufferUsage::vertex:
+            break;
+    }
+    return is_dynamic ? MemoryCategory::dynamic_buffers : MemoryCategory::vertex_buffers;
+}
+
+// Buffers are named by generation checked handles, see slot_map.hpp.
 struct BufferManagerInterface
 {
     template<class T>
@@ -24,8 +49,20 @@ struct BufferManagerInterface
 
     virtual ~BufferManagerInterface() = default;
 
-    virtual size_t create_buffer(size_t size) = 0;
-    virtual size_t create_buffer(const uint8_t* data, size_t size) = 0;
+    virtual size_t create_buffer(size_t size, BufferUsage usage) = 0;
+    virtual size_t create_buffer(const uint8_t* data, size_t size, BufferUsage usage) = 0;
+
+    // Dynamic buffers are rewritten every frame, each frame in flight gets its own copy from
+    // the frame ring. Content is undefined after `begin_frame`.
+    virtual size_t create_dynamic_buffer(size_t size, BufferUsage usage) = 0;
+
+    // the handle stops resolving at once, memory goes back to its slab when frames in flight
+    // which could draw the buffer are done
+    virtual void release_buffer(size_t index) = 0;
+
+    // Waits until the GPU is done with the oldest frame in flight and moves dynamic buffers to
+    // its ring region. Backends have their own `end_frame` to hand the frame to the GPU.
+    virtual void begin_frame() = 0;
 
     template<class T>
     View<T> get_buffer_view(size_t index)
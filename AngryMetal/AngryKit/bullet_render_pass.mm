@@ -16,16 +16,15 @@ BulletRenderPass::BulletRenderPass(id<MTLDevice> device, id<MTLLibrary> library)
     : RenderPass(RenderPassType::bullet)
 {
     _attributes = {
-        render::AttributeType::projection_view_matrix
+        render::AttributeType::projection_view_matrix,
+        render::AttributeType::uv_transform
     };
 
     _textures = {
         MaterialTexture::diffuse
     };
 
-    _instance_buffer_attributes = {
-        {InstanceBufferType::transform, 3}
-    };
+    _instance_buffer_attributes[InstanceBufferType::transform] = 3;
 
     setup_state(device, library);
 }
@@ -36,6 +35,10 @@ void BulletRenderPass::set_attribute(const render::AttributeVariant& attribute)
     {
         _vertex_uniforms.pv = a->value;
     }
+    else if (const auto& a = std::get_if<render::UVTransformAttribute>(&attribute))
+    {
+        _vertex_uniforms.uv_transform = a->value;
+    }
 }
 
 void BulletRenderPass::encode(id<MTLRenderCommandEncoder> command_encoder)
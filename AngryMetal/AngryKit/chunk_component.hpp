@@ -0,0 +1,30 @@
+//
+//  chunk_component.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <simd/simd.h>
+
+#include <vector>
+
+#include "math.hpp"
+
+namespace angry
+{
+
+struct ChunkComponent
+{
+    static constexpr size_t vertex_count = 6;
+    // the floor grid is turned around the world origin like the original floor
+    static constexpr float rotation = 45.0f * math::radians;
+
+    simd_int2 coordinates;
+    bool is_resident = false;
+    std::vector<simd_float3> spawn_points;
+};
+
+}
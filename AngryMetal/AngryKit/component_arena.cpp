@@ -0,0 +1,64 @@
+//
+//  component_arena.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "component_arena.hpp"
+
+#include <new>
+#include <stdexcept>
+
+using namespace angry;
+
+ComponentArena::ComponentArena(const Settings& settings)
+{
+    if (settings.capacity == 0)
+    {
+        throw std::runtime_error("ComponentArena::ComponentArena() empty arena");
+    }
+
+    // value initialized on purpose, every page is faulted in here and not on first use
+    _data.reset(new uint8_t[settings.capacity]());
+    _statistics.capacity = settings.capacity;
+}
+
+void* ComponentArena::allocate(size_t size, size_t alignment)
+{
+    const auto address = reinterpret_cast<uintptr_t>(_data.get() + _statistics.used);
+    const size_t padding = (alignment - address % alignment) % alignment;
+    if (_statistics.used + padding + size > _statistics.capacity)
+    {
+        _statistics.heap_count += 1;
+        _statistics.heap_bytes += size;
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    void* result = _data.get() + _statistics.used + padding;
+    _statistics.used += padding + size;
+    return result;
+}
+
+void ComponentArena::deallocate(void* p, size_t size, size_t alignment)
+{
+    if (p == nullptr || contains(p))
+    {
+        return;
+    }
+
+    _statistics.heap_count -= 1;
+    _statistics.heap_bytes -= size;
+    ::operator delete(p, std::align_val_t(alignment));
+}
+
+bool ComponentArena::contains(const void* p) const
+{
+    const auto* data = static_cast<const uint8_t*>(p);
+    return data >= _data.get() && data < _data.get() + _statistics.capacity;
+}
+
+const ComponentArena::Statistics& ComponentArena::get_statistics() const
+{
+    return _statistics;
+}
@@ -0,0 +1,117 @@
+//
+//  component_arena.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace angry
+{
+
+// Memory for registry storages, taken and touched once when the scene is created so
+// storages don't move and don't fault pages in mid-game. Allocations are bumped in order,
+// storages reserved one after another end up next to each other. Freed memory stays in the
+// arena until it is gone, requests which don't fit go to the heap. Not thread safe.
+class ComponentArena final
+{
+public:
+    struct Settings
+    {
+        size_t capacity = 4 * 1024 * 1024;
+    };
+
+    struct Statistics
+    {
+        size_t capacity = 0;
+        size_t used = 0;
+        // live allocations which didn't fit
+        size_t heap_count = 0;
+        size_t heap_bytes = 0;
+    };
+
+public:
+    explicit ComponentArena(const Settings& settings);
+
+    ComponentArena(const ComponentArena&) = delete;
+    ComponentArena(ComponentArena&&) = delete;
+    ComponentArena& operator=(const ComponentArena&) = delete;
+    ComponentArena& operator=(ComponentArena&&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* p, size_t size, size_t alignment);
+
+    bool contains(const void* p) const;
+    const Statistics& get_statistics() const;
+
+private:
+    std::unique_ptr<uint8_t[]> _data;
+    Statistics _statistics;
+};
+
+// Registry allocator, EnTT rebinds it for every storage. A default constructed one has no
+// arena and goes to the heap.
+template<typename T>
+class ComponentAllocator
+{
+public:
+    using value_type = T;
+
+    ComponentAllocator() = default;
+
+    explicit ComponentAllocator(ComponentArena& arena) : _arena(&arena)
+    {
+    }
+
+    template<typename U>
+    ComponentAllocator(const ComponentAllocator<U>& other) : _arena(other.get_arena())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        if (_arena == nullptr)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t count)
+    {
+        if (_arena == nullptr)
+        {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+            return;
+        }
+        _arena->deallocate(p, count * sizeof(T), alignof(T));
+    }
+
+    ComponentArena* get_arena() const
+    {
+        return _arena;
+    }
+
+private:
+    ComponentArena* _arena = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const ComponentAllocator<T>& a, const ComponentAllocator<U>& b)
+{
+    return a.get_arena() == b.get_arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ComponentAllocator<T>& a, const ComponentAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+}
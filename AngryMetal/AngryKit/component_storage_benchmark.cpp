@@ -0,0 +1,227 @@
+//
+//  component_storage_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "component_storage_benchmark.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "collider_component.hpp"
+#include "instanced_mesh_component.hpp"
+#include "movement_component.hpp"
+#include "time_component.hpp"
+#include "transform_component.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+constexpr uint32_t no_index = std::numeric_limits<uint32_t>::max();
+
+struct PageFaults
+{
+    size_t minor = 0;
+    size_t major = 0;
+};
+
+PageFaults get_page_faults()
+{
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return PageFaults{size_t(usage.ru_minflt), size_t(usage.ru_majflt)};
+}
+
+// entt::basic_storage without pages: entity to packed index, packed entities, packed components
+template<typename T>
+class Storage
+{
+public:
+    explicit Storage(const ComponentAllocator<T>& allocator)
+        : _sparse(allocator), _entities(allocator), _components(allocator)
+    {
+    }
+
+    void reserve(size_t capacity)
+    {
+        _sparse.reserve(capacity);
+        _entities.reserve(capacity);
+        _components.reserve(capacity);
+    }
+
+    void emplace(uint32_t entity, const T& component)
+    {
+        if (entity >= _sparse.size())
+        {
+            _sparse.resize(entity + 1, no_index);
+        }
+        _sparse[entity] = uint32_t(_entities.size());
+        _entities.push_back(entity);
+        _components.push_back(component);
+    }
+
+    // swap and pop like EnTT
+    void remove(uint32_t entity)
+    {
+        const uint32_t index = _sparse[entity];
+        const uint32_t last = _entities.back();
+        _entities[index] = last;
+        _components[index] = _components.back();
+        _sparse[last] = index;
+        _sparse[entity] = no_index;
+        _entities.pop_back();
+        _components.pop_back();
+    }
+
+    T& get(uint32_t entity)
+    {
+        return _components[_sparse[entity]];
+    }
+
+    const std::vector<uint32_t, ComponentAllocator<uint32_t>>& get_entities() const
+    {
+        return _entities;
+    }
+
+private:
+    std::vector<uint32_t, ComponentAllocator<uint32_t>> _sparse;
+    std::vector<uint32_t, ComponentAllocator<uint32_t>> _entities;
+    std::vector<T, ComponentAllocator<T>> _components;
+};
+
+// Scene::reserve_storages() order, the arena places them one after another
+struct Storages
+{
+    explicit Storages(const ComponentAllocator<uint8_t>& allocator)
+        : transforms(allocator), movements(allocator), colliders(allocator), instanced_meshes(allocator),
+        times(allocator)
+    {
+    }
+
+    void reserve(size_t capacity)
+    {
+        transforms.reserve(capacity);
+        movements.reserve(capacity);
+        colliders.reserve(capacity);
+        instanced_meshes.reserve(capacity);
+        times.reserve(capacity);
+    }
+
+    Storage<TransformComponent> transforms;
+    Storage<MovementComponent> movements;
+    Storage<ColliderComponent> colliders;
+    Storage<InstancedMeshComponent> instanced_meshes;
+    Storage<TimeComponent> times;
+};
+
+void run(const ComponentStorageBenchmarkSettings& settings, bool is_arena, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto load_faults = get_page_faults();
+    std::unique_ptr<ComponentArena> arena;
+    ComponentAllocator<uint8_t> allocator;
+    if (is_arena)
+    {
+        arena = std::make_unique<ComponentArena>(settings.arena);
+        allocator = ComponentAllocator<uint8_t>(*arena);
+    }
+
+    Storages storages(allocator);
+    if (is_arena)
+    {
+        storages.reserve(settings.entity_count);
+    }
+
+    // the pools instantiate their prefabs at load, one entity after another
+    for (uint32_t entity = 0; entity < settings.entity_count; entity++)
+    {
+        TransformComponent transform_component;
+        transform_component.position = {float(entity), 0.0f, 0.0f};
+        transform_component.scale = {1.0f, 1.0f, 1.0f};
+        transform_component.euler_angles = {0.0f, 0.0f, 0.0f};
+        storages.transforms.emplace(entity, transform_component);
+
+        MovementComponent movement_component;
+        movement_component.speed = 1.5f;
+        movement_component.direction = {1.0f, 0.0f};
+        storages.movements.emplace(entity, movement_component);
+
+        storages.colliders.emplace(entity, ColliderComponent{});
+        storages.instanced_meshes.emplace(entity, InstancedMeshComponent{});
+        storages.times.emplace(entity, TimeComponent{});
+    }
+    const auto run_faults = get_page_faults();
+
+    double update_seconds = 0.0;
+    float checksum = 0.0f;
+    for (size_t frame = 0; frame < settings.frame_count; frame++)
+    {
+        const auto update_start = Clock::now();
+
+        // a view of the group is driven by the entities of its first storage
+        for (uint32_t entity : storages.transforms.get_entities())
+        {
+            auto& transform_component = storages.transforms.get(entity);
+            const auto& movement_component = storages.movements.get(entity);
+            const float step = movement_component.speed * settings.delta_time;
+            transform_component.position.x += movement_component.direction.x * step;
+            transform_component.position.z += movement_component.direction.y * step;
+            storages.times.get(entity).time += settings.delta_time;
+        }
+
+        for (size_t i = 0; i < std::min(settings.churn_count, settings.entity_count); i++)
+        {
+            const auto entity = uint32_t((frame * settings.churn_count + i) % settings.entity_count);
+            storages.times.remove(entity);
+            storages.times.emplace(entity, TimeComponent{});
+        }
+
+        update_seconds += std::chrono::duration<double>(Clock::now() - update_start).count();
+    }
+    const auto end_faults = get_page_faults();
+
+    for (uint32_t entity : storages.transforms.get_entities())
+    {
+        checksum += storages.transforms.get(entity).position.x;
+    }
+
+    output << "{\"allocator\": \"" << (is_arena ? "arena" : "heap") << "\""
+        << ", \"load_minor_faults\": " << run_faults.minor - load_faults.minor
+        << ", \"load_major_faults\": " << run_faults.major - load_faults.major
+        << ", \"run_minor_faults\": " << end_faults.minor - run_faults.minor
+        << ", \"run_major_faults\": " << end_faults.major - run_faults.major
+        << ", \"update_us_mean\": " << update_seconds * 1e6 / double(std::max(settings.frame_count, size_t(1)));
+    if (arena)
+    {
+        const auto& statistics = arena->get_statistics();
+        output << ", \"arena_used\": " << statistics.used
+            << ", \"heap_allocations\": " << statistics.heap_count;
+    }
+    // keeps the update from being optimized out
+    output << ", \"checksum\": " << checksum << "}";
+}
+
+}
+
+void angry::run_component_storage_benchmark(const ComponentStorageBenchmarkSettings& settings, std::ostream& output)
+{
+    output << "{\"entities\": " << settings.entity_count
+        << ", \"frame_count\": " << settings.frame_count
+        << ", \"arena_capacity\": " << settings.arena.capacity
+        << ", \"runs\": [";
+    run(settings, false, output);
+    output << ", ";
+    run(settings, true, output);
+    output << "]}\n";
+}
@@ -0,0 +1,37 @@
+//
+//  component_storage_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include "component_arena.hpp"
+
+namespace angry
+{
+
+struct ComponentStorageBenchmarkSettings
+{
+    // what the scene pools hold: enemies, bullets, floor chunks, the camera, the player and the gun
+    size_t entity_count = 16 + 16 + 44 + 3;
+    size_t frame_count = 600;
+    float delta_time = 1.0f / 60.0f;
+    // entities which get their time component again every frame, like restarted bullets
+    size_t churn_count = 4;
+    ComponentArena::Settings arena;
+};
+
+// Builds the storages of the transform, movement, collider, instanced mesh and time group the
+// way the EnTT registry lays them out, a sparse array with packed entities and components per
+// type, once on the heap and grown as entities are added like before the component arena, and
+// once reserved in an arena. Then runs the movement update over the group. Writes page faults
+// of load and run and update time for both as JSON. Cache misses are not readable from user
+// space on iOS, they come from an Instruments capture of the game.
+void run_component_storage_benchmark(const ComponentStorageBenchmarkSettings& settings, std::ostream& output);
+
+}
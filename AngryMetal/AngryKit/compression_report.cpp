@@ -0,0 +1,85 @@
+//
+//  compression_report.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "compression_report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "image.hpp"
+#include "mipmap.hpp"
+#include "texture_cooker.hpp"
+
+using namespace angry;
+
+void angry::run_compression_report(const CompressionReportSettings& settings, std::ostream& output)
+{
+    std::vector<std::filesystem::path> file_paths;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(settings.assets_path))
+    {
+        if (entry.is_regular_file() && is_texture_source(entry.path()))
+        {
+            file_paths.push_back(entry.path());
+        }
+    }
+    std::sort(file_paths.begin(), file_paths.end());
+
+    output << "{\"preset\": \"" << (settings.preset == CompressionPreset::fast ? "fast" : "quality")
+        << "\", \"textures\": [";
+    for (size_t i = 0; i < file_paths.size(); i++)
+    {
+        Image image(file_paths[i]);
+        image.convert_to_bgra();
+
+        const auto content = get_mipmap_content(file_paths[i]);
+        const size_t input_bytes = size_t(image.width) * size_t(image.height) * size_t(image.components);
+        const auto name = file_paths[i].lexically_relative(settings.assets_path).generic_string();
+
+        const CompressedFormat formats[] = {CompressedFormat::astc_4x4, get_desktop_format(image, content)};
+        for (size_t k = 0; k < 2; k++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto blocks = compress(
+                image.data,
+                image.width,
+                image.height,
+                image.components,
+                formats[k],
+                settings.preset,
+                settings.thread_count
+            );
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const auto decoded = decompress(blocks.data(), image.width, image.height, formats[k]);
+            const double psnr = get_psnr(image.data, image.components, decoded.data(), image.width, image.height, formats[k]);
+
+            output << (i == 0 && k == 0 ? "" : ", ")
+                << "{\"path\": \"" << name
+                << "\", \"width\": " << image.width
+                << ", \"height\": " << image.height
+                << ", \"format\": \"" << get_format_name(formats[k])
+                << "\", \"input_bytes\": " << input_bytes
+                << ", \"output_bytes\": " << blocks.size()
+                << ", \"seconds\": " << seconds
+                << ", \"psnr\": ";
+            // lossless result has infinite PSNR which JSON cannot hold
+            if (std::isinf(psnr))
+            {
+                output << "null";
+            }
+            else
+            {
+                output << psnr;
+            }
+            output << "}";
+        }
+    }
+    output << "]}\n";
+}
@@ -0,0 +1,31 @@
+//
+//  compression_report.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+
+#include "texture_compression.hpp"
+
+namespace angry
+{
+
+struct CompressionReportSettings
+{
+    std::filesystem::path assets_path;
+    CompressionPreset preset = CompressionPreset::fast;
+    // 0 means hardware concurrency
+    size_t thread_count = 0;
+};
+
+// Compresses every loose texture of the assets directory to ASTC and to the BC format
+// a desktop build would use, writes sizes, encode time and PSNR as JSON.
+void run_compression_report(const CompressionReportSettings& settings, std::ostream& output);
+
+}
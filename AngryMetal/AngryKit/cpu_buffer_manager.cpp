@@ -0,0 +1,232 @@
+//
+//  cpu_buffer_manager.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "cpu_buffer_manager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace angry;
+
+CpuBufferManager::CpuBufferManager(const SlabAllocator::Settings& settings, const FrameRing::Settings& frame_settings)
+    : _allocator(settings),
+    _frame_ring(frame_settings),
+    _ring(_frame_ring.get_size()),
+    _free_frame_count(_frame_ring.get_frame_count())
+{
+    report_memory();
+}
+
+size_t CpuBufferManager::create_buffer(size_t size, BufferUsage usage)
+{
+    const size_t index = add_buffer(size, usage);
+    // a block of a released buffer keeps its content
+    std::memset(get_buffer_data(index), 0, size);
+
+    return index;
+}
+
+size_t CpuBufferManager::create_buffer(const uint8_t* data, size_t size, BufferUsage usage)
+{
+    const size_t index = add_buffer(size, usage);
+    if (size > 0)
+    {
+        std::memcpy(get_buffer_data(index), data, size);
+    }
+
+    return index;
+}
+
+size_t CpuBufferManager::create_dynamic_buffer(size_t size, BufferUsage usage)
+{
+    Buffer buffer;
+    buffer.allocation.offset = allocate_frame_memory(size);
+    buffer.size = size;
+    buffer.is_dynamic = true;
+    buffer.category = get_memory_category(usage, true);
+    buffer.tracked_bytes = align_size(size, gpu_memory_alignment) * _frame_ring.get_frame_count();
+    track_memory(buffer.category, buffer.tracked_bytes);
+    _dynamic_bytes += buffer.tracked_bytes;
+
+    const size_t index = _buffers.insert(buffer);
+    _dynamic_buffers.push_back(index);
+    report_memory();
+    return index;
+}
+
+void CpuBufferManager::release_buffer(size_t index)
+{
+    const Buffer buffer = _buffers.erase(index);
+    if (buffer.is_dynamic)
+    {
+        // ring memory is free with the next frame in this region
+        _dynamic_buffers.erase(std::find(_dynamic_buffers.begin(), _dynamic_buffers.end(), index));
+        untrack_memory(buffer.category, buffer.tracked_bytes);
+        _dynamic_bytes -= buffer.tracked_bytes;
+        report_memory();
+        return;
+    }
+
+    // the range stays taken while frames in flight may read it, nothing was drawn before the
+    // first frame
+    const uint64_t frame = _frame_ring.get_statistics().frame_count;
+    if (frame == 0)
+    {
+        free_buffer(buffer);
+        return;
+    }
+    _releases.push(buffer, frame);
+}
+
+void CpuBufferManager::begin_frame()
+{
+    {
+        std::unique_lock<std::mutex> lock(_frame_mutex);
+        _frame_condition.wait(lock, [this]() { return _free_frame_count > 0; });
+        _free_frame_count -= 1;
+    }
+
+    // frames before the oldest one in flight are done
+    _frame_ring.begin_frame();
+    const uint64_t frame = _frame_ring.get_statistics().frame_count;
+    if (frame >= _frame_ring.get_frame_count())
+    {
+        _releases.retire(frame - _frame_ring.get_frame_count(), [this](const Buffer& buffer) {
+            free_buffer(buffer);
+        });
+    }
+
+    for (size_t index : _dynamic_buffers)
+    {
+        auto& buffer = _buffers.get(index);
+        buffer.allocation.offset = allocate_frame_memory(buffer.size);
+    }
+}
+
+void CpuBufferManager::end_frame()
+{
+    std::lock_guard<std::mutex> lock(_frame_mutex);
+    _pending_frame_count += 1;
+}
+
+void CpuBufferManager::complete_frame()
+{
+    {
+        std::lock_guard<std::mutex> lock(_frame_mutex);
+        if (_pending_frame_count == 0)
+        {
+            throw std::runtime_error("CpuBufferManager::complete_frame() no frame in flight");
+        }
+        _pending_frame_count -= 1;
+        _free_frame_count += 1;
+    }
+    _frame_condition.notify_one();
+}
+
+size_t CpuBufferManager::get_buffer_slab(size_t index) const
+{
+    return _buffers.get(index).allocation.slab;
+}
+
+size_t CpuBufferManager::get_buffer_offset(size_t index) const
+{
+    return _buffers.get(index).allocation.offset;
+}
+
+const SlabAllocator::Statistics& CpuBufferManager::get_statistics() const
+{
+    return _allocator.get_statistics();
+}
+
+const FrameRing& CpuBufferManager::get_frame_ring() const
+{
+    return _frame_ring;
+}
+
+void* CpuBufferManager::get_buffer_data(size_t index)
+{
+    const auto& buffer = _buffers.get(index);
+    if (buffer.is_dynamic)
+    {
+        return _ring.data() + buffer.allocation.offset;
+    }
+    return _slabs[buffer.allocation.slab].data() + buffer.allocation.offset;
+}
+
+size_t CpuBufferManager::get_buffer_size(size_t index)
+{
+    return _buffers.get(index).size;
+}
+
+size_t CpuBufferManager::add_buffer(size_t size, BufferUsage usage)
+{
+    bool is_new_slab = false;
+    const auto allocation = _allocator.allocate(size, is_new_slab);
+    if (is_new_slab)
+    {
+        if (allocation.slab == _slabs.size())
+        {
+            _slabs.emplace_back();
+        }
+        _slabs[allocation.slab].resize(_allocator.get_slab_size(allocation.slab));
+    }
+
+    Buffer buffer;
+    buffer.allocation = allocation;
+    buffer.size = size;
+    buffer.category = get_memory_category(usage, false);
+    buffer.tracked_bytes = allocation.capacity;
+    track_memory(buffer.category, buffer.tracked_bytes);
+    const size_t index = _buffers.insert(buffer);
+    report_memory();
+    return index;
+}
+
+size_t CpuBufferManager::allocate_frame_memory(size_t size)
+{
+    if (auto offset = _frame_ring.allocate(size))
+    {
+        return *offset;
+    }
+
+    // only what was written in this frame moves along, nothing here reads older regions
+    const size_t frame_offset = _frame_ring.get_frame_offset();
+    _frame_ring.grow(size);
+
+    AlignedVector<uint8_t> ring(_frame_ring.get_size());
+    std::memcpy(ring.data() + _frame_ring.get_frame_offset(), _ring.data() + frame_offset, _frame_ring.get_frame_used());
+    _ring.swap(ring);
+
+    const size_t shift = _frame_ring.get_frame_offset() - frame_offset;
+    for (size_t index : _dynamic_buffers)
+    {
+        _buffers.get(index).allocation.offset += shift;
+    }
+    report_memory();
+
+    return *_frame_ring.allocate(size);
+}
+
+void CpuBufferManager::free_buffer(const Buffer& buffer)
+{
+    untrack_memory(buffer.category, buffer.tracked_bytes);
+
+    const auto& allocation = buffer.allocation;
+    if (_allocator.release(allocation))
+    {
+        AlignedVector<uint8_t>().swap(_slabs[allocation.slab]);
+    }
+    report_memory();
+}
+
+void CpuBufferManager::report_memory()
+{
+    const auto& statistics = _allocator.get_statistics();
+    set_tracked_memory(MemoryCategory::slab_free, statistics.slab_bytes - statistics.allocated_bytes);
+    set_tracked_memory(MemoryCategory::frame_ring_free, _frame_ring.get_size() - _dynamic_bytes);
+}
@@ -0,0 +1,92 @@
+//
+//  cpu_buffer_manager.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "buffer_manager_interface.hpp"
+#include "deferred_release_queue.hpp"
+#include "frame_ring.hpp"
+#include "slab_allocator.hpp"
+#include "slot_map.hpp"
+
+namespace angry
+{
+
+// Heap memory with the alignment of Metal buffers, for running scenes without a device.
+// Buffers are carved out of slabs the same way BufferManager does it.
+class CpuBufferManager final : public BufferManagerInterface
+{
+public:
+    explicit CpuBufferManager(const SlabAllocator::Settings& settings = SlabAllocator::Settings(),
+                              const FrameRing::Settings& frame_settings = FrameRing::Settings());
+
+    CpuBufferManager(const CpuBufferManager&) = delete;
+    CpuBufferManager(CpuBufferManager&&) = delete;
+    CpuBufferManager& operator=(const CpuBufferManager&) = delete;
+    CpuBufferManager& operator=(CpuBufferManager&&) = delete;
+
+    size_t create_buffer(size_t size, BufferUsage usage) override;
+    size_t create_buffer(const uint8_t* data, size_t size, BufferUsage usage) override;
+    size_t create_dynamic_buffer(size_t size, BufferUsage usage) override;
+    void release_buffer(size_t index) override;
+
+    void begin_frame() override;
+    // frame is recorded, `complete_frame` stands in for the completion handler of the GPU and
+    // may be called from any thread, once for every ended frame in order
+    void end_frame();
+    void complete_frame();
+
+    size_t get_buffer_slab(size_t index) const;
+    size_t get_buffer_offset(size_t index) const;
+    const SlabAllocator::Statistics& get_statistics() const;
+    const FrameRing& get_frame_ring() const;
+
+private:
+    void* get_buffer_data(size_t index) override;
+    size_t get_buffer_size(size_t index) override;
+
+    struct Buffer
+    {
+        SlabAllocator::Allocation allocation;
+        size_t size = 0;
+        // lives in the ring, the offset changes every frame
+        bool is_dynamic = false;
+        MemoryCategory category = MemoryCategory::vertex_buffers;
+        // what the category was charged
+        size_t tracked_bytes = 0;
+    };
+
+    size_t add_buffer(size_t size, BufferUsage usage);
+    size_t allocate_frame_memory(size_t size);
+    // gives the range back to the slab allocator
+    void free_buffer(const Buffer& buffer);
+    // memory of slabs and the ring no buffer is charged for, sampled after they change
+    void report_memory();
+
+private:
+    SlabAllocator _allocator;
+    std::vector<AlignedVector<uint8_t>> _slabs;
+    SlotMap<Buffer> _buffers;
+    DeferredReleaseQueue<Buffer> _releases;
+
+    FrameRing _frame_ring;
+    AlignedVector<uint8_t> _ring;
+    std::vector<size_t> _dynamic_buffers;
+    size_t _dynamic_bytes = 0;
+
+    std::mutex _frame_mutex;
+    std::condition_variable _frame_condition;
+    size_t _free_frame_count;
+    size_t _pending_frame_count = 0;
+};
+
+}
@@ -0,0 +1,285 @@
+//
+//  cpu_texture_manager.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "cpu_texture_manager.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include "load_profiler.hpp"
+#include "memory_tracker.hpp"
+#include "texture_cooker.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+void append_level(CpuTexture& texture, const uint8_t* data, size_t size)
+{
+    texture.pixels.resize(align_size(texture.pixels.size(), gpu_memory_alignment));
+    texture.level_offsets.push_back(texture.pixels.size());
+    texture.pixels.insert(texture.pixels.end(), data, data + size);
+}
+
+// levels after the first one and their alignment count as mip levels
+void track_texture(const CpuTexture& texture, bool is_added)
+{
+    const size_t base_bytes = texture.level_offsets.size() > 1 ? texture.level_offsets[1] : texture.pixels.size();
+    const size_t mip_bytes = texture.pixels.size() - base_bytes;
+    if (is_added)
+    {
+        track_texture_memory(texture.format, base_bytes, mip_bytes);
+    }
+    else
+    {
+        untrack_texture_memory(texture.format, base_bytes, mip_bytes);
+    }
+}
+
+}
+
+CpuTextureManager::CpuTextureManager(const AssetStorage& asset_storage) : _asset_storage(asset_storage)
+{
+}
+
+size_t CpuTextureManager::create_texture(const std::filesystem::path& file_path)
+{
+    return create_textures({file_path}).front();
+}
+
+std::vector<size_t> CpuTextureManager::create_textures(const std::vector<std::filesystem::path>& file_paths)
+{
+    std::vector<size_t> result(file_paths.size());
+
+    std::vector<std::filesystem::path> source_paths;
+    std::vector<size_t> source_indices;
+    for (size_t i = 0; i < file_paths.size(); i++)
+    {
+        if (const auto texture = _cache.acquire(file_paths[i]))
+        {
+            result[i] = *texture;
+            continue;
+        }
+
+        const auto cooked_path = get_cooked_texture_path(file_paths[i]);
+        std::error_code error;
+        if (!std::filesystem::exists(cooked_path, error))
+        {
+            source_paths.push_back(file_paths[i]);
+            source_indices.push_back(i);
+            continue;
+        }
+
+        LoadProfiler::Scope scope("texture_upload", cooked_path.filename().string());
+        result[i] = _textures.insert(make_texture(TextureFile(cooked_path)));
+        const auto& texture = _textures.get(result[i]);
+        _cache.add(result[i], file_paths[i], TextureContentKey(), texture.pixels.size());
+        track_texture(texture, true);
+    }
+
+    if (source_paths.empty())
+    {
+        return result;
+    }
+
+    while (_staging_arenas.size() < source_paths.size())
+    {
+        _staging_arenas.push_back(std::make_unique<StagingArena>());
+    }
+
+    std::vector<TextureContentKey> keys(source_paths.size());
+    std::vector<std::unique_ptr<Image>> images(source_paths.size());
+    _asset_storage.read(source_paths, [&](size_t index, std::vector<uint8_t>& data) {
+        keys[index] = get_texture_content_key(data.data(), data.size());
+        if (_cache.find(keys[index]))
+        {
+            return;
+        }
+
+        const auto item = source_paths[index].filename().string();
+        {
+            LoadProfiler::Scope scope("image_decode", item);
+            images[index] = std::make_unique<Image>(data.data(), data.size(), *_staging_arenas[index]);
+        }
+
+        prepare_image(*images[index], source_paths[index]);
+    });
+
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        if (const auto texture = _cache.find(keys[i]))
+        {
+            _cache.acquire(*texture, source_paths[i]);
+            result[source_indices[i]] = *texture;
+            continue;
+        }
+
+        LoadProfiler::Scope scope("texture_upload", source_paths[i].filename().string());
+        result[source_indices[i]] = _textures.insert(make_texture(*images[i]));
+        const auto& texture = _textures.get(result[source_indices[i]]);
+        _cache.add(result[source_indices[i]], source_paths[i], keys[i], texture.pixels.size());
+        track_texture(texture, true);
+    }
+
+    images.clear();
+    for (auto& arena : _staging_arenas)
+    {
+        arena->reset();
+    }
+    return result;
+}
+
+TextureRegion CpuTextureManager::create_texture_region(const std::filesystem::path& file_path)
+{
+    TextureRegion region;
+    region.texture = create_texture(file_path);
+    return region;
+}
+
+std::optional<size_t> CpuTextureManager::reload_texture(const std::filesystem::path& file_path)
+{
+    const auto index = _cache.find(file_path);
+    if (!index)
+    {
+        return std::nullopt;
+    }
+
+    const auto file_data = _asset_storage.read(file_path);
+    const auto key = get_texture_content_key(file_data.data(), file_data.size());
+    if (_cache.is_current(*index, key))
+    {
+        return std::nullopt;
+    }
+
+    Image image(file_data.data(), file_data.size());
+    prepare_image(image, file_path);
+    if (_cache.is_shared(*index))
+    {
+        const auto copy = _textures.insert(make_texture(image));
+        const auto& texture = _textures.get(copy);
+        track_texture(texture, true);
+        _cache.split(*index, file_path, copy, key, texture.pixels.size());
+        return copy;
+    }
+
+    auto& texture = _textures.get(*index);
+    track_texture(texture, false);
+    texture = make_texture(image);
+    track_texture(texture, true);
+    _cache.update(*index, key, texture.pixels.size());
+    return std::nullopt;
+}
+
+void CpuTextureManager::release_texture(size_t index)
+{
+    if (_cache.release(index))
+    {
+        track_texture(_textures.erase(index), false);
+    }
+}
+
+const CpuTexture& CpuTextureManager::get_texture(size_t index) const
+{
+    return _textures.get(index);
+}
+
+const TextureCache::Statistics& CpuTextureManager::get_cache_statistics() const
+{
+    return _cache.get_statistics();
+}
+
+void CpuTextureManager::prepare_image(Image& image, const std::filesystem::path& file_path)
+{
+    const auto item = file_path.filename().string();
+    {
+        LoadProfiler::Scope scope("texture_conversion", item);
+        image.convert_to_bgra();
+    }
+
+    LoadProfiler::Scope scope("mipmap_generation", item);
+    image.generate_mipmaps(get_mipmap_content(file_path), MipmapFilter::kaiser);
+}
+
+CpuTexture CpuTextureManager::make_texture(const Image& image)
+{
+    CpuTexture texture;
+    texture.width = image.width;
+    texture.height = image.height;
+
+    const size_t pixel_count = size_t(image.width) * size_t(image.height);
+    switch (image.components)
+    {
+        case 1:
+        {
+            // grey
+            texture.format = TextureFormat::r8_unorm;
+            texture.bytes_per_pixel = 1;
+            break;
+        }
+
+        case 4:
+        {
+            // blue, green, red, alpha
+            if (!image.is_bgra)
+            {
+                throw std::runtime_error("CpuTextureManager::make_texture() image is not converted to BGRA");
+            }
+
+            texture.format = TextureFormat::bgra8_unorm;
+            texture.bytes_per_pixel = 4;
+            break;
+        }
+
+        default:
+        {
+            std::stringstream t;
+            t << "CpuTextureManager::make_texture() unsupported number of components " << image.components;
+            throw std::runtime_error(t.str());
+        }
+    }
+
+    size_t size = align_size(texture.bytes_per_pixel * pixel_count, gpu_memory_alignment);
+    for (const auto& level : image.mip_levels)
+    {
+        size += align_size(size_t(texture.bytes_per_pixel) * size_t(level.width) * size_t(level.height), gpu_memory_alignment);
+    }
+    texture.pixels.reserve(size);
+
+    append_level(texture, image.data, texture.bytes_per_pixel * pixel_count);
+    for (const auto& level : image.mip_levels)
+    {
+        append_level(texture, level.data, size_t(texture.bytes_per_pixel) * size_t(level.width) * size_t(level.height));
+    }
+
+    return texture;
+}
+
+CpuTexture CpuTextureManager::make_texture(const TextureFile& file)
+{
+    const auto& header = file.get_header();
+
+    CpuTexture texture;
+    texture.format = header.format;
+    texture.width = int(header.width);
+    texture.height = int(header.height);
+    if (header.format == TextureFormat::r8_unorm)
+    {
+        texture.bytes_per_pixel = 1;
+    }
+    else if (header.format == TextureFormat::bgra8_unorm)
+    {
+        texture.bytes_per_pixel = 4;
+    }
+
+    for (size_t i = 0; i < header.level_count; i++)
+    {
+        append_level(texture, file.get_level_data(i), file.get_level(i).size);
+    }
+    return texture;
+}
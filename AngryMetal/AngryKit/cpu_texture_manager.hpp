@@ -0,0 +1,74 @@
+//
+//  cpu_texture_manager.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "asset_storage.hpp"
+#include "image.hpp"
+#include "slot_map.hpp"
+#include "staging_arena.hpp"
+#include "texture_cache.hpp"
+#include "texture_file.hpp"
+#include "texture_manager_interface.hpp"
+
+namespace angry
+{
+
+// Pixels are converted like TextureManager does for Metal: BGRA for color, R8 for grey,
+// with the full mip chain. Cooked textures keep the format of their file. Every level starts
+// on `gpu_memory_alignment` like it would in a linear Metal texture.
+struct CpuTexture
+{
+    TextureFormat format = TextureFormat::bgra8_unorm;
+    int width = 0;
+    int height = 0;
+    // 0 for block compressed formats
+    int bytes_per_pixel = 0;
+    AlignedVector<uint8_t> pixels;
+
+    // offset of every level in `pixels`, the first one is 0
+    std::vector<size_t> level_offsets;
+};
+
+class CpuTextureManager final : public TextureManagerInterface
+{
+public:
+    explicit CpuTextureManager(const AssetStorage& asset_storage);
+
+    CpuTextureManager(const CpuTextureManager&) = delete;
+    CpuTextureManager(CpuTextureManager&&) = delete;
+    CpuTextureManager& operator=(const CpuTextureManager&) = delete;
+    CpuTextureManager& operator=(CpuTextureManager&&) = delete;
+
+    size_t create_texture(const std::filesystem::path& file_path) override;
+    std::vector<size_t> create_textures(const std::vector<std::filesystem::path>& file_paths) override;
+    // every image gets a texture of its own, there is no binding to save without a GPU
+    TextureRegion create_texture_region(const std::filesystem::path& file_path) override;
+    std::optional<size_t> reload_texture(const std::filesystem::path& file_path) override;
+    void release_texture(size_t index) override;
+
+    const CpuTexture& get_texture(size_t index) const;
+    const TextureCache::Statistics& get_cache_statistics() const;
+
+private:
+    static void prepare_image(Image& image, const std::filesystem::path& file_path);
+    static CpuTexture make_texture(const Image& image);
+    static CpuTexture make_texture(const TextureFile& file);
+
+private:
+    const AssetStorage& _asset_storage;
+    SlotMap<CpuTexture> _textures;
+    TextureCache _cache;
+    std::vector<std::unique_ptr<StagingArena>> _staging_arenas;
+};
+
+}
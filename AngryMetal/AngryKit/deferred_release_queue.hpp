@@ -0,0 +1,63 @@
+//
+//  deferred_release_queue.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace angry
+{
+
+// Keeps memory of released resources until every frame which could still use it is done on
+// the GPU. Frames are counted by the owner, releases arrive in frame order.
+template<typename T>
+class DeferredReleaseQueue final
+{
+public:
+    DeferredReleaseQueue() = default;
+
+    DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue(DeferredReleaseQueue&&) = delete;
+    DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue& operator=(DeferredReleaseQueue&&) = delete;
+
+    // `frame` is the one being recorded, earlier frames may use the value as well
+    void push(T value, uint64_t frame)
+    {
+        _entries.push_back(Entry{std::move(value), frame});
+    }
+
+    // gives every value released in `completed_frame` or before to `release`
+    template<typename F>
+    void retire(uint64_t completed_frame, F&& release)
+    {
+        while (!_entries.empty() && _entries.front().frame <= completed_frame)
+        {
+            release(_entries.front().value);
+            _entries.pop_front();
+        }
+    }
+
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+private:
+    struct Entry
+    {
+        T value;
+        uint64_t frame = 0;
+    };
+
+    std::deque<Entry> _entries;
+};
+
+}
@@ -26,10 +26,8 @@ EnemyRenderPass::EnemyRenderPass(id<MTLDevice> device, id<MTLLibrary> library)
         MaterialTexture::diffuse
     };
 
-    _instance_buffer_attributes = {
-        {InstanceBufferType::transform, 4},
-        {InstanceBufferType::aim_rotation, 5}
-    };
+    _instance_buffer_attributes[InstanceBufferType::transform] = 4;
+    _instance_buffer_attributes[InstanceBufferType::aim_rotation] = 5;
 
     setup_state(device, library);
 
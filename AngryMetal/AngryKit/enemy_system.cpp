@@ -7,6 +7,7 @@
 
 #include "enemy_system.hpp"
 
+#include "chunk_component.hpp"
 #include "collider_component.hpp"
 #include "health_component.hpp"
 #include "instanced_mesh_component.hpp"
@@ -49,12 +50,9 @@ void EnemySystem::update(Scene& scene, float delta_time)
                 break;
             }
 
-            const float theta = rand() % 360 * math::radians;
-            const float x = player_position.x + sin(theta) * _spawn_radius;
-            const float z = player_position.z + cos(theta) * _spawn_radius;
-
             auto& transform_component = scene.get_registry().get<TransformComponent>(*entity);
-            transform_component.position = {x, monster_y, z};
+            transform_component.position = get_spawn_position(scene, player_position);
+            transform_component.position.y = monster_y;
             
             auto& mesh_component = scene.get_registry().get<InstancedMeshComponent>(*entity);
             mesh_component.is_visible = true;
@@ -93,3 +91,31 @@ void EnemySystem::update(Scene& scene, float delta_time)
         player_health_component.health = 0;
     }
 }
+
+simd_float3 EnemySystem::get_spawn_position(Scene& scene, simd_float3 player_position)
+{
+    // prefer spawn points of streamed chunks around spawn radius
+    _spawn_candidates.clear();
+    auto& registry = scene.get_registry();
+    for (auto entity : scene.get_chunk_pool().get_active())
+    {
+        for (const auto& point : registry.get<ChunkComponent>(entity).spawn_points)
+        {
+            const auto d = simd_distance(point.xz, player_position.xz);
+            if (d > 0.5f * _spawn_radius && d < 1.5f * _spawn_radius)
+            {
+                _spawn_candidates.push_back(point);
+            }
+        }
+    }
+
+    if (!_spawn_candidates.empty())
+    {
+        return _spawn_candidates[rand() % _spawn_candidates.size()];
+    }
+
+    const float theta = rand() % 360 * math::radians;
+    const float x = player_position.x + sin(theta) * _spawn_radius;
+    const float z = player_position.z + cos(theta) * _spawn_radius;
+    return simd_float3{x, 0.0f, z};
+}
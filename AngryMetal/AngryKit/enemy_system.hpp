@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include <simd/simd.h>
+
+#include <vector>
+
 namespace angry
 {
 
@@ -24,7 +28,10 @@ public:
     EnemySystem& operator=(EnemySystem&&) = delete;
 
     void update(Scene& scene, float delta_time);
-    
+
+private:
+    simd_float3 get_spawn_position(Scene& scene, simd_float3 player_position);
+
 private:
     const float _spawn_interval = 1.0f; // seconds
     const int _spawns_per_interval = 1;
@@ -33,6 +40,7 @@ private:
     const float _player_collision_radius = 0.35f;
 
     float _countdown = 0;
+    std::vector<simd_float3> _spawn_candidates;
 };
 
 }
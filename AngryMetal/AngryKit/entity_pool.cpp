@@ -11,7 +11,7 @@
 
 using namespace angry;
 
-EntityPool::EntityPool(entt::registry& registry, size_t size)
+EntityPool::EntityPool(Registry& registry, size_t size)
 {
     _idle.reserve(size);
     for (size_t i = 0; i < size; i++)
@@ -40,3 +40,14 @@ const std::vector<entt::entity>& EntityPool::get_idle() const
 {
     return _idle;
 }
+
+const std::vector<entt::entity>& EntityPool::get_active() const
+{
+    return _active;
+}
+
+void EntityPool::release_all()
+{
+    _idle.insert(_idle.end(), _active.cbegin(), _active.cend());
+    _active.clear();
+}
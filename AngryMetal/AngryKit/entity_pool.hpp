@@ -12,17 +12,22 @@
 
 #include <entt/entt.hpp>
 
+#include "registry.hpp"
+
 namespace angry
 {
 
 class EntityPool final
 {
 public:
-    EntityPool(entt::registry& registry, size_t size);
+    EntityPool(Registry& registry, size_t size);
 
     std::optional<entt::entity> get_entity();
 
     const std::vector<entt::entity>& get_idle() const;
+    const std::vector<entt::entity>& get_active() const;
+
+    void release_all();
 
     template<class T>
     void release_if(T function)
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <array>
+#include <bitset>
+#include <stdexcept>
 
 template<typename E, class T, std::size_t N>
 class EnumArray final
@@ -26,3 +28,65 @@ public:
 private:
     std::array<T, N> _array;
 };
+
+// EnumArray which knows which entries are set, a flat stand-in for maps keyed by small enums.
+template<typename E, class T, std::size_t N>
+class EnumTable final
+{
+public:
+    // marks the entry as set, like operator[] of a map
+    T& operator[](E e)
+    {
+        _is_set[static_cast<std::size_t>(e)] = true;
+        return _values[e];
+    }
+
+    const T& at(E e) const
+    {
+        if (!contains(e))
+        {
+            throw std::out_of_range("EnumTable::at() entry is not set");
+        }
+        return _values[e];
+    }
+
+    // null if the entry is not set
+    const T* find(E e) const
+    {
+        return contains(e) ? &_values[e] : nullptr;
+    }
+
+    bool contains(E e) const
+    {
+        return _is_set[static_cast<std::size_t>(e)];
+    }
+
+    bool empty() const
+    {
+        return _is_set.none();
+    }
+
+    void clear()
+    {
+        _values = {};
+        _is_set.reset();
+    }
+
+    // calls `function(e, value)` for set entries in enum order
+    template<typename F>
+    void for_each(F&& function) const
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if (_is_set[i])
+            {
+                const auto e = static_cast<E>(i);
+                function(e, _values[e]);
+            }
+        }
+    }
+
+private:
+    EnumArray<E, T, N> _values = {};
+    std::bitset<N> _is_set;
+};
@@ -0,0 +1,224 @@
+//
+//  file_watcher.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "file_watcher.hpp"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+using namespace angry;
+
+namespace
+{
+
+void remove_duplicates(std::vector<std::filesystem::path>& paths)
+{
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+}
+
+#if defined(__linux__)
+
+class InotifyFileWatcher final : public FileWatcherInterface
+{
+public:
+    explicit InotifyFileWatcher(const std::filesystem::path& directory);
+    ~InotifyFileWatcher();
+
+    InotifyFileWatcher(const InotifyFileWatcher&) = delete;
+    InotifyFileWatcher(InotifyFileWatcher&&) = delete;
+    InotifyFileWatcher& operator=(const InotifyFileWatcher&) = delete;
+    InotifyFileWatcher& operator=(InotifyFileWatcher&&) = delete;
+
+    std::vector<std::filesystem::path> poll() override;
+
+private:
+    void add_directory(const std::filesystem::path& directory);
+
+private:
+    int _file = -1;
+    std::unordered_map<int, std::filesystem::path> _directories;
+};
+
+InotifyFileWatcher::InotifyFileWatcher(const std::filesystem::path& directory)
+{
+    _file = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_file < 0)
+    {
+        throw std::runtime_error("InotifyFileWatcher() inotify is not available");
+    }
+
+    try
+    {
+        add_directory(directory);
+    }
+    catch (...)
+    {
+        close(_file);
+        throw;
+    }
+}
+
+InotifyFileWatcher::~InotifyFileWatcher()
+{
+    close(_file);
+}
+
+std::vector<std::filesystem::path> InotifyFileWatcher::poll()
+{
+    std::vector<std::filesystem::path> result;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        const auto size = read(_file, buffer, sizeof(buffer));
+        if (size <= 0)
+        {
+            // EAGAIN, queue is drained
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < size;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto i = _directories.find(event->wd);
+            if (i == _directories.end() || event->len == 0)
+            {
+                continue;
+            }
+
+            const auto path = i->second / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    add_directory(path);
+                }
+                continue;
+            }
+
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                result.push_back(path);
+            }
+        }
+    }
+
+    remove_duplicates(result);
+    return result;
+}
+
+void InotifyFileWatcher::add_directory(const std::filesystem::path& directory)
+{
+    const int wd = inotify_add_watch(_file, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        throw std::runtime_error("InotifyFileWatcher::add_directory() fail to watch " + directory.string());
+    }
+    _directories[wd] = directory;
+
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory, error))
+    {
+        if (item.is_directory())
+        {
+            add_directory(item.path());
+        }
+    }
+}
+
+#endif
+
+}
+
+PollingFileWatcher::PollingFileWatcher(const std::filesystem::path& directory, std::chrono::milliseconds interval)
+    : _directory(directory), _interval(interval), _last_scan(std::chrono::steady_clock::now())
+{
+    scan(nullptr);
+}
+
+std::vector<std::filesystem::path> PollingFileWatcher::poll()
+{
+    std::vector<std::filesystem::path> result;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _last_scan < _interval)
+    {
+        return result;
+    }
+    _last_scan = now;
+
+    scan(&result);
+    remove_duplicates(result);
+    return result;
+}
+
+void PollingFileWatcher::scan(std::vector<std::filesystem::path>* changed)
+{
+    // files can disappear while scanning, errors are skipped
+    std::error_code error;
+    for (auto i = std::filesystem::recursive_directory_iterator(_directory, error);
+         i != std::filesystem::recursive_directory_iterator();
+         i.increment(error))
+    {
+        if (error || !i->is_regular_file(error))
+        {
+            continue;
+        }
+
+        FileState state;
+        state.time = i->last_write_time(error);
+        state.size = i->file_size(error);
+        if (error)
+        {
+            continue;
+        }
+
+        auto p = _files.emplace(i->path().string(), state);
+        if (p.second)
+        {
+            if (changed != nullptr)
+            {
+                changed->push_back(i->path());
+            }
+            continue;
+        }
+
+        if (p.first->second.time != state.time || p.first->second.size != state.size)
+        {
+            p.first->second = state;
+            if (changed != nullptr)
+            {
+                changed->push_back(i->path());
+            }
+        }
+    }
+}
+
+std::unique_ptr<FileWatcherInterface> angry::make_file_watcher(const std::filesystem::path& directory)
+{
+#if defined(__linux__)
+    try
+    {
+        return std::make_unique<InotifyFileWatcher>(directory);
+    }
+    catch (const std::runtime_error&)
+    {
+        // out of watches, fall back to polling
+    }
+#endif
+    return std::make_unique<PollingFileWatcher>(directory, std::chrono::milliseconds(500));
+}
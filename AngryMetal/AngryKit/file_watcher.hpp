@@ -0,0 +1,56 @@
+//
+//  file_watcher.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace angry
+{
+
+struct FileWatcherInterface
+{
+    virtual ~FileWatcherInterface() = default;
+
+    // Files of the watched directory written since the previous call, never blocks.
+    virtual std::vector<std::filesystem::path> poll() = 0;
+};
+
+// Compares modification times of all files, the directory is scanned at most once per `interval`.
+class PollingFileWatcher final : public FileWatcherInterface
+{
+public:
+    PollingFileWatcher(const std::filesystem::path& directory, std::chrono::milliseconds interval);
+
+    std::vector<std::filesystem::path> poll() override;
+
+private:
+    struct FileState
+    {
+        std::filesystem::file_time_type time;
+        uintmax_t size = 0;
+    };
+
+    void scan(std::vector<std::filesystem::path>* changed);
+
+private:
+    std::filesystem::path _directory;
+    std::chrono::milliseconds _interval;
+    std::chrono::steady_clock::time_point _last_scan;
+    std::unordered_map<std::string, FileState> _files;
+};
+
+// inotify on Linux, PollingFileWatcher otherwise.
+std::unique_ptr<FileWatcherInterface> make_file_watcher(const std::filesystem::path& directory);
+
+}
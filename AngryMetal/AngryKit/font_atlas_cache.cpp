@@ -0,0 +1,270 @@
+//
+//  font_atlas_cache.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "font_atlas_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "on_exit.hpp"
+#include "texture_cache.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+constexpr size_t uv_line_count = IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1;
+
+struct FontAtlasFileHeader
+{
+    char magic[4] = {'A', 'F', 'N', 'T'};
+    uint32_t version = 1;
+    uint64_t key = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t font_count = 0;
+    uint32_t reserved = 0;
+    float uv_white_pixel[2] = {};
+    float uv_lines[4 * uv_line_count] = {};
+};
+
+struct FontRecord
+{
+    float size = 0.0f;
+    float ascent = 0.0f;
+    float descent = 0.0f;
+    uint32_t fallback_char = 0;
+    uint32_t ellipsis_char = 0;
+    uint32_t glyph_count = 0;
+};
+
+struct GlyphRecord
+{
+    uint32_t codepoint = 0;
+    float advance_x = 0.0f;
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+template<typename T>
+void append(std::vector<uint8_t>& buffer, const T& value)
+{
+    const auto* p = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+}
+
+uint64_t ui::get_font_atlas_key(
+    const ImFontAtlas& atlas,
+    const std::vector<uint8_t>& font_data,
+    const std::vector<float>& sizes,
+    const ImFontConfig& config,
+    const ImWchar* glyph_ranges
+)
+{
+    std::vector<uint8_t> buffer;
+    append(buffer, int(IMGUI_VERSION_NUM));
+    append(buffer, get_content_hash(font_data.data(), font_data.size()));
+    for (auto size : sizes)
+    {
+        append(buffer, size);
+    }
+
+    append(buffer, atlas.Flags);
+    append(buffer, atlas.TexDesiredWidth);
+    append(buffer, atlas.TexGlyphPadding);
+    append(buffer, config.OversampleH);
+    append(buffer, config.OversampleV);
+    append(buffer, config.PixelSnapH);
+    append(buffer, config.RasterizerMultiply);
+    for (auto p = glyph_ranges; *p != 0; p++)
+    {
+        append(buffer, *p);
+    }
+
+    return get_content_hash(buffer.data(), buffer.size());
+}
+
+bool ui::load_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& file_path, uint64_t key)
+{
+    const int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    OnExit close_file([file]() {
+        close(file);
+    });
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0 || size_t(file_stat.st_size) < sizeof(FontAtlasFileHeader))
+    {
+        return false;
+    }
+
+    const size_t size = size_t(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    OnExit unmap_file([data, size]() {
+        munmap(data, size);
+    });
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    const auto& header = *reinterpret_cast<const FontAtlasFileHeader*>(bytes);
+    if (std::memcmp(header.magic, FontAtlasFileHeader().magic, sizeof(header.magic)) != 0
+        || header.version != FontAtlasFileHeader().version
+        || header.key != key
+        || header.font_count == 0)
+    {
+        return false;
+    }
+
+    // records are checked before the atlas is touched
+    std::vector<const FontRecord*> fonts;
+    size_t offset = sizeof(FontAtlasFileHeader);
+    for (uint32_t i = 0; i < header.font_count; i++)
+    {
+        if (offset + sizeof(FontRecord) > size)
+        {
+            return false;
+        }
+
+        fonts.push_back(reinterpret_cast<const FontRecord*>(bytes + offset));
+        offset += sizeof(FontRecord) + size_t(fonts.back()->glyph_count) * sizeof(GlyphRecord);
+    }
+
+    const size_t pixel_count = size_t(header.width) * size_t(header.height);
+    if (pixel_count == 0 || offset + pixel_count != size)
+    {
+        return false;
+    }
+
+    atlas.Clear();
+    for (const auto* record : fonts)
+    {
+        ImFont* font = IM_NEW(ImFont);
+        atlas.Fonts.push_back(font);
+        font->ContainerAtlas = &atlas;
+        font->FontSize = record->size;
+        font->Ascent = record->ascent;
+        font->Descent = record->descent;
+        font->FallbackChar = ImWchar(record->fallback_char);
+        font->EllipsisChar = ImWchar(record->ellipsis_char);
+
+        // without a config glyphs are stored exactly as they were saved
+        const auto* glyphs = reinterpret_cast<const GlyphRecord*>(record + 1);
+        for (uint32_t k = 0; k < record->glyph_count; k++)
+        {
+            const auto& glyph = glyphs[k];
+            font->AddGlyph(nullptr, ImWchar(glyph.codepoint),
+                           glyph.x0, glyph.y0, glyph.x1, glyph.y1,
+                           glyph.u0, glyph.v0, glyph.u1, glyph.v1,
+                           glyph.advance_x);
+        }
+        font->BuildLookupTable();
+    }
+
+    // the atlas frees its pixels, so they are copied out of the mapping
+    atlas.TexWidth = int(header.width);
+    atlas.TexHeight = int(header.height);
+    atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixel_count));
+    std::memcpy(atlas.TexPixelsAlpha8, bytes + offset, pixel_count);
+
+    atlas.TexUvScale = ImVec2(1.0f / float(header.width), 1.0f / float(header.height));
+    atlas.TexUvWhitePixel = ImVec2(header.uv_white_pixel[0], header.uv_white_pixel[1]);
+    for (size_t i = 0; i < uv_line_count; i++)
+    {
+        const float* line = header.uv_lines + 4 * i;
+        atlas.TexUvLines[i] = ImVec4(line[0], line[1], line[2], line[3]);
+    }
+#if IMGUI_VERSION_NUM >= 18700
+    atlas.TexReady = true;
+#endif
+
+    return true;
+}
+
+bool ui::save_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& file_path, uint64_t key)
+{
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    FontAtlasFileHeader header;
+    header.key = key;
+    header.width = uint32_t(width);
+    header.height = uint32_t(height);
+    header.font_count = uint32_t(atlas.Fonts.Size);
+    header.uv_white_pixel[0] = atlas.TexUvWhitePixel.x;
+    header.uv_white_pixel[1] = atlas.TexUvWhitePixel.y;
+    for (size_t i = 0; i < uv_line_count; i++)
+    {
+        const auto& line = atlas.TexUvLines[i];
+        header.uv_lines[4 * i + 0] = line.x;
+        header.uv_lines[4 * i + 1] = line.y;
+        header.uv_lines[4 * i + 2] = line.z;
+        header.uv_lines[4 * i + 3] = line.w;
+    }
+
+    std::vector<uint8_t> buffer;
+    append(buffer, header);
+    for (const ImFont* font : atlas.Fonts)
+    {
+        FontRecord record;
+        record.size = font->FontSize;
+        record.ascent = font->Ascent;
+        record.descent = font->Descent;
+        record.fallback_char = font->FallbackChar;
+        record.ellipsis_char = font->EllipsisChar;
+        record.glyph_count = uint32_t(font->Glyphs.Size);
+        append(buffer, record);
+
+        for (const auto& glyph : font->Glyphs)
+        {
+            append(buffer, GlyphRecord{
+                glyph.Codepoint, glyph.AdvanceX,
+                glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+                glyph.U0, glyph.V0, glyph.U1, glyph.V1
+            });
+        }
+    }
+    buffer.insert(buffer.end(), pixels, pixels + size_t(width) * size_t(height));
+
+    auto temporary_path = file_path;
+    temporary_path += ".tmp";
+    {
+        std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+        if (!stream)
+        {
+            stream.close();
+            std::error_code error;
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, file_path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+//
+//  font_atlas_cache.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <imgui.h>
+
+namespace angry::ui
+{
+
+// Everything the rasterized atlas depends on, ImGui version included.
+uint64_t get_font_atlas_key(
+    const ImFontAtlas& atlas,
+    const std::vector<uint8_t>& font_data,
+    const std::vector<float>& sizes,
+    const ImFontConfig& config,
+    const ImWchar* glyph_ranges
+);
+
+// Replaces content of `atlas` with the mapped file, fonts follow the order they were saved in.
+// False if the file is missing, broken or was saved for another key.
+bool load_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& file_path, uint64_t key);
+
+// Writes a built atlas next to `file_path` and renames it, a failure leaves no file behind.
+bool save_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& file_path, uint64_t key);
+
+}
@@ -0,0 +1,87 @@
+//
+//  frame_arena.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "frame_arena.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace angry;
+
+namespace
+{
+
+size_t get_padding(const uint8_t* p, size_t alignment)
+{
+    const auto address = reinterpret_cast<uintptr_t>(p);
+    return (alignment - address % alignment) % alignment;
+}
+
+}
+
+FrameArena::FrameArena(const Settings& settings)
+{
+    if (settings.capacity == 0)
+    {
+        throw std::runtime_error("FrameArena::FrameArena() empty arena");
+    }
+    add_block(settings.capacity);
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    auto* block = &_blocks.back();
+    size_t padding = get_padding(block->data.get() + block->used, alignment);
+    if (block->used + padding + size > block->capacity)
+    {
+        _full_used += block->used;
+        _statistics.overflow_count += 1;
+        add_block(std::max(block->capacity, size + alignment));
+
+        block = &_blocks.back();
+        padding = get_padding(block->data.get(), alignment);
+    }
+
+    uint8_t* result = block->data.get() + block->used + padding;
+    block->used += padding + size;
+    _statistics.max_used = std::max(_statistics.max_used, get_used());
+    return result;
+}
+
+void FrameArena::reset()
+{
+    if (_blocks.size() > 1)
+    {
+        const size_t capacity = _statistics.capacity;
+        _blocks.clear();
+        _statistics.capacity = 0;
+        add_block(capacity);
+    }
+
+    _blocks.back().used = 0;
+    _full_used = 0;
+}
+
+size_t FrameArena::get_used() const
+{
+    return _full_used + _blocks.back().used;
+}
+
+const FrameArena::Statistics& FrameArena::get_statistics() const
+{
+    return _statistics;
+}
+
+void FrameArena::add_block(size_t capacity)
+{
+    Block block;
+    // not value initialized, every allocation is written before it is read
+    block.data.reset(new uint8_t[capacity]);
+    block.capacity = capacity;
+    _blocks.push_back(std::move(block));
+    _statistics.capacity += capacity;
+}
@@ -0,0 +1,119 @@
+//
+//  frame_arena.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace angry
+{
+
+// Bump allocator for data which lives until the end of the frame, everything is given back
+// by `reset`. An overflow takes another block from the heap, the next `reset` merges blocks
+// so later frames fit in one. Not thread safe, systems run on one thread.
+class FrameArena final
+{
+public:
+    struct Settings
+    {
+        // per vertex skinning matrices of the player take most of it
+        size_t capacity = 1024 * 1024;
+    };
+
+    struct Statistics
+    {
+        size_t capacity = 0;
+        size_t max_used = 0;
+        size_t overflow_count = 0;
+    };
+
+public:
+    explicit FrameArena(const Settings& settings);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+
+    void reset();
+
+    size_t get_used() const;
+    const Statistics& get_statistics() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    void add_block(size_t capacity);
+
+private:
+    std::vector<Block> _blocks;
+    // used bytes of blocks before the last one
+    size_t _full_used = 0;
+    Statistics _statistics;
+};
+
+// Standard allocator on top of the arena, deallocation does nothing. Containers using it
+// must be gone before the arena is reset.
+template<typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) : _arena(&arena)
+    {
+    }
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : _arena(&other.get_arena())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+    FrameArena& get_arena() const
+    {
+        return *_arena;
+    }
+
+private:
+    FrameArena* _arena;
+};
+
+template<typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b)
+{
+    return &a.get_arena() == &b.get_arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}
@@ -0,0 +1,85 @@
+//
+//  frame_ring.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "frame_ring.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "aligned_allocator.hpp"
+
+using namespace angry;
+
+FrameRing::FrameRing(const Settings& settings)
+    : _frame_count(settings.frame_count), _frame_capacity(align_size(settings.frame_capacity, gpu_memory_alignment))
+{
+    if (settings.frame_count == 0 || settings.frame_capacity == 0)
+    {
+        throw std::runtime_error("FrameRing::FrameRing() empty ring");
+    }
+}
+
+void FrameRing::begin_frame()
+{
+    _frame_index = (_frame_index + 1) % _frame_count;
+    _frame_used = 0;
+    _statistics.frame_count += 1;
+}
+
+std::optional<size_t> FrameRing::allocate(size_t size)
+{
+    const size_t aligned_size = align_size(std::max(size, size_t(1)), gpu_memory_alignment);
+    if (_frame_used + aligned_size > _frame_capacity)
+    {
+        return std::nullopt;
+    }
+
+    const size_t result = get_frame_offset() + _frame_used;
+    _frame_used += aligned_size;
+    _statistics.max_frame_used = std::max(_statistics.max_frame_used, _frame_used);
+    return result;
+}
+
+void FrameRing::grow(size_t size)
+{
+    const size_t required = _frame_used + align_size(std::max(size, size_t(1)), gpu_memory_alignment);
+    while (_frame_capacity < required)
+    {
+        _frame_capacity *= 2;
+    }
+    _statistics.grow_count += 1;
+}
+
+size_t FrameRing::get_frame_count() const
+{
+    return _frame_count;
+}
+
+size_t FrameRing::get_frame_index() const
+{
+    return _frame_index;
+}
+
+size_t FrameRing::get_frame_offset() const
+{
+    return _frame_index * _frame_capacity;
+}
+
+size_t FrameRing::get_frame_used() const
+{
+    return _frame_used;
+}
+
+size_t FrameRing::get_size() const
+{
+    return _frame_count * _frame_capacity;
+}
+
+const FrameRing::Statistics& FrameRing::get_statistics() const
+{
+    return _statistics;
+}
@@ -0,0 +1,71 @@
+//
+//  frame_ring.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace angry
+{
+
+// Splits one buffer into a region per frame in flight and bump allocates per frame data from
+// the region of the current frame. A region is reused `frame_count` frames later, buffer
+// managers wait for the GPU to finish that old frame before they call `begin_frame`.
+class FrameRing final
+{
+public:
+    static constexpr size_t max_frames_in_flight = 3;
+
+    struct Settings
+    {
+        size_t frame_count = max_frames_in_flight;
+        size_t frame_capacity = 256 * 1024;
+    };
+
+    struct Statistics
+    {
+        size_t frame_count = 0;
+        size_t max_frame_used = 0;
+        size_t grow_count = 0;
+    };
+
+public:
+    explicit FrameRing(const Settings& settings);
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing(FrameRing&&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+    FrameRing& operator=(FrameRing&&) = delete;
+
+    // everything allocated in the region of the next frame before is free again
+    void begin_frame();
+
+    // offset in the ring, aligned for Metal, nothing when the region is full
+    std::optional<size_t> allocate(size_t size);
+
+    // makes room for `size` more bytes in every region, the manager copies the used part of
+    // the current region to `get_frame_offset` of new memory and moves offsets of this frame
+    void grow(size_t size);
+
+    size_t get_frame_count() const;
+    size_t get_frame_index() const;
+    size_t get_frame_offset() const;
+    size_t get_frame_used() const;
+    // of the whole ring
+    size_t get_size() const;
+    const Statistics& get_statistics() const;
+
+private:
+    const size_t _frame_count;
+    size_t _frame_capacity;
+    size_t _frame_index = 0;
+    size_t _frame_used = 0;
+    Statistics _statistics;
+};
+
+}
@@ -11,12 +11,10 @@
 #include "camera_component.hpp"
 #include "health_component.hpp"
 #include "input_component.hpp"
-#include "instanced_mesh_component.hpp"
 #include "look_component.hpp"
 #include "movement_component.hpp"
 #include "scene.hpp"
 #include "score_component.hpp"
-#include "time_component.hpp"
 #include "transform_component.hpp"
 
 using namespace angry;
@@ -78,24 +76,15 @@ void GameRestartSystem::update(Scene& scene, float aspect)
 
     {
         auto& pool = scene.get_enemy_pool();
-        pool.release_if([&registry](auto entity) {
-            auto& mesh_component = registry.get<InstancedMeshComponent>(entity);
-            mesh_component.is_visible = false;
-
-            return true;
-        });
+        const auto& entities = pool.get_active();
+        scene.get_enemy_prefab().reset(registry, entities.cbegin(), entities.cend());
+        pool.release_all();
     }
 
     {
         auto& pool = scene.get_bullet_pool();
-        pool.release_if([&registry](auto entity) {
-            auto& time_component = registry.get<TimeComponent>(entity);
-            time_component.time = 0;
-
-            auto& mesh_component = registry.get<InstancedMeshComponent>(entity);
-            mesh_component.is_visible = false;
-
-            return true;
-        });
+        const auto& entities = pool.get_active();
+        scene.get_bullet_prefab().reset(registry, entities.cbegin(), entities.cend());
+        pool.release_all();
     }
 }
@@ -0,0 +1,48 @@
+//
+//  hot_reload_system.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "hot_reload_system.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "scene.hpp"
+
+using namespace angry;
+
+HotReloadSystem::HotReloadSystem(std::unique_ptr<FileWatcherInterface> file_watcher)
+    : _file_watcher(std::move(file_watcher))
+{
+}
+
+void HotReloadSystem::update(Scene& scene)
+{
+    const auto changed = _file_watcher->poll();
+    if (changed.empty())
+    {
+        return;
+    }
+
+    std::stringstream errors;
+    for (const auto& file_path : scene.get_asset_graph().get_affected(changed))
+    {
+        try
+        {
+            scene.reload(file_path);
+        }
+        catch (const std::runtime_error& e)
+        {
+            // file can be half written, it is reloaded again on the next change
+            errors << " " << e.what() << ";";
+        }
+    }
+
+    if (errors.tellp() > 0)
+    {
+        throw std::runtime_error("HotReloadSystem::update() fail to reload:" + errors.str());
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  hot_reload_system.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <memory>
+
+#include "file_watcher.hpp"
+
+namespace angry
+{
+
+class Scene;
+
+class HotReloadSystem final
+{
+public:
+    explicit HotReloadSystem(std::unique_ptr<FileWatcherInterface> file_watcher);
+    ~HotReloadSystem() = default;
+
+    HotReloadSystem(const HotReloadSystem&) = delete;
+    HotReloadSystem(HotReloadSystem&&) = delete;
+    HotReloadSystem& operator=(const HotReloadSystem&) = delete;
+    HotReloadSystem& operator=(HotReloadSystem&&) = delete;
+
+    // Re-imports changed files and their dependents, must run before other systems of the frame.
+    // Failed files are reported after the rest are reloaded.
+    void update(Scene& scene);
+
+private:
+    std::unique_ptr<FileWatcherInterface> _file_watcher;
+};
+
+}
@@ -14,6 +14,7 @@
 #include <vector>
 #include <sstream>
 
+#include "asset_storage.hpp"
 #include "enum_array.hpp"
 #include "metal_context.h"
 #include "screen.hpp"
@@ -27,7 +28,13 @@ class Scene;
 class HUD final
 {
 public:
-    HUD(id<MTLDevice> device, TextureManager* texture_manager, const std::filesystem::path& assets_path);
+    HUD(
+        id<MTLDevice> device,
+        TextureManager* texture_manager,
+        const AssetStorage& asset_storage,
+        const std::filesystem::path& assets_path,
+        const std::filesystem::path& cache_directory
+    );
     ~HUD();
 
     HUD(const HUD&) = delete;
@@ -57,6 +64,9 @@ private:
     EnumArray<ScreenIndex, std::unique_ptr<ui::Screen>, 3> _screens;
     ui::Context _context;
     ScreenIndex _current_screen_index = ScreenIndex::none;
+
+    // font atlas does not own font data
+    std::vector<uint8_t> _font_data;
 };
 
 }
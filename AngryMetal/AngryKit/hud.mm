@@ -13,6 +13,7 @@
 
 #include "game_over_screen.hpp"
 #include "health_component.hpp"
+#include "hud_fonts.hpp"
 #include "input_component.hpp"
 #include "math.hpp"
 #include "play_screen.hpp"
@@ -20,7 +21,13 @@
 
 using namespace angry;
 
-HUD::HUD(id<MTLDevice> device, TextureManager* texture_manager, const std::filesystem::path& assets_path)
+HUD::HUD(
+    id<MTLDevice> device,
+    TextureManager* texture_manager,
+    const AssetStorage& asset_storage,
+    const std::filesystem::path& assets_path,
+    const std::filesystem::path& cache_directory
+)
 {
     const std::filesystem::path hud_path = assets_path / "HUD";
 
@@ -34,9 +41,7 @@ HUD::HUD(id<MTLDevice> device, TextureManager* texture_manager, const std::files
         ImGui::StyleColorsDark();
 
         ImGuiIO& io = ImGui::GetIO();
-        const auto font_path = hud_path / "Roboto-Medium.ttf";
-        _context.default_font = io.Fonts->AddFontFromFileTTF(font_path.c_str(), 16.0f);
-        _context.big_font = io.Fonts->AddFontFromFileTTF(font_path.c_str(), 32.0f);
+        ui::load_fonts(*io.Fonts, asset_storage, hud_path, cache_directory, _font_data, _context);
 
         ImGui_ImplMetal_Init(device);
     }
@@ -0,0 +1,62 @@
+//
+//  hud_fonts.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "hud_fonts.hpp"
+
+#include <imgui.h>
+
+#include "font_atlas_cache.hpp"
+#include "load_profiler.hpp"
+
+using namespace angry;
+
+void ui::load_fonts(
+    ImFontAtlas& atlas,
+    const AssetStorage& asset_storage,
+    const std::filesystem::path& hud_path,
+    const std::filesystem::path& cache_directory,
+    std::vector<uint8_t>& font_data,
+    Context& context
+)
+{
+    font_data = asset_storage.read(hud_path / "Roboto-Medium.ttf");
+
+    // default font first, then the big one
+    const std::vector<float> sizes = {16.0f, 32.0f};
+    ImFontConfig config;
+    config.FontDataOwnedByAtlas = false;
+
+    const auto key = get_font_atlas_key(atlas, font_data, sizes, config, atlas.GetGlyphRangesDefault());
+    const auto cache_path = cache_directory / "hud_fonts.atlas";
+    if (!cache_directory.empty())
+    {
+        LoadProfiler::Scope scope("font_cache_load", cache_path.filename().string());
+        if (load_font_atlas(atlas, cache_path, key) && size_t(atlas.Fonts.Size) == sizes.size())
+        {
+            context.default_font = atlas.Fonts[0];
+            context.big_font = atlas.Fonts[1];
+            return;
+        }
+    }
+
+    const auto font_size = static_cast<int>(font_data.size());
+    context.default_font = atlas.AddFontFromMemoryTTF(font_data.data(), font_size, sizes[0], &config);
+    context.big_font = atlas.AddFontFromMemoryTTF(font_data.data(), font_size, sizes[1], &config);
+
+    {
+        // otherwise the atlas is built when the renderer creates the font texture
+        LoadProfiler::Scope scope("font_raster", "Roboto-Medium.ttf");
+        atlas.Build();
+    }
+
+    if (!cache_directory.empty())
+    {
+        // a cache which can not be written only costs the next launch a rasterization
+        LoadProfiler::Scope scope("font_cache_save", cache_path.filename().string());
+        save_font_atlas(atlas, cache_path, key);
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  hud_fonts.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "asset_storage.hpp"
+#include "screen.hpp"
+
+struct ImFontAtlas;
+
+namespace angry::ui
+{
+
+// Adds HUD fonts to `context` and rasterizes the atlas, `font_data` must outlive the atlas.
+// The atlas is saved to `cache_directory` and mapped from there on later launches, an empty
+// path rasterizes every time.
+void load_fonts(
+    ImFontAtlas& atlas,
+    const AssetStorage& asset_storage,
+    const std::filesystem::path& hud_path,
+    const std::filesystem::path& cache_directory,
+    std::vector<uint8_t>& font_data,
+    Context& context
+);
+
+}
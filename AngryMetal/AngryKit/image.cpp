@@ -7,9 +7,47 @@
 
 #include "image.hpp"
 
+#include <cstdlib>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 
+#include "pixel_conversion.hpp"
+
+namespace
+{
+
+// stb_image allocates through the arena of an image being decoded on this thread
+thread_local angry::StagingArena* decode_arena = nullptr;
+
+void* image_malloc(size_t size)
+{
+    return decode_arena != nullptr ? decode_arena->allocate(size) : std::malloc(size);
+}
+
+void* image_realloc(void* pointer, size_t size)
+{
+    return decode_arena != nullptr ? decode_arena->reallocate(pointer, size) : std::realloc(pointer, size);
+}
+
+void image_free(void* pointer)
+{
+    if (decode_arena != nullptr)
+    {
+        decode_arena->release(pointer);
+    }
+    else
+    {
+        std::free(pointer);
+    }
+}
+
+}
+
+#define STBI_MALLOC(size) image_malloc(size)
+#define STBI_REALLOC(pointer, size) image_realloc(pointer, size)
+#define STBI_FREE(pointer) image_free(pointer)
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
@@ -26,10 +64,155 @@ Image::Image(const std::filesystem::path& file_path)
     }
 }
 
+Image::Image(const uint8_t* file_data, size_t file_size)
+{
+    data = stbi_load_from_memory(file_data, static_cast<int>(file_size), &width, &height, &components, 0);
+    if (data == nullptr)
+    {
+        std::stringstream t;
+        t << "Image() fail to load image from memory, " << stbi_failure_reason();
+        throw std::runtime_error(t.str());
+    }
+}
+
+Image::Image(const uint8_t* file_data, size_t file_size, StagingArena& arena) : _arena(&arena)
+{
+    decode_arena = &arena;
+    data = stbi_load_from_memory(file_data, static_cast<int>(file_size), &width, &height, &components, 0);
+    decode_arena = nullptr;
+
+    if (data == nullptr)
+    {
+        std::stringstream t;
+        t << "Image() fail to load image from memory, " << stbi_failure_reason();
+        throw std::runtime_error(t.str());
+    }
+}
+
 Image::~Image()
 {
-    if (data != nullptr)
+    if (_mip_data != nullptr)
+    {
+        if (_arena != nullptr)
+        {
+            _arena->release(_mip_data);
+        }
+        else
+        {
+            std::free(_mip_data);
+        }
+    }
+
+    if (data == nullptr)
+    {
+        return;
+    }
+
+    if (_arena != nullptr)
+    {
+        _arena->release(data);
+    }
+    else
     {
         stbi_image_free(data);
     }
 }
+
+void Image::convert_to_bgra()
+{
+    if (is_bgra || components == 1)
+    {
+        return;
+    }
+
+    const size_t pixel_count = size_t(width) * size_t(height);
+    switch (components)
+    {
+        case 3:
+        {
+            // expand in place if the buffer can grow, otherwise straight into a new one
+            unsigned char* target = nullptr;
+            if (_arena != nullptr)
+            {
+                target = _arena->try_grow(data, 4 * pixel_count)
+                    ? data
+                    : static_cast<unsigned char*>(_arena->allocate(4 * pixel_count));
+            }
+            else
+            {
+                target = static_cast<unsigned char*>(std::malloc(4 * pixel_count));
+                if (target == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+
+            expand_rgb_to_bgra(data, target, pixel_count);
+            if (_arena == nullptr)
+            {
+                stbi_image_free(data);
+            }
+
+            data = target;
+            components = 4;
+            break;
+        }
+
+        case 4:
+        {
+            swizzle_rgba_to_bgra(data, pixel_count);
+            break;
+        }
+
+        default:
+        {
+            std::stringstream t;
+            t << "Image::convert_to_bgra() unsupported number of components " << components;
+            throw std::runtime_error(t.str());
+        }
+    }
+
+    is_bgra = true;
+}
+
+void Image::generate_mipmaps(MipmapContent content, MipmapFilter filter)
+{
+    if (!mip_levels.empty())
+    {
+        return;
+    }
+
+    if (components != 1 && !is_bgra)
+    {
+        throw std::runtime_error("Image::generate_mipmaps() image is not converted to BGRA");
+    }
+
+    const size_t level_count = get_mip_level_count(width, height);
+    size_t size = 0;
+    for (size_t i = 1; i < level_count; i++)
+    {
+        size += size_t(get_mip_level_size(width, i)) * size_t(get_mip_level_size(height, i)) * size_t(components);
+    }
+    if (size == 0)
+    {
+        return;
+    }
+
+    _mip_data = static_cast<unsigned char*>(_arena != nullptr ? _arena->allocate(size) : std::malloc(size));
+    if (_mip_data == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    ImageLevel source{width, height, data};
+    unsigned char* target = _mip_data;
+    for (size_t i = 1; i < level_count; i++)
+    {
+        ImageLevel level{get_mip_level_size(width, i), get_mip_level_size(height, i), target};
+        downsample(source.data, source.width, source.height, components, content, filter, level.data);
+        mip_levels.push_back(level);
+
+        target += size_t(level.width) * size_t(level.height) * size_t(components);
+        source = level;
+    }
+}
@@ -7,11 +7,24 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <vector>
+
+#include "mipmap.hpp"
+#include "staging_arena.hpp"
 
 namespace angry
 {
 
+struct ImageLevel
+{
+    int width = 0;
+    int height = 0;
+    unsigned char* data = nullptr;
+};
+
 struct Image
 {
     int width = 0;
@@ -19,7 +32,17 @@ struct Image
     int components = 0;
     unsigned char* data = nullptr;
 
+    // channels are in BGRA order after `convert_to_bgra`
+    bool is_bgra = false;
+
+    // levels after the first one, empty until `generate_mipmaps`
+    std::vector<ImageLevel> mip_levels;
+
     explicit Image(const std::filesystem::path& file_path);
+    Image(const uint8_t* file_data, size_t file_size);
+
+    // Decoder memory and pixels come from `arena`, they stay there until the arena is reset.
+    Image(const uint8_t* file_data, size_t file_size, StagingArena& arena);
     ~Image();
 
     Image(const Image&) = delete;
@@ -27,6 +50,15 @@ struct Image
     Image& operator=(const Image&) = delete;
     Image& operator=(Image&&) = delete;
 
+    // RGB and RGBA become BGRA in place, grey stays as is.
+    void convert_to_bgra();
+
+    // Builds the full chain in one allocation, the image has to be grey or converted to BGRA.
+    void generate_mipmaps(MipmapContent content, MipmapFilter filter);
+
+private:
+    StagingArena* _arena = nullptr;
+    unsigned char* _mip_data = nullptr;
 };
 
 }
@@ -11,17 +11,20 @@ using namespace angry;
 
 size_t InstancedMeshManager::create()
 {
-    auto index = _meshes.size();
-    _meshes.emplace_back(std::make_unique<InstancedMesh>());
-    return index;
+    return _meshes.insert(std::make_unique<InstancedMesh>());
+}
+
+void InstancedMeshManager::release(size_t index)
+{
+    _meshes.erase(index);
 }
 
 InstancedMesh& InstancedMeshManager::get_mesh(size_t index)
 {
-    return *_meshes[index];
+    return *_meshes.get(index);
 }
 
 const InstancedMeshManager::MeshArray& InstancedMeshManager::get_all() const
 {
-    return _meshes;
+    return _meshes.get_values();
 }
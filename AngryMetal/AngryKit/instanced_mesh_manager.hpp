@@ -8,10 +8,11 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
+#include "enum_array.hpp"
 #include "mesh.hpp"
+#include "slot_map.hpp"
 
 namespace angry
 {
@@ -22,12 +23,14 @@ enum class InstanceBufferType
     aim_rotation
 };
 
+constexpr size_t instance_buffer_type_count = size_t(InstanceBufferType::aim_rotation) + 1;
+
 struct InstancedMesh
 {
     size_t count = 0;
     size_t max_count = 0;
     Mesh mesh;
-    std::unordered_map<InstanceBufferType, size_t> buffers;
+    EnumTable<InstanceBufferType, size_t, instance_buffer_type_count> buffers;
 };
 
 class InstancedMeshManager final
@@ -37,11 +40,14 @@ public:
 
 public:
     size_t create();
+    // buffers of the mesh are released by whoever created them
+    void release(size_t index);
     InstancedMesh& get_mesh(size_t index);
+    // live meshes in no particular order
     const MeshArray& get_all() const;
 
 private:
-    MeshArray _meshes;
+    SlotMap<std::unique_ptr<InstancedMesh>> _meshes;
 };
 
 };
@@ -0,0 +1,185 @@
+//
+//  load_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "load_benchmark.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+#include <imgui.h>
+
+#include "asset_storage.hpp"
+#include "cpu_buffer_manager.hpp"
+#include "cpu_texture_manager.hpp"
+#include "frame_arena.hpp"
+#include "hud_fonts.hpp"
+#include "instanced_mesh_manager.hpp"
+#include "load_profiler.hpp"
+#include "player_animation_system.hpp"
+#include "resource_manager.hpp"
+#include "scene.hpp"
+#include "world_streaming_system.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+struct RunResult
+{
+    bool is_cache_dropped = false;
+    double seconds = 0.0;
+    std::vector<LoadProfiler::Phase> phases;
+    TextureCache::Statistics texture_cache;
+};
+
+void write_string(std::ostream& output, const std::string& value)
+{
+    output << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            output << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            output << ' ';
+        }
+        else
+        {
+            output << c;
+        }
+    }
+    output << '"';
+}
+
+RunResult run(const LoadBenchmarkSettings& settings)
+{
+    RunResult result;
+    if (settings.is_cold)
+    {
+        result.is_cache_dropped = drop_file_cache(settings.assets_path);
+    }
+
+    LoadProfiler profiler;
+    LoadProfiler::set_current(&profiler);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        AssetStorage asset_storage(settings.assets_path);
+        CpuBufferManager buffer_manager;
+        InstancedMeshManager instanced_mesh_manager;
+        CpuTextureManager texture_manager(asset_storage);
+        ResourceManager resource_manager(buffer_manager, instanced_mesh_manager, texture_manager, asset_storage);
+
+        Scene scene(&resource_manager, WorldStreamingSystem::get_max_chunk_count(WorldStreamingSystem::Settings()));
+        {
+            LoadProfiler::Scope scope("scene_load");
+            scene.load(settings.assets_path);
+        }
+
+        // player meshes get their buffers on the first animation update
+        FrameArena frame_arena(FrameArena::Settings{});
+        PlayerAnimationSystem player_animation_system(buffer_manager, frame_arena);
+        player_animation_system.update(scene, 0.0f);
+
+        ImGui::CreateContext();
+        {
+            LoadProfiler::Scope scope("font_setup");
+            ui::Context context;
+            std::vector<uint8_t> font_data;
+            // no cache directory, every run measures rasterization
+            ui::load_fonts(*ImGui::GetIO().Fonts, asset_storage, settings.assets_path / "HUD", std::filesystem::path(), font_data, context);
+        }
+        ImGui::DestroyContext();
+
+        result.texture_cache = texture_manager.get_cache_statistics();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LoadProfiler::set_current(nullptr);
+
+    result.phases = profiler.get_phases();
+    return result;
+}
+
+}
+
+void angry::run_load_benchmark(const LoadBenchmarkSettings& settings, std::ostream& output)
+{
+    std::vector<RunResult> results;
+    for (size_t i = 0; i < settings.run_count; i++)
+    {
+        results.push_back(run(settings));
+    }
+
+    output << "{\"cold\": " << (settings.is_cold ? "true" : "false")
+        << ", \"allocations_counted\": " << (is_allocation_counting_enabled() ? "true" : "false")
+        << ", \"runs\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto& result = results[i];
+        output << (i == 0 ? "" : ", ")
+            << "{\"cache_dropped\": " << (result.is_cache_dropped ? "true" : "false")
+            << ", \"seconds\": " << result.seconds
+            << ", \"phases\": [";
+        for (size_t k = 0; k < result.phases.size(); k++)
+        {
+            const auto& phase = result.phases[k];
+            output << (k == 0 ? "" : ", ") << "{\"name\": ";
+            write_string(output, phase.name);
+            output << ", \"item\": ";
+            write_string(output, phase.item);
+            output << ", \"seconds\": " << phase.seconds
+                << ", \"allocations\": " << phase.allocations.count
+                << ", \"allocated_bytes\": " << phase.allocations.bytes << "}";
+        }
+
+        const auto& cache = result.texture_cache;
+        output << "], \"texture_cache\": {\"requests\": " << cache.request_count
+            << ", \"path_hits\": " << cache.path_hit_count
+            << ", \"content_hits\": " << cache.content_hit_count
+            << ", \"hit_rate\": " << cache.get_hit_rate()
+            << ", \"saved_bytes\": " << cache.saved_bytes
+            << ", \"textures\": " << cache.texture_count
+            << ", \"texture_bytes\": " << cache.texture_bytes << "}}";
+    }
+    output << "]}\n";
+}
+
+bool angry::drop_file_cache(const std::filesystem::path& directory)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    // only clean pages are dropped, that is all of them for read-only assets
+    bool is_dropped = true;
+    std::error_code error;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (!item.is_regular_file())
+        {
+            continue;
+        }
+
+        const int file = open(item.path().c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            is_dropped = false;
+            continue;
+        }
+        is_dropped = posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0 && is_dropped;
+        close(file);
+    }
+    return is_dropped && !error;
+#else
+    // Apple platforms can only purge the whole cache as root
+    (void)directory;
+    return false;
+#endif
+}
@@ -0,0 +1,32 @@
+//
+//  load_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+
+namespace angry
+{
+
+struct LoadBenchmarkSettings
+{
+    std::filesystem::path assets_path;
+    // page cache of asset files is dropped before every run where the platform allows it
+    bool is_cold = false;
+    size_t run_count = 1;
+};
+
+// Runs Scene::load, the first player mesh upload and HUD font setup against the CPU
+// resource backend and writes per-phase wall time and allocations as JSON.
+void run_load_benchmark(const LoadBenchmarkSettings& settings, std::ostream& output);
+
+// Returns false if the platform gives no way to evict cached file pages.
+bool drop_file_cache(const std::filesystem::path& directory);
+
+}
@@ -0,0 +1,73 @@
+//
+//  load_profiler.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "load_profiler.hpp"
+
+#include <atomic>
+
+using namespace angry;
+
+namespace
+{
+
+std::atomic<LoadProfiler*> current_profiler{nullptr};
+
+}
+
+LoadProfiler::Scope::Scope(const char* name, std::string item)
+    : _profiler(current_profiler.load()), _name(name)
+{
+    if (_profiler == nullptr)
+    {
+        return;
+    }
+
+    _item = std::move(item);
+    _allocations = get_thread_allocation_count();
+    _start = std::chrono::steady_clock::now();
+}
+
+LoadProfiler::Scope::~Scope()
+{
+    if (_profiler == nullptr)
+    {
+        return;
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto allocations = get_thread_allocation_count();
+
+    Phase phase;
+    phase.name = _name;
+    phase.item = std::move(_item);
+    phase.seconds = std::chrono::duration<double>(end - _start).count();
+    phase.allocations.count = allocations.count - _allocations.count;
+    phase.allocations.bytes = allocations.bytes - _allocations.bytes;
+    _profiler->add(std::move(phase));
+}
+
+void LoadProfiler::set_current(LoadProfiler* profiler)
+{
+    current_profiler.store(profiler);
+}
+
+LoadProfiler* LoadProfiler::get_current()
+{
+    return current_profiler.load();
+}
+
+void LoadProfiler::add(Phase phase)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _phases.push_back(std::move(phase));
+}
+
+std::vector<LoadProfiler::Phase> LoadProfiler::get_phases() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _phases;
+}
@@ -0,0 +1,65 @@
+//
+//  load_profiler.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "allocation_counter.hpp"
+
+namespace angry
+{
+
+// Collects wall time and allocations of loading phases, scopes record nothing
+// unless a profiler is installed with set_current().
+class LoadProfiler final
+{
+public:
+    struct Phase
+    {
+        std::string name;
+        std::string item;
+        double seconds = 0.0;
+        AllocationCount allocations;
+    };
+
+    class Scope final
+    {
+    public:
+        explicit Scope(const char* name, std::string item = std::string());
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        LoadProfiler* _profiler;
+        const char* _name;
+        std::string _item;
+        std::chrono::steady_clock::time_point _start;
+        AllocationCount _allocations;
+    };
+
+public:
+    static void set_current(LoadProfiler* profiler);
+    static LoadProfiler* get_current();
+
+    // scopes can finish on worker threads
+    void add(Phase phase);
+    std::vector<Phase> get_phases() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<Phase> _phases;
+};
+
+}
@@ -0,0 +1,219 @@
+//
+//  lz4.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "lz4.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+using namespace angry;
+
+namespace
+{
+
+const size_t min_match = 4;
+// last match must start at least 12 bytes before end of block
+const size_t match_limit = 12;
+// last 5 bytes are always literals
+const size_t last_literals = 5;
+
+const int hash_log = 12;
+
+uint32_t read_u32(const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t get_hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - hash_log);
+}
+
+uint8_t* write_length(uint8_t* p, size_t length)
+{
+    while (length >= 255)
+    {
+        *p++ = 255;
+        length -= 255;
+    }
+    *p++ = static_cast<uint8_t>(length);
+    return p;
+}
+
+uint8_t* write_sequence(uint8_t* p, const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length)
+{
+    uint8_t* token = p++;
+    *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+    if (literal_length >= 15)
+    {
+        p = write_length(p, literal_length - 15);
+    }
+    std::memcpy(p, literals, literal_length);
+    p += literal_length;
+
+    if (match_length == 0)
+    {
+        return p;
+    }
+
+    *p++ = static_cast<uint8_t>(offset & 0xff);
+    *p++ = static_cast<uint8_t>(offset >> 8);
+
+    const size_t length = match_length - min_match;
+    *token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+    if (length >= 15)
+    {
+        p = write_length(p, length - 15);
+    }
+    return p;
+}
+
+size_t read_length(const uint8_t*& p, const uint8_t* end)
+{
+    size_t length = 0;
+    uint8_t value = 255;
+    while (value == 255)
+    {
+        if (p >= end)
+        {
+            throw std::runtime_error("lz4::decompress() truncated length");
+        }
+        value = *p++;
+        length += value;
+    }
+    return length;
+}
+
+}
+
+size_t lz4::get_compress_bound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t lz4::compress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity)
+{
+    if (capacity < get_compress_bound(size))
+    {
+        throw std::runtime_error("lz4::compress() target is too small");
+    }
+
+    uint8_t* p = target;
+    const uint8_t* anchor = source;
+
+    if (size > match_limit)
+    {
+        std::array<uint32_t, 1 << hash_log> table;
+        table.fill(UINT32_MAX);
+
+        const uint8_t* end = source + size;
+        const uint8_t* search_limit = end - match_limit;
+        const uint8_t* match_end_limit = end - last_literals;
+
+        const uint8_t* i = source;
+        while (i < search_limit)
+        {
+            const uint32_t sequence = read_u32(i);
+            const uint32_t hash = get_hash(sequence);
+            const uint32_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(i - source);
+
+            const bool is_match = candidate != UINT32_MAX
+                && (i - source) - candidate <= 0xffff
+                && read_u32(source + candidate) == sequence;
+            if (!is_match)
+            {
+                i++;
+                continue;
+            }
+
+            const uint8_t* match = source + candidate;
+            const uint8_t* match_end = i + min_match;
+            while (match_end < match_end_limit && *match_end == match[match_end - i])
+            {
+                match_end++;
+            }
+
+            p = write_sequence(p, anchor, i - anchor, i - match, match_end - i);
+            i = match_end;
+            anchor = i;
+        }
+    }
+
+    p = write_sequence(p, anchor, source + size - anchor, 0, 0);
+    return p - target;
+}
+
+void lz4::decompress(const uint8_t* source, size_t size, uint8_t* target, size_t target_size)
+{
+    const uint8_t* p = source;
+    const uint8_t* end = source + size;
+    uint8_t* out = target;
+    uint8_t* out_end = target + target_size;
+
+    while (p < end)
+    {
+        const uint8_t token = *p++;
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15)
+        {
+            literal_length += read_length(p, end);
+        }
+        if (literal_length > size_t(end - p) || literal_length > size_t(out_end - out))
+        {
+            throw std::runtime_error("lz4::decompress() literals out of bounds");
+        }
+        std::memcpy(out, p, literal_length);
+        p += literal_length;
+        out += literal_length;
+
+        if (p == end)
+        {
+            break;
+        }
+
+        if (end - p < 2)
+        {
+            throw std::runtime_error("lz4::decompress() truncated offset");
+        }
+        const size_t offset = p[0] | (p[1] << 8);
+        p += 2;
+        if (offset == 0 || offset > size_t(out - target))
+        {
+            throw std::runtime_error("lz4::decompress() invalid offset");
+        }
+
+        size_t match_length = token & 0x0f;
+        if (match_length == 15)
+        {
+            match_length += read_length(p, end);
+        }
+        match_length += min_match;
+        if (match_length > size_t(out_end - out))
+        {
+            throw std::runtime_error("lz4::decompress() match out of bounds");
+        }
+
+        // byte by byte, match can overlap with output
+        const uint8_t* match = out - offset;
+        for (size_t i = 0; i < match_length; i++)
+        {
+            out[i] = match[i];
+        }
+        out += match_length;
+    }
+
+    if (out != out_end)
+    {
+        throw std::runtime_error("lz4::decompress() unexpected size");
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  lz4.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md),
+// blocks are compatible with LZ4_compress_default() and LZ4_decompress_safe().
+namespace angry::lz4
+{
+
+size_t get_compress_bound(size_t size);
+
+// Returns size of compressed block, `capacity` must be at least get_compress_bound(size).
+size_t compress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity);
+
+// Decompresses whole block, `target_size` is exact size of original data.
+void decompress(const uint8_t* source, size_t size, uint8_t* target, size_t target_size);
+
+}
@@ -0,0 +1,233 @@
+//
+//  memory_tracker.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "memory_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+
+using namespace angry;
+
+namespace
+{
+
+std::atomic<MemoryTracker*> current_tracker{nullptr};
+
+const char* get_texture_format_name(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::r8_unorm:
+            return "r8_unorm";
+        case TextureFormat::bgra8_unorm:
+            return "bgra8_unorm";
+        case TextureFormat::bc1:
+            return "bc1";
+        case TextureFormat::bc3:
+            return "bc3";
+        case TextureFormat::bc4:
+            return "bc4";
+        case TextureFormat::bc5:
+            return "bc5";
+        case TextureFormat::astc_4x4:
+            return "astc_4x4";
+    }
+    return "";
+}
+
+void write_usage(std::ostream& output, const char* name, const MemoryTracker::Usage& usage)
+{
+    output << "{\"name\": \"" << name
+        << "\", \"live_bytes\": " << usage.live_bytes
+        << ", \"peak_bytes\": " << usage.peak_bytes
+        << ", \"live_count\": " << usage.live_count << "}";
+}
+
+}
+
+const char* angry::get_memory_category_name(MemoryCategory category)
+{
+    switch (category)
+    {
+        case MemoryCategory::vertex_buffers:
+            return "vertex_buffers";
+        case MemoryCategory::index_buffers:
+            return "index_buffers";
+        case MemoryCategory::instance_buffers:
+            return "instance_buffers";
+        case MemoryCategory::dynamic_buffers:
+            return "dynamic_buffers";
+        case MemoryCategory::slab_free:
+            return "slab_free";
+        case MemoryCategory::frame_ring_free:
+            return "frame_ring_free";
+        case MemoryCategory::texture_base_levels:
+            return "texture_base_levels";
+        case MemoryCategory::texture_mip_levels:
+            return "texture_mip_levels";
+        case MemoryCategory::registry:
+            return "registry";
+        case MemoryCategory::animation:
+            return "animation";
+        case MemoryCategory::importer:
+            return "importer";
+        case MemoryCategory::count:
+            break;
+    }
+    return "";
+}
+
+void MemoryTracker::set_current(MemoryTracker* tracker)
+{
+    current_tracker.store(tracker);
+}
+
+MemoryTracker* MemoryTracker::get_current()
+{
+    return current_tracker.load();
+}
+
+void MemoryTracker::add(MemoryCategory category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    add(_report.categories[category], bytes);
+    add(_report.total, bytes);
+}
+
+void MemoryTracker::remove(MemoryCategory category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    remove(_report.categories[category], bytes);
+    remove(_report.total, bytes);
+}
+
+void MemoryTracker::set(MemoryCategory category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& usage = _report.categories[category];
+    if (usage.live_count > 0)
+    {
+        const size_t live_bytes = usage.live_bytes;
+        remove(usage, live_bytes);
+        remove(_report.total, live_bytes);
+    }
+    add(usage, bytes);
+    add(_report.total, bytes);
+}
+
+void MemoryTracker::add_texture(TextureFormat format, size_t base_bytes, size_t mip_bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    add(_report.categories[MemoryCategory::texture_base_levels], base_bytes);
+    add(_report.categories[MemoryCategory::texture_mip_levels], mip_bytes);
+    add(_report.texture_formats[format], base_bytes + mip_bytes);
+    add(_report.total, base_bytes + mip_bytes);
+}
+
+void MemoryTracker::remove_texture(TextureFormat format, size_t base_bytes, size_t mip_bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    remove(_report.categories[MemoryCategory::texture_base_levels], base_bytes);
+    remove(_report.categories[MemoryCategory::texture_mip_levels], mip_bytes);
+    remove(_report.texture_formats[format], base_bytes + mip_bytes);
+    remove(_report.total, base_bytes + mip_bytes);
+}
+
+MemoryTracker::Report MemoryTracker::get_report() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _report;
+}
+
+void MemoryTracker::write_json(std::ostream& output) const
+{
+    const auto report = get_report();
+
+    output << "{\"total\": ";
+    write_usage(output, "total", report.total);
+    output << ", \"categories\": [";
+    for (size_t i = 0; i < memory_category_count; i++)
+    {
+        const auto category = MemoryCategory(i);
+        output << (i == 0 ? "" : ", ");
+        write_usage(output, get_memory_category_name(category), report.categories[category]);
+    }
+    output << "], \"texture_formats\": [";
+    for (size_t i = 0; i < texture_format_count; i++)
+    {
+        const auto format = TextureFormat(i);
+        output << (i == 0 ? "" : ", ");
+        write_usage(output, get_texture_format_name(format), report.texture_formats[format]);
+    }
+    output << "]}";
+}
+
+void MemoryTracker::write_json(const std::filesystem::path& file_path) const
+{
+    std::ofstream output(file_path);
+    if (!output)
+    {
+        throw std::runtime_error("MemoryTracker::write_json() can't open " + file_path.string());
+    }
+    write_json(output);
+    output << "\n";
+}
+
+void MemoryTracker::add(Usage& usage, size_t bytes)
+{
+    usage.live_bytes += bytes;
+    usage.live_count += 1;
+    usage.peak_bytes = std::max(usage.peak_bytes, usage.live_bytes);
+}
+
+void MemoryTracker::remove(Usage& usage, size_t bytes)
+{
+    usage.live_bytes -= std::min(usage.live_bytes, bytes);
+    usage.live_count -= std::min(usage.live_count, size_t(1));
+}
+
+void angry::track_memory(MemoryCategory category, size_t bytes)
+{
+    if (auto* tracker = MemoryTracker::get_current())
+    {
+        tracker->add(category, bytes);
+    }
+}
+
+void angry::untrack_memory(MemoryCategory category, size_t bytes)
+{
+    if (auto* tracker = MemoryTracker::get_current())
+    {
+        tracker->remove(category, bytes);
+    }
+}
+
+void angry::set_tracked_memory(MemoryCategory category, size_t bytes)
+{
+    if (auto* tracker = MemoryTracker::get_current())
+    {
+        tracker->set(category, bytes);
+    }
+}
+
+void angry::track_texture_memory(TextureFormat format, size_t base_bytes, size_t mip_bytes)
+{
+    if (auto* tracker = MemoryTracker::get_current())
+    {
+        tracker->add_texture(format, base_bytes, mip_bytes);
+    }
+}
+
+void angry::untrack_texture_memory(TextureFormat format, size_t base_bytes, size_t mip_bytes)
+{
+    if (auto* tracker = MemoryTracker::get_current())
+    {
+        tracker->remove_texture(format, base_bytes, mip_bytes);
+    }
+}
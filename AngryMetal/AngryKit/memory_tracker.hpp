@@ -0,0 +1,107 @@
+//
+//  memory_tracker.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+
+#include "enum_array.hpp"
+#include "texture_file.hpp"
+
+namespace angry
+{
+
+enum class MemoryCategory
+{
+    vertex_buffers,
+    index_buffers,
+    instance_buffers,
+    // rewritten every frame, counted once per frame in flight
+    dynamic_buffers,
+    // slab memory no buffer holds: free blocks, the rest of class slabs and allocation padding
+    slab_free,
+    // regions of the preallocated frame ring no dynamic buffer uses
+    frame_ring_free,
+    texture_base_levels,
+    // with the padding of the allocation
+    texture_mip_levels,
+    registry,
+    animation,
+    // scene data assimp keeps after import, animations aside
+    importer,
+    count
+};
+
+constexpr size_t memory_category_count = size_t(MemoryCategory::count);
+constexpr size_t texture_format_count = size_t(TextureFormat::astc_4x4) + 1;
+
+const char* get_memory_category_name(MemoryCategory category);
+
+// Live and peak bytes per category and texture format. Buffer and texture managers report
+// every change, CPU structures are sampled by their owners. Nothing is recorded unless a
+// tracker is installed with set_current().
+class MemoryTracker final
+{
+public:
+    struct Usage
+    {
+        size_t live_bytes = 0;
+        size_t peak_bytes = 0;
+        size_t live_count = 0;
+    };
+
+    struct Report
+    {
+        EnumArray<MemoryCategory, Usage, memory_category_count> categories;
+        EnumArray<TextureFormat, Usage, texture_format_count> texture_formats;
+        // peak of the sum, not the sum of peaks
+        Usage total;
+    };
+
+public:
+    MemoryTracker() = default;
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker(MemoryTracker&&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(MemoryTracker&&) = delete;
+
+    static void set_current(MemoryTracker* tracker);
+    static MemoryTracker* get_current();
+
+    void add(MemoryCategory category, size_t bytes);
+    void remove(MemoryCategory category, size_t bytes);
+    // for sampled categories, replaces what was there
+    void set(MemoryCategory category, size_t bytes);
+
+    void add_texture(TextureFormat format, size_t base_bytes, size_t mip_bytes);
+    void remove_texture(TextureFormat format, size_t base_bytes, size_t mip_bytes);
+
+    Report get_report() const;
+    void write_json(std::ostream& output) const;
+    void write_json(const std::filesystem::path& file_path) const;
+
+private:
+    static void add(Usage& usage, size_t bytes);
+    static void remove(Usage& usage, size_t bytes);
+
+private:
+    mutable std::mutex _mutex;
+    Report _report;
+};
+
+// report to the current tracker, nothing happens without one
+void track_memory(MemoryCategory category, size_t bytes);
+void untrack_memory(MemoryCategory category, size_t bytes);
+void set_tracked_memory(MemoryCategory category, size_t bytes);
+void track_texture_memory(TextureFormat format, size_t base_bytes, size_t mip_bytes);
+void untrack_texture_memory(TextureFormat format, size_t base_bytes, size_t mip_bytes);
+
+}
@@ -7,8 +7,11 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <simd/simd.h>
 
+#include <cstddef>
+
+#include "enum_array.hpp"
 #include "render_pass_type.h"
 
 namespace angry
@@ -19,9 +22,14 @@ enum class MaterialTexture
     diffuse, normal, specular, shadow
 };
 
+constexpr size_t material_texture_count = size_t(MaterialTexture::shadow) + 1;
+
 struct Material
 {
-    std::unordered_map<MaterialTexture, size_t> textures;
+    EnumTable<MaterialTexture, size_t, material_texture_count> textures;
+
+    // maps mesh texture coordinates into an atlas region
+    simd_float4 uv_transform = {1.0f, 1.0f, 0.0f, 0.0f};
 };
 
 enum class VertexAttribute
@@ -29,9 +37,12 @@ enum class VertexAttribute
     position, normal, uv
 };
 
+constexpr size_t vertex_attribute_count = size_t(VertexAttribute::uv) + 1;
+
+// read for every draw, tables are indexed by the enum and never hashed
 struct Mesh
 {
-    std::unordered_map<VertexAttribute, size_t> vertex_buffer;
+    EnumTable<VertexAttribute, size_t, vertex_attribute_count> vertex_buffer;
     size_t vertex_count = 0;
 
     size_t index_buffer = 0;
@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <optional>
+
 #include "mesh.hpp"
+#include "shadow_proxy.hpp"
 
 namespace angry
 {
@@ -17,6 +20,9 @@ struct MeshComponent
     class aiMesh* source_mesh = nullptr;
     Mesh mesh;
     bool has_shadow = false;
+    // grid resolution of the simplified depth-only mesh, zero renders shadow with the full mesh
+    unsigned int shadow_proxy_resolution = 0;
+    std::optional<ShadowProxy> shadow_proxy;
     bool is_visible = false;
 };
 
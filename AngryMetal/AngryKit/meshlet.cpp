@@ -0,0 +1,231 @@
+//
+//  meshlet.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "meshlet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace angry;
+
+namespace
+{
+
+simd_float3 get_position(const float* positions, uint32_t index)
+{
+    return simd_float3{positions[3 * index], positions[3 * index + 1], positions[3 * index + 2]};
+}
+
+void compute_bounds(Meshlet& meshlet, const float* positions, const uint32_t* indices)
+{
+    const auto* first = indices + meshlet.index_offset;
+    const auto* last = first + meshlet.index_count;
+
+    simd_float3 min_point = get_position(positions, *first);
+    simd_float3 max_point = min_point;
+    for (auto* i = first; i != last; i++)
+    {
+        const auto p = get_position(positions, *i);
+        min_point = simd_min(min_point, p);
+        max_point = simd_max(max_point, p);
+    }
+
+    meshlet.center = (min_point + max_point) * 0.5f;
+    meshlet.radius = 0.0f;
+    for (auto* i = first; i != last; i++)
+    {
+        meshlet.radius = std::max(meshlet.radius, simd_distance(meshlet.center, get_position(positions, *i)));
+    }
+
+    simd_float3 normal_sum{0.0f, 0.0f, 0.0f};
+    std::array<simd_float3, 3> triangle;
+    for (auto* i = first; i + 2 < last; i += 3)
+    {
+        triangle = {get_position(positions, i[0]), get_position(positions, i[1]), get_position(positions, i[2])};
+        const auto n = simd_cross(triangle[1] - triangle[0], triangle[2] - triangle[0]);
+        const float length = simd_length(n);
+        if (length > 0.0f)
+        {
+            normal_sum += n / length;
+        }
+    }
+
+    const float normal_length = simd_length(normal_sum);
+    if (normal_length == 0.0f)
+    {
+        meshlet.cone_axis = simd_float3{0.0f, 1.0f, 0.0f};
+        meshlet.cone_cutoff = 1.0f;
+        return;
+    }
+    meshlet.cone_axis = normal_sum / normal_length;
+
+    float min_dot = 1.0f;
+    for (auto* i = first; i + 2 < last; i += 3)
+    {
+        triangle = {get_position(positions, i[0]), get_position(positions, i[1]), get_position(positions, i[2])};
+        const auto n = simd_cross(triangle[1] - triangle[0], triangle[2] - triangle[0]);
+        const float length = simd_length(n);
+        if (length > 0.0f)
+        {
+            min_dot = std::min(min_dot, simd_dot(n / length, meshlet.cone_axis));
+        }
+    }
+
+    // wide cones reject nothing, skip them during culling
+    meshlet.cone_cutoff = min_dot <= 0.1f ? 1.0f : std::sqrt(1.0f - min_dot * min_dot);
+}
+
+std::array<simd_float4, 6> get_frustum_planes(simd_float4x4 m)
+{
+    const auto t = simd_transpose(m);
+    std::array<simd_float4, 6> planes = {
+        t.columns[3] + t.columns[0],
+        t.columns[3] - t.columns[0],
+        t.columns[3] + t.columns[1],
+        t.columns[3] - t.columns[1],
+        t.columns[2],
+        t.columns[3] - t.columns[2]
+    };
+
+    for (auto& plane : planes)
+    {
+        plane /= simd_length(plane.xyz);
+    }
+    return planes;
+}
+
+}
+
+std::vector<Meshlet> angry::build_meshlets(
+    const float* positions,
+    size_t vertex_count,
+    const uint32_t* indices,
+    size_t index_count,
+    size_t max_vertices,
+    size_t max_triangles
+)
+{
+    std::vector<Meshlet> result;
+
+    // meshlet number (plus one) which last used a vertex
+    std::vector<uint32_t> vertex_stamp(vertex_count, 0);
+    uint32_t stamp = 1;
+
+    Meshlet current;
+    size_t current_vertices = 0;
+    for (size_t i = 0; i + 2 < index_count; i += 3)
+    {
+        size_t new_vertices = 0;
+        for (size_t k = 0; k < 3; k++)
+        {
+            new_vertices += vertex_stamp[indices[i + k]] != stamp ? 1 : 0;
+        }
+
+        const bool is_full = current_vertices + new_vertices > max_vertices
+            || current.index_count / 3 + 1 > max_triangles;
+        if (is_full && current.index_count > 0)
+        {
+            result.push_back(current);
+
+            current = Meshlet();
+            current.index_offset = static_cast<uint32_t>(i);
+            current_vertices = 0;
+            stamp += 1;
+        }
+
+        for (size_t k = 0; k < 3; k++)
+        {
+            auto& s = vertex_stamp[indices[i + k]];
+            if (s != stamp)
+            {
+                s = stamp;
+                current_vertices += 1;
+            }
+        }
+        current.index_count += 3;
+    }
+
+    if (current.index_count > 0)
+    {
+        result.push_back(current);
+    }
+
+    for (auto& meshlet : result)
+    {
+        compute_bounds(meshlet, positions, indices);
+    }
+
+    return result;
+}
+
+void MeshletCuller::cull(
+    const std::vector<Meshlet>& meshlets,
+    simd_float4x4 model_matrix,
+    simd_float4x4 projection_view_matrix,
+    simd_float3 camera_position,
+    std::vector<IndexRange>& ranges
+)
+{
+    ranges.clear();
+
+    const auto planes = get_frustum_planes(projection_view_matrix);
+    const float scale = std::max({
+        simd_length(model_matrix.columns[0].xyz),
+        simd_length(model_matrix.columns[1].xyz),
+        simd_length(model_matrix.columns[2].xyz)
+    });
+
+    for (const auto& meshlet : meshlets)
+    {
+        _statistics.meshlets_tested += 1;
+
+        const auto center = simd_mul(model_matrix, simd_make_float4(meshlet.center, 1.0f)).xyz;
+        const float radius = meshlet.radius * scale;
+
+        const bool is_outside = std::any_of(planes.cbegin(), planes.cend(), [&](const auto& plane) {
+            return simd_dot(plane.xyz, center) + plane.w < -radius;
+        });
+        if (is_outside)
+        {
+            _statistics.meshlets_culled += 1;
+            _statistics.frustum_culled += 1;
+            continue;
+        }
+
+        if (meshlet.cone_cutoff < 1.0f)
+        {
+            const auto axis = simd_normalize(simd_mul(model_matrix, simd_make_float4(meshlet.cone_axis, 0.0f)).xyz);
+            const auto view = center - camera_position;
+            if (simd_dot(view, axis) >= meshlet.cone_cutoff * simd_length(view) + radius)
+            {
+                _statistics.meshlets_culled += 1;
+                _statistics.backface_culled += 1;
+                continue;
+            }
+        }
+
+        if (!ranges.empty() && ranges.back().offset + ranges.back().count == meshlet.index_offset)
+        {
+            ranges.back().count += meshlet.index_count;
+        }
+        else
+        {
+            ranges.push_back(IndexRange{meshlet.index_offset, meshlet.index_count});
+        }
+    }
+}
+
+const MeshletCuller::Statistics& MeshletCuller::get_statistics() const
+{
+    return _statistics;
+}
+
+void MeshletCuller::reset_statistics()
+{
+    _statistics = Statistics();
+}
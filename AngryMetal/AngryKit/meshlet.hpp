@@ -0,0 +1,77 @@
+//
+//  meshlet.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <simd/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace angry
+{
+
+// Cluster of consecutive triangles of an index buffer.
+struct Meshlet
+{
+    uint32_t index_offset = 0;
+    uint32_t index_count = 0;
+
+    simd_float3 center;
+    float radius = 0.0f;
+
+    // all triangles face away from a viewer inside the cone, cutoff is 1 for an empty cone
+    simd_float3 cone_axis;
+    float cone_cutoff = 1.0f;
+};
+
+struct IndexRange
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+// Splits triangle list into meshlets without reordering indices.
+std::vector<Meshlet> build_meshlets(
+    const float* positions,
+    size_t vertex_count,
+    const uint32_t* indices,
+    size_t index_count,
+    size_t max_vertices = 64,
+    size_t max_triangles = 124
+);
+
+class MeshletCuller final
+{
+public:
+    struct Statistics
+    {
+        size_t meshlets_tested = 0;
+        size_t meshlets_culled = 0;
+        size_t backface_culled = 0;
+        size_t frustum_culled = 0;
+    };
+
+public:
+    // Replaces content of `ranges` with index ranges of visible meshlets, adjacent ranges are merged.
+    void cull(
+        const std::vector<Meshlet>& meshlets,
+        simd_float4x4 model_matrix,
+        simd_float4x4 projection_view_matrix,
+        simd_float3 camera_position,
+        std::vector<IndexRange>& ranges
+    );
+
+    const Statistics& get_statistics() const;
+    void reset_statistics();
+
+private:
+    Statistics _statistics;
+};
+
+}
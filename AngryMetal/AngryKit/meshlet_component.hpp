@@ -0,0 +1,25 @@
+//
+//  meshlet_component.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "meshlet.hpp"
+
+namespace angry
+{
+
+// Opt-in per mesh cluster culling, bounds are built from load time positions
+// so the component suits large static meshes only.
+struct MeshletComponent
+{
+    std::vector<Meshlet> meshlets;
+    std::vector<IndexRange> visible_ranges;
+};
+
+}
@@ -0,0 +1,128 @@
+//
+//  meshlet_culling_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "meshlet_culling_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "math.hpp"
+#include "matrix.hpp"
+#include "meshlet.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+struct Geometry
+{
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+};
+
+Geometry make_sphere(const MeshletCullingBenchmarkSettings& settings)
+{
+    Geometry result;
+    const size_t row = settings.longitude_count + 1;
+    for (size_t i = 0; i <= settings.latitude_count; i++)
+    {
+        const float theta = float(M_PI) * float(i) / float(settings.latitude_count);
+        for (size_t j = 0; j <= settings.longitude_count; j++)
+        {
+            const float phi = 2.0f * float(M_PI) * float(j) / float(settings.longitude_count);
+            result.positions.push_back(settings.radius * std::sin(theta) * std::cos(phi));
+            result.positions.push_back(settings.radius * std::cos(theta));
+            result.positions.push_back(settings.radius * std::sin(theta) * std::sin(phi));
+        }
+    }
+
+    // front faces look outwards, triangles at the poles are degenerate
+    for (size_t i = 0; i < settings.latitude_count; i++)
+    {
+        for (size_t j = 0; j < settings.longitude_count; j++)
+        {
+            const auto a = uint32_t(i * row + j);
+            const auto b = uint32_t(i * row + j + 1);
+            const auto c = uint32_t((i + 1) * row + j);
+            const auto d = uint32_t((i + 1) * row + j + 1);
+            result.indices.insert(result.indices.end(), {a, b, c, b, d, c});
+        }
+    }
+    return result;
+}
+
+}
+
+void angry::run_meshlet_culling_benchmark(const MeshletCullingBenchmarkSettings& settings, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto geometry = make_sphere(settings);
+    const size_t vertex_count = geometry.positions.size() / 3;
+
+    const auto build_start = Clock::now();
+    const auto meshlets = build_meshlets(geometry.positions.data(), vertex_count, geometry.indices.data(),
+                                         geometry.indices.size());
+    const double build_seconds = std::chrono::duration<double>(Clock::now() - build_start).count();
+
+    const auto projection_matrix = matrix::make_perspective_projection(settings.fov_y * math::radians, settings.aspect,
+                                                                       0.1f, 100.0f);
+    const auto model_matrix = matrix_identity_float4x4;
+
+    MeshletCuller culler;
+    std::vector<IndexRange> ranges;
+    ranges.reserve(meshlets.size());
+
+    double cull_seconds = 0.0;
+    double max_cull_seconds = 0.0;
+    size_t drawn_indices = 0;
+    size_t range_count = 0;
+    for (size_t frame = 0; frame < settings.frame_count; frame++)
+    {
+        // a turn every ten seconds, in and out every four
+        const float angle = 2.0f * float(M_PI) * float(frame) / 600.0f;
+        const float blend = 0.5f - 0.5f * std::cos(2.0f * float(M_PI) * float(frame) / 240.0f);
+        const float distance = settings.near_distance + (settings.far_distance - settings.near_distance) * blend;
+        const simd_float3 camera_position = {distance * std::cos(angle), 0.3f * distance, distance * std::sin(angle)};
+        const auto view_matrix = matrix::make_look_at(camera_position, simd_float3{0.0f, 0.0f, 0.0f},
+                                                      simd_float3{0.0f, 1.0f, 0.0f});
+        const auto projection_view_matrix = simd_mul(projection_matrix, view_matrix);
+
+        const auto cull_start = Clock::now();
+        culler.cull(meshlets, model_matrix, projection_view_matrix, camera_position, ranges);
+        const double seconds = std::chrono::duration<double>(Clock::now() - cull_start).count();
+        cull_seconds += seconds;
+        max_cull_seconds = std::max(max_cull_seconds, seconds);
+
+        range_count += ranges.size();
+        for (const auto& range : ranges)
+        {
+            drawn_indices += range.count;
+        }
+    }
+
+    const double frame_count = double(std::max(settings.frame_count, size_t(1)));
+    const auto& statistics = culler.get_statistics();
+    output << "{\"vertices\": " << vertex_count
+        << ", \"triangles\": " << geometry.indices.size() / 3
+        << ", \"meshlets\": " << meshlets.size()
+        << ", \"build_ms\": " << build_seconds * 1000.0
+        << ", \"frame_count\": " << settings.frame_count
+        << ", \"cull_us_mean\": " << cull_seconds * 1e6 / frame_count
+        << ", \"cull_us_max\": " << max_cull_seconds * 1e6
+        << ", \"tested\": " << statistics.meshlets_tested
+        << ", \"culled\": " << statistics.meshlets_culled
+        << ", \"frustum_culled\": " << statistics.frustum_culled
+        << ", \"backface_culled\": " << statistics.backface_culled
+        << ", \"ranges_mean\": " << double(range_count) / frame_count
+        << ", \"drawn_indices\": " << double(drawn_indices) / (frame_count * double(geometry.indices.size()))
+        << "}\n";
+}
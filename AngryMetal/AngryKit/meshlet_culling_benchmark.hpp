@@ -0,0 +1,36 @@
+//
+//  meshlet_culling_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+namespace angry
+{
+
+struct MeshletCullingBenchmarkSettings
+{
+    // static sphere, 2 * latitude_count * longitude_count triangles
+    size_t latitude_count = 256;
+    size_t longitude_count = 512;
+    float radius = 10.0f;
+
+    size_t frame_count = 600;
+    // the camera circles the sphere and moves between these distances from its center
+    float near_distance = 12.0f;
+    float far_distance = 40.0f;
+    float fov_y = 45.0f;
+    float aspect = 16.0f / 9.0f;
+};
+
+// Builds meshlets of a large static mesh once and culls them every frame against a camera
+// which circles it, the way the renderer does for meshes with a MeshletComponent. Writes build
+// and cull time, tested and culled meshlets and the part of the indices left to draw as JSON.
+void run_meshlet_culling_benchmark(const MeshletCullingBenchmarkSettings& settings, std::ostream& output);
+
+}
@@ -0,0 +1,396 @@
+//
+//  mipmap.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "mipmap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace angry;
+
+namespace
+{
+
+struct FilterKernel
+{
+    // first tap relative to 2 * x
+    int offset = 0;
+    size_t size = 0;
+    std::array<float, 4> weights = {};
+};
+
+float get_bessel_i0(float x)
+{
+    float result = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 16; k++)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        result += term;
+    }
+    return result;
+}
+
+FilterKernel make_kaiser_kernel()
+{
+    // windowed sinc for 2:1 reduction, taps are 0.5 and 1.5 texels from the center
+    const float width = 3.0f;
+    const float alpha = 4.0f;
+
+    FilterKernel kernel;
+    kernel.offset = -1;
+    kernel.size = 4;
+
+    float sum = 0.0f;
+    for (size_t i = 0; i < kernel.size; i++)
+    {
+        const float x = std::abs(float(i) - 1.5f);
+        const float t = 0.5f * float(M_PI) * x;
+        const float sinc = std::sin(t) / t;
+        const float r = x / width;
+        const float window = get_bessel_i0(alpha * std::sqrt(1.0f - r * r)) / get_bessel_i0(alpha);
+        kernel.weights[i] = sinc * window;
+        sum += kernel.weights[i];
+    }
+
+    for (auto& weight : kernel.weights)
+    {
+        weight /= sum;
+    }
+    return kernel;
+}
+
+const FilterKernel& get_kernel(MipmapFilter filter)
+{
+    static const FilterKernel box = {0, 2, {0.5f, 0.5f, 0.0f, 0.0f}};
+    static const FilterKernel kaiser = make_kaiser_kernel();
+    return filter == MipmapFilter::box ? box : kaiser;
+}
+
+float srgb_to_linear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linear_to_srgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+// 8-bit value to float for each kind of channel
+struct DecodeTables
+{
+    std::array<float, 256> srgb;
+    std::array<float, 256> linear;
+    std::array<float, 256> normal;
+};
+
+const DecodeTables& get_decode_tables()
+{
+    static const DecodeTables tables = [] {
+        DecodeTables t;
+        for (size_t i = 0; i < 256; i++)
+        {
+            const float value = float(i) / 255.0f;
+            t.srgb[i] = srgb_to_linear(value);
+            t.linear[i] = value;
+            t.normal[i] = 2.0f * value - 1.0f;
+        }
+        return t;
+    }();
+    return tables;
+}
+
+// linear to sRGB at 12-bit precision, enough for 8-bit output
+const size_t encode_table_size = 4096;
+
+const std::array<uint8_t, encode_table_size>& get_srgb_encode_table()
+{
+    static const std::array<uint8_t, encode_table_size> table = [] {
+        std::array<uint8_t, encode_table_size> t;
+        for (size_t i = 0; i < encode_table_size; i++)
+        {
+            const float value = linear_to_srgb(float(i) / float(encode_table_size - 1));
+            t[i] = uint8_t(std::lround(255.0f * value));
+        }
+        return t;
+    }();
+    return table;
+}
+
+int wrap(int value, int size)
+{
+    const int result = value % size;
+    return result < 0 ? result + size : result;
+}
+
+// component and tap counts are template parameters so the per pixel loops are unrolled
+template<size_t N, size_t Taps>
+class Downsampler final
+{
+public:
+    Downsampler(const uint8_t* source, int width, int height, MipmapContent content, MipmapFilter filter)
+        : _source(source)
+        , _width(width)
+        , _height(height)
+        , _content(content)
+        , _offset(get_kernel(filter).offset)
+        , _target_width(std::max(1, width / 2))
+    {
+        const auto& kernel = get_kernel(filter);
+        std::copy(kernel.weights.cbegin(), kernel.weights.cbegin() + Taps, _weights.begin());
+
+        const auto& tables = get_decode_tables();
+        for (size_t c = 0; c < N; c++)
+        {
+            // alpha stays linear
+            const bool is_alpha = N == 4 && c == 3;
+            _is_srgb[c] = content == MipmapContent::color && !is_alpha;
+            if (_is_srgb[c])
+            {
+                _decode[c] = &tables.srgb;
+            }
+            else if (content == MipmapContent::normal && !is_alpha)
+            {
+                _decode[c] = &tables.normal;
+            }
+            else
+            {
+                _decode[c] = &tables.linear;
+            }
+        }
+
+        // taps of the first and the last pixels can wrap around
+        const int last_tap = width - _offset - int(Taps);
+        _first_inside = std::min(_target_width, (1 - _offset) / 2);
+        _last_inside = last_tap < 0 ? _first_inside : std::clamp(last_tap / 2 + 1, _first_inside, _target_width);
+
+        const size_t row_size = size_t(_target_width) * N;
+        for (auto& row : _rows)
+        {
+            row.values.resize(row_size);
+        }
+        _result.resize(row_size);
+    }
+
+    void run(uint8_t* target)
+    {
+        const int target_height = std::max(1, _height / 2);
+        const size_t row_size = _result.size();
+        for (int y = 0; y < target_height; y++)
+        {
+            std::fill(_result.begin(), _result.end(), 0.0f);
+            std::array<const float*, Taps> rows;
+            for (size_t k = 0; k < Taps; k++)
+            {
+                rows[k] = get_row(2 * y + _offset + int(k));
+            }
+
+            for (size_t k = 0; k < Taps; k++)
+            {
+                const float weight = _weights[k];
+                const float* row = rows[k];
+
+                // contiguous loop, vectorized by the compiler
+                for (size_t i = 0; i < row_size; i++)
+                {
+                    _result[i] += weight * row[i];
+                }
+            }
+
+            encode(target + size_t(y) * row_size);
+        }
+    }
+
+private:
+    struct Row
+    {
+        // unwrapped source row index
+        int index = -1000;
+        std::vector<float> values;
+    };
+
+    // horizontally filtered source row, neighbor output rows share two of them
+    const float* get_row(int index)
+    {
+        auto& row = _rows[size_t(wrap(index, int(_rows.size())))];
+        if (row.index == index)
+        {
+            return row.values.data();
+        }
+
+        const uint8_t* source = _source + size_t(wrap(index, _height)) * size_t(_width) * N;
+        std::array<const float*, N> tables;
+        for (size_t c = 0; c < N; c++)
+        {
+            tables[c] = _decode[c]->data();
+        }
+
+        float* values = row.values.data();
+        filter_row<true>(source, tables, 0, _first_inside, values);
+        filter_row<false>(source, tables, _first_inside, _last_inside, values);
+        filter_row<true>(source, tables, _last_inside, _target_width, values);
+
+        row.index = index;
+        return row.values.data();
+    }
+
+    template<bool is_wrapped>
+    void filter_row(const uint8_t* source, const std::array<const float*, N>& tables, int begin, int end, float* values) const
+    {
+        const auto weights = _weights;
+        for (int x = begin; x < end; x++)
+        {
+            const int first = 2 * x + _offset;
+
+            std::array<float, N> sum = {};
+            for (size_t k = 0; k < Taps; k++)
+            {
+                const int sx = is_wrapped ? wrap(first + int(k), _width) : first + int(k);
+                const uint8_t* p = source + size_t(sx) * N;
+                for (size_t c = 0; c < N; c++)
+                {
+                    sum[c] += weights[k] * tables[c][p[c]];
+                }
+            }
+            std::copy(sum.cbegin(), sum.cend(), values + size_t(x) * N);
+        }
+    }
+
+    void encode(uint8_t* target)
+    {
+        if (_content == MipmapContent::normal && N == 4)
+        {
+            for (size_t i = 0; i < _result.size(); i += N)
+            {
+                float* p = _result.data() + i;
+                const float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+                const float scale = length > 0.0f ? 0.5f / length : 0.0f;
+                for (size_t c = 0; c < 3; c++)
+                {
+                    p[c] = p[c] * scale + 0.5f;
+                }
+            }
+        }
+
+        const auto& srgb = get_srgb_encode_table();
+        const int last = int(encode_table_size) - 1;
+        for (size_t i = 0; i < _result.size(); i += N)
+        {
+            for (size_t c = 0; c < N; c++)
+            {
+                const float value = std::min(std::max(_result[i + c], 0.0f), 1.0f);
+                if (_is_srgb[c])
+                {
+                    target[i + c] = srgb[int(value * float(last) + 0.5f)];
+                }
+                else
+                {
+                    target[i + c] = uint8_t(value * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+
+private:
+    const uint8_t* _source;
+    int _width;
+    int _height;
+    MipmapContent _content;
+    int _offset;
+    std::array<float, Taps> _weights;
+    int _target_width;
+    int _first_inside = 0;
+    int _last_inside = 0;
+
+    std::array<const std::array<float, 256>*, N> _decode = {};
+    std::array<bool, N> _is_srgb = {};
+    std::array<Row, 4> _rows;
+    std::vector<float> _result;
+};
+
+}
+
+MipmapContent angry::get_mipmap_content(const std::filesystem::path& file_path)
+{
+    const auto stem = file_path.stem().string();
+    if (stem.size() > 2 && stem.compare(stem.size() - 2, 2, "_N") == 0)
+    {
+        return MipmapContent::normal;
+    }
+    if (stem.size() > 2 && stem.compare(stem.size() - 2, 2, "_D") == 0)
+    {
+        return MipmapContent::color;
+    }
+    return MipmapContent::linear;
+}
+
+size_t angry::get_mip_level_count(int width, int height)
+{
+    size_t result = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2)
+    {
+        result += 1;
+    }
+    return result;
+}
+
+int angry::get_mip_level_size(int size, size_t level)
+{
+    return std::max(1, size >> level);
+}
+
+void angry::downsample(
+    const uint8_t* source,
+    int width,
+    int height,
+    int components,
+    MipmapContent content,
+    MipmapFilter filter,
+    uint8_t* target
+)
+{
+    switch (components)
+    {
+        case 1:
+        {
+            if (filter == MipmapFilter::box)
+            {
+                Downsampler<1, 2>(source, width, height, content, filter).run(target);
+            }
+            else
+            {
+                Downsampler<1, 4>(source, width, height, content, filter).run(target);
+            }
+            break;
+        }
+
+        case 4:
+        {
+            if (filter == MipmapFilter::box)
+            {
+                Downsampler<4, 2>(source, width, height, content, filter).run(target);
+            }
+            else
+            {
+                Downsampler<4, 4>(source, width, height, content, filter).run(target);
+            }
+            break;
+        }
+
+        default:
+        {
+            std::stringstream t;
+            t << "downsample() unsupported number of components " << components;
+            throw std::runtime_error(t.str());
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+//  mipmap.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace angry
+{
+
+enum class MipmapContent
+{
+    // sRGB encoded, filtered in linear space, alpha is linear
+    color,
+    linear,
+    // unit vector in the first three components, renormalized per level
+    normal
+};
+
+enum class MipmapFilter
+{
+    box, kaiser
+};
+
+// Follows asset naming: `_D` is color, `_N` is a normal map, everything else is linear data.
+MipmapContent get_mipmap_content(const std::filesystem::path& file_path);
+
+// Full chain down to 1x1, like Metal creates for a mipmapped texture.
+size_t get_mip_level_count(int width, int height);
+int get_mip_level_size(int size, size_t level);
+
+// Writes the next level of `source` to `target`, pixels have 1 or 4 8-bit components.
+// Edges wrap around like the repeat address mode.
+void downsample(
+    const uint8_t* source,
+    int width,
+    int height,
+    int components,
+    MipmapContent content,
+    MipmapFilter filter,
+    uint8_t* target
+);
+
+}
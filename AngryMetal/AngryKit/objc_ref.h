@@ -40,8 +40,9 @@ public:
 
     Ref<T>& operator=(const Ref<T>& value)
     {
+        [value._object retain];
+        [_object release];
         _object = value._object;
-        [_object retain];
         return *this;
     }
 
@@ -0,0 +1,296 @@
+//
+//  pack_file.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "pack_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "lz4.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+const uint64_t data_alignment = 16;
+
+bool compare_hash(const PackEntry& entry, uint64_t hash)
+{
+    return entry.path_hash < hash;
+}
+
+}
+
+uint64_t angry::get_pack_path_hash(std::string_view path)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void PackWriter::add(std::string_view path, const uint8_t* data, size_t size, PackCodec codec)
+{
+    Item item;
+    item.entry.path_hash = get_pack_path_hash(path);
+    item.entry.size = size;
+
+    const bool is_duplicate = std::any_of(_items.cbegin(), _items.cend(), [&](const auto& e) {
+        return e.entry.path_hash == item.entry.path_hash;
+    });
+    if (is_duplicate)
+    {
+        std::stringstream t;
+        t << "PackWriter::add() duplicate path hash for " << path;
+        throw std::runtime_error(t.str());
+    }
+
+    if (codec == PackCodec::lz4)
+    {
+        item.data.resize(lz4::get_compress_bound(size));
+        item.data.resize(lz4::compress(data, size, item.data.data(), item.data.size()));
+        if (item.data.size() >= size)
+        {
+            codec = PackCodec::none;
+        }
+    }
+
+    if (codec == PackCodec::none)
+    {
+        item.data.assign(data, data + size);
+    }
+
+    item.entry.codec = codec;
+    item.entry.stored_size = item.data.size();
+    _items.push_back(std::move(item));
+}
+
+void PackWriter::write(const std::filesystem::path& file_path) const
+{
+    std::ofstream stream(file_path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        std::stringstream t;
+        t << "PackWriter::write() fail to open " << file_path;
+        throw std::runtime_error(t.str());
+    }
+
+    PackHeader header;
+    header.entry_count = static_cast<uint32_t>(_items.size());
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<PackEntry> entries;
+    entries.reserve(_items.size());
+
+    uint64_t offset = sizeof(header);
+    const char padding[data_alignment] = {};
+    for (const auto& item : _items)
+    {
+        const uint64_t aligned_offset = (offset + data_alignment - 1) / data_alignment * data_alignment;
+        stream.write(padding, aligned_offset - offset);
+        stream.write(reinterpret_cast<const char*>(item.data.data()), item.data.size());
+
+        PackEntry entry = item.entry;
+        entry.offset = aligned_offset;
+        entries.push_back(entry);
+
+        offset = aligned_offset + item.data.size();
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.path_hash < b.path_hash;
+    });
+    stream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(PackEntry));
+
+    header.index_offset = offset;
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!stream)
+    {
+        std::stringstream t;
+        t << "PackWriter::write() fail to write " << file_path;
+        throw std::runtime_error(t.str());
+    }
+}
+
+void angry::write_pack(const std::filesystem::path& directory, const std::filesystem::path& file_path)
+{
+    PackWriter writer;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (!item.is_regular_file() || item.path() == file_path)
+        {
+            continue;
+        }
+
+        std::ifstream stream(item.path(), std::ios::binary);
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+        const auto path = item.path().lexically_relative(directory).generic_string();
+        writer.add(path, data.data(), data.size());
+    }
+    writer.write(file_path);
+}
+
+PackReader::PackReader(const std::filesystem::path& file_path, AsyncFileReaderInterface& file_reader)
+    : _file_reader(file_reader)
+{
+    _file = open(file_path.c_str(), O_RDONLY);
+    if (_file < 0)
+    {
+        std::stringstream t;
+        t << "PackReader() fail to open " << file_path << ", " << std::strerror(errno);
+        throw std::runtime_error(t.str());
+    }
+
+    try
+    {
+        PackHeader header;
+        read_bytes(0, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+        if (std::memcmp(header.magic, PackHeader().magic, sizeof(header.magic)) != 0
+            || header.version != PackHeader().version)
+        {
+            throw std::runtime_error("PackReader() unsupported file format");
+        }
+
+        _entries.resize(header.entry_count);
+        read_bytes(header.index_offset, reinterpret_cast<uint8_t*>(_entries.data()), _entries.size() * sizeof(PackEntry));
+    }
+    catch (...)
+    {
+        close(_file);
+        throw;
+    }
+}
+
+PackReader::~PackReader()
+{
+    close(_file);
+}
+
+const PackEntry* PackReader::find(std::string_view path) const
+{
+    const auto hash = get_pack_path_hash(path);
+    auto i = std::lower_bound(_entries.cbegin(), _entries.cend(), hash, compare_hash);
+    if (i == _entries.cend() || i->path_hash != hash)
+    {
+        return nullptr;
+    }
+    return &*i;
+}
+
+void PackReader::read(const PackEntry& entry, uint8_t* target) const
+{
+    switch (entry.codec)
+    {
+        case PackCodec::none:
+        {
+            read_bytes(entry.offset, target, entry.size);
+            break;
+        }
+
+        case PackCodec::lz4:
+        {
+            std::vector<uint8_t> buffer(entry.stored_size);
+            read_bytes(entry.offset, buffer.data(), buffer.size());
+            lz4::decompress(buffer.data(), buffer.size(), target, entry.size);
+            break;
+        }
+
+        default:
+            throw std::runtime_error("PackReader::read() unsupported codec");
+    }
+}
+
+std::vector<uint8_t> PackReader::read(const PackEntry& entry) const
+{
+    std::vector<uint8_t> result(entry.size);
+    read(entry, result.data());
+    return result;
+}
+
+void PackReader::read(const std::vector<const PackEntry*>& entries, const ReadCallback& on_read) const
+{
+    // uncompressed entries are read straight into the result
+    std::vector<std::vector<uint8_t>> stored(entries.size());
+    std::vector<std::vector<uint8_t>> data(entries.size());
+
+    std::vector<AsyncFileReaderInterface::Request> requests(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const auto& entry = *entries[i];
+        if (entry.codec != PackCodec::none && entry.codec != PackCodec::lz4)
+        {
+            throw std::runtime_error("PackReader::read() unsupported codec");
+        }
+
+        data[i].resize(entry.size);
+        auto& target = entry.codec == PackCodec::none ? data[i] : stored[i];
+        target.resize(entry.stored_size);
+
+        auto& request = requests[i];
+        request.file = _file;
+        request.offset = entry.offset;
+        request.target = target.data();
+        request.size = target.size();
+        request.on_complete = [&, i]() {
+            if (entries[i]->codec == PackCodec::lz4)
+            {
+                lz4::decompress(stored[i].data(), stored[i].size(), data[i].data(), data[i].size());
+                stored[i] = std::vector<uint8_t>();
+            }
+            on_read(i, data[i]);
+        };
+    }
+
+    _file_reader.read(requests);
+}
+
+std::vector<std::vector<uint8_t>> PackReader::read(const std::vector<const PackEntry*>& entries) const
+{
+    std::vector<std::vector<uint8_t>> result(entries.size());
+    read(entries, [&](size_t index, std::vector<uint8_t>& data) {
+        result[index] = std::move(data);
+    });
+    return result;
+}
+
+const std::vector<PackEntry>& PackReader::get_entries() const
+{
+    return _entries;
+}
+
+void PackReader::read_bytes(uint64_t offset, uint8_t* target, size_t size) const
+{
+    while (size > 0)
+    {
+        const auto count = pread(_file, target, size, static_cast<off_t>(offset));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            throw std::runtime_error("PackReader::read_bytes() unexpected end of file");
+        }
+        target += count;
+        offset += count;
+        size -= count;
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  pack_file.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "async_file_reader.hpp"
+
+namespace angry
+{
+
+// Pack layout: header, entry data aligned to 16 bytes, index of entries sorted by path hash.
+// All numbers are little endian.
+
+enum class PackCodec : uint32_t
+{
+    none = 0,
+    lz4 = 1
+};
+
+struct PackHeader
+{
+    char magic[4] = {'A', 'P', 'A', 'K'};
+    uint32_t version = 1;
+    uint32_t entry_count = 0;
+    uint32_t reserved = 0;
+    uint64_t index_offset = 0;
+};
+
+struct PackEntry
+{
+    uint64_t path_hash = 0;
+    uint64_t offset = 0;
+    uint64_t stored_size = 0;
+    uint64_t size = 0;
+    PackCodec codec = PackCodec::none;
+    uint32_t reserved = 0;
+};
+
+// FNV-1a of a path relative to the assets directory, with '/' separators.
+uint64_t get_pack_path_hash(std::string_view path);
+
+class PackWriter final
+{
+public:
+    // Entry is stored uncompressed if compression does not make it smaller.
+    void add(std::string_view path, const uint8_t* data, size_t size, PackCodec codec = PackCodec::lz4);
+    void write(const std::filesystem::path& file_path) const;
+
+private:
+    struct Item
+    {
+        PackEntry entry;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Item> _items;
+};
+
+// Packs every regular file of `directory` (recursively) into `file_path`.
+void write_pack(const std::filesystem::path& directory, const std::filesystem::path& file_path);
+
+// Keeps one file handle open, entries are read with positioned reads
+// and can be read from several threads at once.
+class PackReader final
+{
+public:
+    // called on a worker thread with the decompressed data of `entries[index]`
+    using ReadCallback = std::function<void(size_t index, std::vector<uint8_t>& data)>;
+
+    PackReader(const std::filesystem::path& file_path, AsyncFileReaderInterface& file_reader);
+    ~PackReader();
+
+    PackReader(const PackReader&) = delete;
+    PackReader(PackReader&&) = delete;
+    PackReader& operator=(const PackReader&) = delete;
+    PackReader& operator=(PackReader&&) = delete;
+
+    const PackEntry* find(std::string_view path) const;
+
+    // `target` must have room for `entry.size` bytes.
+    void read(const PackEntry& entry, uint8_t* target) const;
+    std::vector<uint8_t> read(const PackEntry& entry) const;
+
+    // One batch for all entries, every entry is decompressed as soon as its read completes.
+    void read(const std::vector<const PackEntry*>& entries, const ReadCallback& on_read) const;
+    std::vector<std::vector<uint8_t>> read(const std::vector<const PackEntry*>& entries) const;
+
+    const std::vector<PackEntry>& get_entries() const;
+
+private:
+    void read_bytes(uint64_t offset, uint8_t* target, size_t size) const;
+
+private:
+    AsyncFileReaderInterface& _file_reader;
+    int _file = -1;
+    std::vector<PackEntry> _entries;
+};
+
+}
@@ -0,0 +1,170 @@
+//
+//  pixel_conversion.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "pixel_conversion.hpp"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+using namespace angry;
+
+namespace
+{
+
+// pixels are converted from the end, so in place expansion never overwrites unread source
+const size_t block_size = 16;
+
+void expand_rgb_to_bgra_scalar(const uint8_t* source, uint8_t* target, size_t pixel_count)
+{
+    for (size_t i = pixel_count; i > 0; i--)
+    {
+        const uint8_t* s = source + 3 * (i - 1);
+        uint8_t* t = target + 4 * (i - 1);
+        const uint8_t r = s[0];
+        const uint8_t g = s[1];
+        const uint8_t b = s[2];
+        t[0] = b;
+        t[1] = g;
+        t[2] = r;
+        t[3] = 255;
+    }
+}
+
+void swizzle_rgba_to_bgra_scalar(uint8_t* pixels, size_t pixel_count)
+{
+    for (size_t i = 0; i < pixel_count; i++)
+    {
+        uint8_t* p = pixels + 4 * i;
+        const uint8_t r = p[0];
+        p[0] = p[2];
+        p[2] = r;
+    }
+}
+
+#if defined(__ARM_NEON)
+
+void expand_block(const uint8_t* source, uint8_t* target)
+{
+    const uint8x16x3_t rgb = vld3q_u8(source);
+    uint8x16x4_t bgra;
+    bgra.val[0] = rgb.val[2];
+    bgra.val[1] = rgb.val[1];
+    bgra.val[2] = rgb.val[0];
+    bgra.val[3] = vdupq_n_u8(255);
+    vst4q_u8(target, bgra);
+}
+
+size_t swizzle_blocks(uint8_t* pixels, size_t pixel_count)
+{
+    size_t i = 0;
+    for (; i + block_size <= pixel_count; i += block_size)
+    {
+        uint8x16x4_t p = vld4q_u8(pixels + 4 * i);
+        const uint8x16_t r = p.val[0];
+        p.val[0] = p.val[2];
+        p.val[2] = r;
+        vst4q_u8(pixels + 4 * i, p);
+    }
+    return i;
+}
+
+#elif defined(__SSSE3__)
+
+void expand_block(const uint8_t* source, uint8_t* target)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+
+    // all loads happen before stores, target can overlap source of this block
+    const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16));
+    const __m128i in2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 32));
+
+    const __m128i p0 = in0;
+    const __m128i p1 = _mm_alignr_epi8(in1, in0, 12);
+    const __m128i p2 = _mm_alignr_epi8(in2, in1, 8);
+    const __m128i p3 = _mm_srli_si128(in2, 4);
+
+    auto* t = reinterpret_cast<__m128i*>(target);
+    _mm_storeu_si128(t, _mm_or_si128(_mm_shuffle_epi8(p0, mask), alpha));
+    _mm_storeu_si128(t + 1, _mm_or_si128(_mm_shuffle_epi8(p1, mask), alpha));
+    _mm_storeu_si128(t + 2, _mm_or_si128(_mm_shuffle_epi8(p2, mask), alpha));
+    _mm_storeu_si128(t + 3, _mm_or_si128(_mm_shuffle_epi8(p3, mask), alpha));
+}
+
+size_t swizzle_blocks(uint8_t* pixels, size_t pixel_count)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    for (; i + block_size <= pixel_count; i += block_size)
+    {
+        auto* p = reinterpret_cast<__m256i*>(pixels + 4 * i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+        _mm256_storeu_si256(p + 1, _mm256_shuffle_epi8(_mm256_loadu_si256(p + 1), mask));
+    }
+#else
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + block_size <= pixel_count; i += block_size)
+    {
+        auto* p = reinterpret_cast<__m128i*>(pixels + 4 * i);
+        for (int k = 0; k < 4; k++)
+        {
+            _mm_storeu_si128(p + k, _mm_shuffle_epi8(_mm_loadu_si128(p + k), mask));
+        }
+    }
+#endif
+    return i;
+}
+
+#endif
+
+}
+
+void angry::expand_rgb_to_bgra(const uint8_t* source, uint8_t* target, size_t pixel_count)
+{
+#if defined(__ARM_NEON) || defined(__SSSE3__)
+    const size_t head = pixel_count % block_size;
+    for (size_t i = pixel_count; i > head; i -= block_size)
+    {
+        const size_t first = i - block_size;
+        expand_block(source + 3 * first, target + 4 * first);
+    }
+    expand_rgb_to_bgra_scalar(source, target, head);
+#else
+    expand_rgb_to_bgra_scalar(source, target, pixel_count);
+#endif
+}
+
+void angry::swizzle_rgba_to_bgra(uint8_t* pixels, size_t pixel_count)
+{
+#if defined(__ARM_NEON) || defined(__SSSE3__)
+    const size_t done = swizzle_blocks(pixels, pixel_count);
+    swizzle_rgba_to_bgra_scalar(pixels + 4 * done, pixel_count - done);
+#else
+    swizzle_rgba_to_bgra_scalar(pixels, pixel_count);
+#endif
+}
+
+const char* angry::get_pixel_conversion_kernel_name()
+{
+#if defined(__ARM_NEON)
+    return "neon";
+#elif defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSSE3__)
+    return "ssse3";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,27 @@
+//
+//  pixel_conversion.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace angry
+{
+
+// Kernels are chosen at compile time: NEON, AVX2 or SSSE3, scalar otherwise.
+
+// RGB to BGRA with opaque alpha, `target` can be the same memory as `source`
+// if it has room for 4 * `pixel_count` bytes.
+void expand_rgb_to_bgra(const uint8_t* source, uint8_t* target, size_t pixel_count);
+
+// RGBA to BGRA in place.
+void swizzle_rgba_to_bgra(uint8_t* pixels, size_t pixel_count);
+
+const char* get_pixel_conversion_kernel_name();
+
+}
@@ -11,6 +11,7 @@
 
 #include "score_string.hpp"
 #include "screen.hpp"
+#include "texture_manager_interface.hpp"
 
 namespace angry
 {
@@ -24,13 +25,14 @@ class PlayScreen final : public Screen
 {
 public:
     PlayScreen(TextureManager& texture_manager, const std::filesystem::path& assets_path);
+    ~PlayScreen() override;
 
     void reset() override;
     void update(const Context& context, Scene& scene, float delta_time) override;
 
 private:
     TextureManager& _texture_manager;
-    size_t _button_texture = 0;
+    TextureRegion _button_region;
     ScoreString _score_string;
 };
 
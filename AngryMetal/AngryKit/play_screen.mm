@@ -35,7 +35,12 @@ using namespace angry::ui;
 PlayScreen::PlayScreen(TextureManager& texture_manager, const std::filesystem::path& assets_path) :
     _texture_manager(texture_manager)
 {
-    _button_texture = texture_manager.create_texture(assets_path / "Button.png");
+    _button_region = texture_manager.create_texture_region(assets_path / "Button.png");
+}
+
+PlayScreen::~PlayScreen()
+{
+    _texture_manager.release_texture(_button_region.texture);
 }
 
 void PlayScreen::reset()
@@ -72,11 +77,12 @@ void PlayScreen::update(const Context& context, Scene& scene, float delta_time)
     const auto control_area_size = floor((viewport->Size.y - 2.0f * context.padding.y) / 3.0f);
     auto& input_component = scene.get_registry().get<InputComponent>(scene.get_player());
 
-    ImVec2 uv1(0.0f, 0.0f);
-    ImVec2 uv2(1.0f, 1.0f);
+    const auto& uv_transform = _button_region.uv_transform;
+    ImVec2 uv1(uv_transform.z, uv_transform.w);
+    ImVec2 uv2(uv_transform.z + uv_transform.x, uv_transform.w + uv_transform.y);
     ImVec4 tint_color(1.0f, 1.0f, 1.0f, 0.25f);
     {
-        ImTextureID texture_id = _texture_manager.get_texture(_button_texture);
+        ImTextureID texture_id = _texture_manager.get_texture(_button_region.texture);
         const auto size = floor(control_area_size / 2.5f);
         ImVec2 button_size(size, size);
         {
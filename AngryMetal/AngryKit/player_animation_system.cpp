@@ -10,14 +10,17 @@
 #include <simd/simd.h>
 
 #include <stdexcept>
-#include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "animation_component.hpp"
+#include "frame_arena.hpp"
 #include "health_component.hpp"
+#include "load_profiler.hpp"
 #include "mesh_component.hpp"
 #include "movement_component.hpp"
 #include "scene.hpp"
+#include "shadow_proxy.hpp"
 
 using namespace angry;
 
@@ -51,29 +54,69 @@ void scaled_add(aiMatrix4x4& m1, const float scale, const aiMatrix4x4& m2)
     m1.d4 += scale * m2.d4;
 }
 
-using TransformMap = std::unordered_map<std::string, aiMatrix4x4>;
+// keys point to names in the imported scene, nodes and buckets live in the frame arena
+using TransformMap = std::unordered_map<
+    std::string_view,
+    aiMatrix4x4,
+    std::hash<std::string_view>,
+    std::equal_to<std::string_view>,
+    FrameAllocator<std::pair<const std::string_view, aiMatrix4x4>>
+>;
+
+// enough for the player rig, no rehash while nodes are added
+const size_t transform_map_bucket_count = 128;
+
+TransformMap make_transform_map(FrameArena& arena)
+{
+    return TransformMap(transform_map_bucket_count,
+                        TransformMap::hasher(),
+                        TransformMap::key_equal(),
+                        TransformMap::allocator_type(arena));
+}
+
+std::string_view get_name(const aiString& name)
+{
+    return std::string_view(name.data, name.length);
+}
 
 struct Processor
 {
     BufferManagerInterface& buffer_manager;
+    FrameArena& arena;
     Scene& scene;
     AnimationComponent& animation_component;
 
-    Processor(BufferManagerInterface& buffer_manager, Scene& scene, AnimationComponent& animation_component)
-        : buffer_manager(buffer_manager), scene(scene), animation_component(animation_component)
+    Processor(BufferManagerInterface& buffer_manager, FrameArena& arena, Scene& scene, AnimationComponent& animation_component)
+        : buffer_manager(buffer_manager), arena(arena), scene(scene), animation_component(animation_component)
+    {
+    }
+
+    void collect_mesh_nodes(aiNode* node, const aiMesh* source, FrameVector<aiNode*>& mesh_nodes)
     {
+        for (unsigned i = 0; i < node->mNumMeshes; i++)
+        {
+            if (get_mesh(node->mMeshes[i]).source_mesh == source)
+            {
+                mesh_nodes.push_back(node);
+            }
+        }
+
+        for (unsigned i = 0; i < node->mNumChildren; i++)
+        {
+            collect_mesh_nodes(node->mChildren[i], source, mesh_nodes);
+        }
     }
 
     void set_mesh_vertex_buffer(MeshComponent& mesh_component, TransformMap& node_transform_map)
     {
         auto source = mesh_component.source_mesh;
 
-        std::vector<aiMatrix4x4> bone_anim_transform(source->mNumVertices, zero_ai_mat());
+        auto bone_anim_transform = FrameVector<aiMatrix4x4>(FrameAllocator<aiMatrix4x4>(arena));
+        bone_anim_transform.resize(source->mNumBones > 0 ? source->mNumVertices : 0, zero_ai_mat());
         for (unsigned bone_index = 0; bone_index < source->mNumBones; bone_index++)
         {
             aiBone* bone = source->mBones[bone_index];
-            const std::string bone_name = bone->mName.C_Str();
-            const aiMatrix4x4 node_transform = animation_component.global_inv * node_transform_map[bone_name] * bone->mOffsetMatrix;
+            const aiMatrix4x4 node_transform = animation_component.global_inv * node_transform_map[get_name(bone->mName)] * bone->mOffsetMatrix;
             for (unsigned weight_index = 0; weight_index < bone->mNumWeights; weight_index++)
             {
                 aiVertexWeight w = bone->mWeights[weight_index];
@@ -84,29 +127,11 @@ struct Processor
         aiMatrix4x4 node_anim_transform;
         if (source->mNumBones == 0)
         {
-            std::vector<aiNode*> mesh_nodes;
-            std::function<void(aiNode*)> r;
-            r = [source, this, &mesh_nodes, &r](aiNode* n)
-            {
-                for (unsigned xx = 0; xx < n->mNumMeshes; xx++)
-                {
-                    aiMesh* tmp_mesh = get_mesh(n->mMeshes[xx]).source_mesh;
-                    if (tmp_mesh == source)
-                    {
-                        mesh_nodes.push_back(n);
-                    }
-                }
-
-                for (unsigned xx = 0; xx < n->mNumChildren; xx++)
-                {
-                    r(n->mChildren[xx]);
-                }
-            };
-
-            r(animation_component.root_node);
+            auto mesh_nodes = FrameVector<aiNode*>(FrameAllocator<aiNode*>(arena));
+            collect_mesh_nodes(animation_component.root_node, source, mesh_nodes);
             for (auto* mesh_node : mesh_nodes)
             {
-                node_anim_transform *= node_transform_map[std::string(mesh_node->mName.data)];
+                node_anim_transform *= node_transform_map[get_name(mesh_node->mName)];
             }
         }
 
@@ -120,6 +145,47 @@ struct Processor
             position[3 * i + 1] = v.y;
             position[3 * i + 2] = v.z;
         }
+
+        if (mesh_component.shadow_proxy)
+        {
+            const auto& shadow_proxy = *mesh_component.shadow_proxy;
+            auto target = buffer_manager.get_buffer_view<float>(shadow_proxy.vertex_buffer).data;
+            update_shadow_proxy_positions(shadow_proxy, position, target);
+        }
+    }
+
+    void create_shadow_proxy(MeshComponent& mesh_component)
+    {
+        auto source = mesh_component.source_mesh;
+        const auto& mesh = mesh_component.mesh;
+
+        auto indices = buffer_manager.get_buffer_view<uint32_t>(mesh.index_buffer).data;
+        auto geometry = make_shadow_proxy_geometry(
+            reinterpret_cast<const float*>(source->mVertices),
+            source->mNumVertices,
+            indices,
+            mesh.index_count,
+            mesh_component.shadow_proxy_resolution
+        );
+        if (geometry.indices.empty())
+        {
+            // nothing left after simplification, keep the full mesh for shadow
+            mesh_component.shadow_proxy_resolution = 0;
+            return;
+        }
+
+        ShadowProxy shadow_proxy;
+        // positions follow the animation every frame
+        shadow_proxy.vertex_buffer = buffer_manager.create_dynamic_buffer(geometry.source_vertices.size() * 3 * sizeof(float), BufferUsage::vertex);
+        shadow_proxy.index_buffer = buffer_manager.create_buffer(
+            reinterpret_cast<const uint8_t*>(geometry.indices.data()),
+            geometry.indices.size() * sizeof(uint32_t),
+            BufferUsage::index
+        );
+        shadow_proxy.index_count = geometry.indices.size();
+        shadow_proxy.source_vertices = std::move(geometry.source_vertices);
+
+        mesh_component.shadow_proxy = std::move(shadow_proxy);
     }
 
     void process_mesh(MeshComponent& mesh_component, TransformMap& node_transform_map)
@@ -128,16 +194,19 @@ struct Processor
 
         if (mesh_component.mesh.vertex_buffer.empty())
         {
+            LoadProfiler::Scope scope("vertex_copy", source->mName.C_Str());
+
             const auto vertex_count = source->mNumVertices;
             {
-                const auto index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float));
+                // skinned every frame, normals and uv stay as loaded
+                const auto index = buffer_manager.create_dynamic_buffer(vertex_count * 3 * sizeof(float), BufferUsage::vertex);
                 mesh_component.mesh.vertex_buffer[VertexAttribute::position] = index;
             }
 
-            const auto normal_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float));
+            const auto normal_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float), BufferUsage::vertex);
             mesh_component.mesh.vertex_buffer[VertexAttribute::normal] = normal_index;
 
-            const auto uv_index = buffer_manager.create_buffer(vertex_count * 2 * sizeof(float));
+            const auto uv_index = buffer_manager.create_buffer(vertex_count * 2 * sizeof(float), BufferUsage::vertex);
             mesh_component.mesh.vertex_buffer[VertexAttribute::uv] = uv_index;
 
             auto normal = buffer_manager.get_buffer_view<float>(normal_index).data;
@@ -165,8 +234,10 @@ struct Processor
 
         if (!mesh_component.mesh.index_buffer)
         {
+            LoadProfiler::Scope scope("index_copy", source->mName.C_Str());
+
             const auto index_count = 3 * source->mNumFaces;
-            const auto index = buffer_manager.create_buffer(index_count * sizeof(uint32_t));
+            const auto index = buffer_manager.create_buffer(index_count * sizeof(uint32_t), BufferUsage::index);
             mesh_component.mesh.index_buffer = index;
             mesh_component.mesh.index_count = index_count;
 
@@ -183,6 +254,11 @@ struct Processor
             }
         }
 
+        if (mesh_component.has_shadow && mesh_component.shadow_proxy_resolution > 0 && !mesh_component.shadow_proxy)
+        {
+            create_shadow_proxy(mesh_component);
+        }
+
         set_mesh_vertex_buffer(mesh_component, node_transform_map);
     }
 
@@ -271,7 +347,7 @@ void append_node_points(float target_anim_ticks, aiAnimation* anim, aiMatrix4x4
     }
 
     transform *= anim_found ? anim_transform : node->mTransformation;
-    node_transform_map.emplace(node->mName.C_Str(), transform);
+    node_transform_map.emplace(get_name(node->mName), transform);
 
     for (unsigned i = 0; i < node->mNumChildren; ++i)
     {
@@ -279,7 +355,8 @@ void append_node_points(float target_anim_ticks, aiAnimation* anim, aiMatrix4x4
     }
 }
 
-PlayerAnimationSystem::PlayerAnimationSystem(BufferManagerInterface& buffer_manager) : _buffer_manager(buffer_manager)
+PlayerAnimationSystem::PlayerAnimationSystem(BufferManagerInterface& buffer_manager, FrameArena& frame_arena)
+    : _buffer_manager(buffer_manager), _frame_arena(frame_arena)
 {
 }
 
@@ -297,7 +374,7 @@ void PlayerAnimationSystem::update(Scene& scene, float time)
 
     aiAnimation* animation = animation_component.animation;
     aiNode* root_node = animation_component.root_node;
-    TransformMap merged_node_transform_map;
+    auto merged_node_transform_map = make_transform_map(_frame_arena);
 
     struct AnimationData
     {
@@ -307,7 +384,7 @@ void PlayerAnimationSystem::update(Scene& scene, float time)
         float tick_offset;
         float* opt_anim_start = nullptr;
     };
-    const auto process_anim = [&merged_node_transform_map, root_node, animation, time](const AnimationData& data)
+    const auto process_anim = [this, &merged_node_transform_map, root_node, animation, time](const AnimationData& data)
     {
         if (data.weight == 0.0f)
         {
@@ -323,7 +400,7 @@ void PlayerAnimationSystem::update(Scene& scene, float time)
             throw std::runtime_error("PlayerAnimationSystem::animate()");
         }
 
-        TransformMap local_node_transform_map;
+        auto local_node_transform_map = make_transform_map(_frame_arena);
         append_node_points(target_anim_ticks, animation, aiMatrix4x4(), root_node, local_node_transform_map);
         for (const auto& t : local_node_transform_map)
         {
@@ -386,6 +463,6 @@ void PlayerAnimationSystem::update(Scene& scene, float time)
     process_anim({back_weight, 159.0f, 159.0f + movement_anim_dur, 10.0f});
     process_anim({left_weight, 209.0f, 209.0f + movement_anim_dur, 0.0f});
 
-    Processor processor(_buffer_manager, scene, animation_component);
+    Processor processor(_buffer_manager, _frame_arena, scene, animation_component);
     processor.process_node(root_node, merged_node_transform_map);
 }
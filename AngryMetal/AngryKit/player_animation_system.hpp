@@ -12,12 +12,14 @@
 namespace angry
 {
 
+class FrameArena;
 class Scene;
 
 class PlayerAnimationSystem final
 {
 public:
-    explicit PlayerAnimationSystem(BufferManagerInterface& buffer_manager);
+    // transform maps of a frame go to `frame_arena`, the owner resets it after the frame
+    PlayerAnimationSystem(BufferManagerInterface& buffer_manager, FrameArena& frame_arena);
     ~PlayerAnimationSystem() = default;
 
     PlayerAnimationSystem(const PlayerAnimationSystem&&) = delete;
@@ -29,6 +31,7 @@ public:
 
 private:
     BufferManagerInterface& _buffer_manager;
+    FrameArena& _frame_arena;
 };
 
 }
@@ -0,0 +1,65 @@
+//
+//  prefab.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <tuple>
+
+#include <entt/entt.hpp>
+
+#include "registry.hpp"
+
+namespace angry
+{
+
+// Component values shared by a group of entities, declared once and written
+// component type by component type instead of entity by entity.
+template<class... Components>
+class Prefab final
+{
+public:
+    explicit Prefab(Components... components) : _components(std::move(components)...)
+    {
+    }
+
+    template<class T>
+    const T& get() const
+    {
+        return std::get<T>(_components);
+    }
+
+    // One bulk insert per component type, entities must not have these components yet.
+    template<class It>
+    void instantiate(Registry& registry, It first, It last) const
+    {
+        (registry.insert<Components>(first, last, std::get<Components>(_components)), ...);
+    }
+
+    // Writes prefab values back, one pass over each component storage.
+    template<class It>
+    void reset(Registry& registry, It first, It last) const
+    {
+        (reset_component<Components>(registry, first, last), ...);
+    }
+
+private:
+    template<class T, class It>
+    void reset_component(Registry& registry, It first, It last) const
+    {
+        auto view = registry.view<T>();
+        const T& value = std::get<T>(_components);
+        for (auto i = first; i != last; ++i)
+        {
+            view.template get<T>(*i) = value;
+        }
+    }
+
+private:
+    std::tuple<Components...> _components;
+};
+
+}
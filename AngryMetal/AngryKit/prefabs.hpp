@@ -0,0 +1,23 @@
+//
+//  prefabs.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include "collider_component.hpp"
+#include "instanced_mesh_component.hpp"
+#include "movement_component.hpp"
+#include "prefab.hpp"
+#include "time_component.hpp"
+#include "transform_component.hpp"
+
+namespace angry
+{
+
+using EnemyPrefab = Prefab<TransformComponent, InstancedMeshComponent, ColliderComponent, MovementComponent>;
+using BulletPrefab = Prefab<TransformComponent, InstancedMeshComponent, ColliderComponent, TimeComponent, MovementComponent>;
+
+}
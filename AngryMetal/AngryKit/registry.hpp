@@ -0,0 +1,20 @@
+//
+//  registry.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "component_arena.hpp"
+
+namespace angry
+{
+
+// needs the allocator aware basic_registry of EnTT 3.10 or later
+using Registry = entt::basic_registry<entt::entity, ComponentAllocator<entt::entity>>;
+
+}
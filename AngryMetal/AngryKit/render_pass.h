@@ -9,9 +9,9 @@
 
 #import <Metal/Metal.h>
 
-#include <unordered_map>
 #include <vector>
 
+#include "enum_array.hpp"
 #include "instanced_mesh_manager.hpp"
 #include "mesh.hpp"
 #include "render_pass_attribute.h"
@@ -22,7 +22,7 @@ namespace angry
 
 using AttributeArray = std::vector<render::AttributeType>;
 using TextureArray = std::vector<MaterialTexture>;
-using InstanceBufferAttributes = std::unordered_map<InstanceBufferType, NSUInteger>;
+using InstanceBufferAttributes = EnumTable<InstanceBufferType, NSUInteger, instance_buffer_type_count>;
 
 class RenderPass
 {
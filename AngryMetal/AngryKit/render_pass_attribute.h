@@ -21,7 +21,8 @@ enum class AttributeType
     view_position,
     aim_rotation,
     light_space_matrix,
-    time
+    time,
+    uv_transform
 };
 
 template<class T, AttributeType type>
@@ -39,6 +40,7 @@ using ViewPositionAttribute = Attribute<simd_float3, AttributeType::view_positio
 using AimRotationMatrixAttribute = Attribute<simd_float4x4, AttributeType::aim_rotation>;
 using LightSpaceMatrixAttribute = Attribute<simd_float4x4, AttributeType::light_space_matrix>;
 using TimeAttribute = Attribute<float, AttributeType::time>;
+using UVTransformAttribute = Attribute<simd_float4, AttributeType::uv_transform>;
 
 using AttributeVariant = std::variant<
     ModelMatrixAttribute,
@@ -46,6 +48,7 @@ using AttributeVariant = std::variant<
     ViewPositionAttribute,
     AimRotationMatrixAttribute,
     LightSpaceMatrixAttribute,
-    TimeAttribute>;
+    TimeAttribute,
+    UVTransformAttribute>;
 
 }
@@ -15,6 +15,7 @@
 
 #include "buffer_manager.h"
 #include "instanced_mesh_manager.hpp"
+#include "meshlet.hpp"
 #include "metal_context.h"
 #include "render_pass.h"
 #include "objc_ref.h"
@@ -44,7 +45,10 @@ public:
 
     void setup(id<MTLDevice> device);
     void draw(MetalContext& context, Scene& scene, const Timer& timer);
-    
+
+    // meshlets of the last drawn frame
+    const MeshletCuller::Statistics& get_meshlet_statistics() const;
+
 private:
     void setup_depth_state(id<MTLDevice> device);
     RenderPass* find_render_pass(RenderPassType type) const;
@@ -54,6 +58,7 @@ private:
     InstancedMeshManager* _instanced_mesh_manager;
     TextureManager* _texture_manager;
     std::unique_ptr<ShadowMapManager> _shadow_map_manager;
+    MeshletCuller _meshlet_culler;
 
     objc::Ref<id<MTLDepthStencilState>> _depth_state;
 
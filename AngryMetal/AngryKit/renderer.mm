@@ -9,6 +9,7 @@
 
 #import "Game.h"
 
+#include <array>
 #include <stdexcept>
 
 #include "bullet_render_pass.h"
@@ -18,6 +19,7 @@
 #include "instanced_mesh_component.hpp"
 #include "matrix.hpp"
 #include "mesh_component.hpp"
+#include "meshlet_component.hpp"
 #include "movement_component.hpp"
 #include "player_render_pass.h"
 #include "scene.hpp"
@@ -62,6 +64,9 @@ void Renderer::setup(id<MTLDevice> device)
 
 void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
 {
+    _texture_manager->update_streaming();
+    _meshlet_culler.reset_statistics();
+
     _shadow_map_manager->update(scene, context.command_buffer);
     auto light_space_matrix = _shadow_map_manager->get_light_space_matrix();
     auto shadow_map = _shadow_map_manager->get_shadow_map();
@@ -73,6 +78,28 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
     [command_encoder setFrontFacingWinding:MTLWindingCounterClockwise];
     [command_encoder setCullMode:MTLCullModeBack];
 
+    // draws sharing an atlas page or a material skip the rebind
+    std::array<id<MTLTexture>, 8> bound_textures = {};
+
+    // meshes in the same slab only move the offset, another pass may have put its uniform
+    // bytes on any index so its bindings start over
+    std::array<id<MTLBuffer>, 8> bound_buffers = {};
+    RenderPass* bound_pass = nullptr;
+    auto bind_vertex_buffer = [&](size_t buffer_index, NSUInteger attribute_index)
+    {
+        id<MTLBuffer> buffer = _buffer_manager->get_buffer(buffer_index);
+        const NSUInteger offset = _buffer_manager->get_buffer_offset(buffer_index);
+        if (bound_buffers.at(attribute_index) == buffer)
+        {
+            [command_encoder setVertexBufferOffset:offset atIndex:attribute_index];
+        }
+        else
+        {
+            [command_encoder setVertexBuffer:buffer offset:offset atIndex:attribute_index];
+            bound_buffers[attribute_index] = buffer;
+        }
+    };
+
     auto& camera_component = scene.get_registry().get<CameraComponent>(scene.get_camera());
     auto f = [&](const Mesh& mesh, entt::entity* entity)
     {
@@ -82,6 +109,12 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
             return;
         }
 
+        if (render_pass != bound_pass)
+        {
+            bound_buffers = {};
+            bound_pass = render_pass;
+        }
+
         for (const auto& type : render_pass->get_attributes())
         {
             switch (type)
@@ -126,6 +159,12 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
                     render_pass->set_attribute(render::TimeAttribute(timer.get_time_since_start()));
                     break;
                 }
+
+                case render::AttributeType::uv_transform:
+                {
+                    render_pass->set_attribute(render::UVTransformAttribute(mesh.material.uv_transform));
+                    break;
+                }
             }
         }
         render_pass->encode(command_encoder);
@@ -134,15 +173,18 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
         NSUInteger texture_index = 0;
         for (auto t : render_pass->get_textures())
         {
-            if (t == MaterialTexture::shadow)
+            id<MTLTexture> texture = shadow_map;
+            if (t != MaterialTexture::shadow)
             {
-                [command_encoder setFragmentTexture:shadow_map atIndex:texture_index];
+                const auto index = material.textures.at(t);
+                _texture_manager->mark_used(index);
+                texture = _texture_manager->get_texture(index);
             }
-            else
+
+            if (bound_textures.at(texture_index) != texture)
             {
-                auto index = material.textures.at(t);
-                id<MTLTexture> texture = _texture_manager->get_texture(index);
                 [command_encoder setFragmentTexture:texture atIndex:texture_index];
+                bound_textures[texture_index] = texture;
             }
             texture_index += 1;
         }
@@ -153,11 +195,9 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
         NSUInteger attribute_index = 0;
         for (const auto& attribute : attributes)
         {
-            auto p = mesh.vertex_buffer.find(attribute);
-            if (p != mesh.vertex_buffer.end())
+            if (const auto* buffer_index = mesh.vertex_buffer.find(attribute))
             {
-                id<MTLBuffer> buffer = _buffer_manager->get_buffer(p->second);
-                [command_encoder setVertexBuffer:buffer offset:0 atIndex:attribute_index];
+                bind_vertex_buffer(*buffer_index, attribute_index);
                 attribute_index += 1;
             }
         }
@@ -176,14 +216,35 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
         const auto& mesh = mesh_component.mesh;
         f(mesh, &entity);
 
-        if (mesh.index_count > 0)
+        auto* meshlet_component = scene.get_registry().try_get<MeshletComponent>(entity);
+        if (meshlet_component != nullptr && mesh.index_count > 0)
+        {
+            const auto& transform_component = scene.get_registry().get<TransformComponent>(entity);
+            _meshlet_culler.cull(meshlet_component->meshlets,
+                                 transform_component.get_matrix(),
+                                 camera_component.projection_view_matrix,
+                                 camera_component.position,
+                                 meshlet_component->visible_ranges);
+
+            id<MTLBuffer> index_buffer = _buffer_manager->get_buffer(mesh.index_buffer);
+            const size_t index_offset = _buffer_manager->get_buffer_offset(mesh.index_buffer);
+            for (const auto& range : meshlet_component->visible_ranges)
+            {
+                [command_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                            indexCount:range.count
+                                             indexType:MTLIndexTypeUInt32
+                                           indexBuffer:index_buffer
+                                     indexBufferOffset:index_offset + range.offset * sizeof(uint32_t)];
+            }
+        }
+        else if (mesh.index_count > 0)
         {
             id<MTLBuffer> index_buffer = _buffer_manager->get_buffer(mesh.index_buffer);
             [command_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
                                         indexCount:mesh.index_count
                                          indexType:MTLIndexTypeUInt32
                                        indexBuffer:index_buffer
-                                 indexBufferOffset:0];
+                                 indexBufferOffset:_buffer_manager->get_buffer_offset(mesh.index_buffer)];
         }
         else
         {
@@ -206,29 +267,25 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
         auto& instanced_mesh = _instanced_mesh_manager->get_mesh(mesh_component.instanced_mesh);
 
         const auto& transform_component = scene.get_registry().get<TransformComponent>(entity);
-        for (auto entry : instanced_mesh.buffers)
+        instanced_mesh.buffers.for_each([&](InstanceBufferType type, size_t buffer_index)
         {
-            switch (entry.first)
+            switch (type)
             {
                 case InstanceBufferType::transform:
                 {
-                    auto buffer = _buffer_manager->get_buffer_view<simd_float4x4>(entry.second);
+                    auto buffer = _buffer_manager->get_buffer_view<simd_float4x4>(buffer_index);
                     buffer.data[instanced_mesh.count] = transform_component.get_matrix();
                     break;
                 }
 
                 case InstanceBufferType::aim_rotation:
                 {
-                    auto buffer = _buffer_manager->get_buffer_view<simd_float4x4>(entry.second);
+                    auto buffer = _buffer_manager->get_buffer_view<simd_float4x4>(buffer_index);
                     buffer.data[instanced_mesh.count] = transform_component.get_rotation_matrix();
                     break;
                 }
-
-                default:
-                    break;
             }
-            
-        }
+        });
 
         instanced_mesh.count += 1;
     }
@@ -250,13 +307,10 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
             continue;
         }
 
-        for (auto entry : instanced_mesh->buffers)
+        instanced_mesh->buffers.for_each([&](InstanceBufferType type, size_t buffer_index)
         {
-            auto buffer_index = instanced_mesh->buffers[entry.first];
-            auto buffer = _buffer_manager->get_buffer(buffer_index);
-            auto attribute_index = render_pass->get_attribute_index(entry.first);
-            [command_encoder setVertexBuffer:buffer offset:0 atIndex:attribute_index];
-        }
+            bind_vertex_buffer(buffer_index, render_pass->get_attribute_index(type));
+        });
 
         if (mesh.index_count > 0)
         {
@@ -265,7 +319,7 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
                                         indexCount:mesh.index_count
                                          indexType:MTLIndexTypeUInt32
                                        indexBuffer:index_buffer
-                                 indexBufferOffset:0
+                                 indexBufferOffset:_buffer_manager->get_buffer_offset(mesh.index_buffer)
                                      instanceCount:instanced_mesh->count];
         }
         else
@@ -282,6 +336,11 @@ void Renderer::draw(MetalContext& context, Scene& scene, const Timer& timer)
     [command_encoder popDebugGroup];
 }
 
+const MeshletCuller::Statistics& Renderer::get_meshlet_statistics() const
+{
+    return _meshlet_culler.get_statistics();
+}
+
 void Renderer::setup_depth_state(id<MTLDevice> device)
 {
     objc::Ref<MTLDepthStencilDescriptor*> descriptor([MTLDepthStencilDescriptor new]);
@@ -11,9 +11,11 @@ using namespace angry;
 
 ResourceManager::ResourceManager(BufferManagerInterface& buffer_manager,
                                  InstancedMeshManager& instanced_mesh_manager,
-                                 TextureManagerInterface& texture_manager)
+                                 TextureManagerInterface& texture_manager,
+                                 const AssetStorage& asset_storage)
     : _buffer_manager(buffer_manager),
     _instanced_mesh_manager(instanced_mesh_manager),
-    _texture_manager(texture_manager)
+    _texture_manager(texture_manager),
+    _asset_storage(asset_storage)
 {
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "asset_storage.hpp"
 #include "buffer_manager_interface.hpp"
 #include "instanced_mesh_manager.hpp"
 #include "texture_manager_interface.hpp"
@@ -19,7 +20,8 @@ class ResourceManager final
 public:
     ResourceManager(BufferManagerInterface& buffer_manager,
                     InstancedMeshManager& instanced_mesh_manager,
-                    TextureManagerInterface& texture_manager);
+                    TextureManagerInterface& texture_manager,
+                    const AssetStorage& asset_storage);
 
     ~ResourceManager() = default;
 
@@ -43,10 +45,16 @@ public:
         return _texture_manager;
     }
 
+    const AssetStorage& get_asset_storage() const
+    {
+        return _asset_storage;
+    }
+
 private:
     BufferManagerInterface& _buffer_manager;
     InstancedMeshManager& _instanced_mesh_manager;
     TextureManagerInterface& _texture_manager;
+    const AssetStorage& _asset_storage;
 };
 
 }
@@ -15,24 +15,39 @@
 
 #include "animation_component.hpp"
 #include "camera_component.hpp"
+#include "chunk_component.hpp"
 #include "collider_component.hpp"
 #include "health_component.hpp"
 #include "input_component.hpp"
 #include "instanced_mesh_component.hpp"
+#include "load_profiler.hpp"
 #include "look_component.hpp"
 #include "math.hpp"
 #include "mesh_component.hpp"
+#include "memory_tracker.hpp"
+#include "meshlet_component.hpp"
 #include "movement_component.hpp"
 #include "score_component.hpp"
+#include "slot_map.hpp"
 #include "time_component.hpp"
 #include "transform_component.hpp"
 
 namespace angry
 {
 
-const aiScene* load_scene(Assimp::Importer& importer, const std::filesystem::path& file_path)
+const aiScene* load_scene(Assimp::Importer& importer, const AssetStorage& storage, const std::filesystem::path& file_path)
 {
-    const aiScene* scene = importer.ReadFile(file_path, aiProcess_Triangulate | aiProcess_FlipUVs);
+    LoadProfiler::Scope scope("fbx_import", file_path.filename().string());
+
+    // importer keeps its own copy of the file data
+    const auto file_data = storage.read(file_path);
+    const auto hint = file_path.extension().string();
+    const aiScene* scene = importer.ReadFileFromMemory(
+        file_data.data(),
+        file_data.size(),
+        aiProcess_Triangulate | aiProcess_FlipUVs,
+        hint.empty() ? "" : hint.c_str() + 1
+    );
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
         std::stringstream t;
@@ -42,18 +57,179 @@ const aiScene* load_scene(Assimp::Importer& importer, const std::filesystem::pat
     return scene;
 }
 
+template<typename... Component>
+void reserve_component_storages(Registry& registry, size_t capacity)
+{
+    (registry.storage<Component>().reserve(capacity), ...);
+}
+
+void release_mesh_buffers(BufferManagerInterface& buffer_manager, Mesh& mesh)
+{
+    mesh.vertex_buffer.for_each([&buffer_manager](VertexAttribute, size_t index) {
+        buffer_manager.release_buffer(index);
+    });
+    mesh.vertex_buffer.clear();
+    mesh.vertex_count = 0;
+
+    if (mesh.index_count > 0)
+    {
+        buffer_manager.release_buffer(mesh.index_buffer);
+    }
+    mesh.index_buffer = 0;
+    mesh.index_count = 0;
+}
+
+void release_mesh_buffers(BufferManagerInterface& buffer_manager, MeshComponent& mesh_component)
+{
+    release_mesh_buffers(buffer_manager, mesh_component.mesh);
+    if (mesh_component.shadow_proxy)
+    {
+        buffer_manager.release_buffer(mesh_component.shadow_proxy->vertex_buffer);
+        buffer_manager.release_buffer(mesh_component.shadow_proxy->index_buffer);
+    }
+    mesh_component.shadow_proxy.reset();
+}
+
+void set_mesh_geometry(BufferManagerInterface& buffer_manager, Mesh& mesh, const aiMesh* source)
+{
+    {
+        LoadProfiler::Scope scope("vertex_copy", source->mName.C_Str());
+
+        const auto vertex_count = source->mNumVertices;
+        const auto position_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float), BufferUsage::vertex);
+        mesh.vertex_buffer[VertexAttribute::position] = position_index;
+
+        const auto normal_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float), BufferUsage::vertex);
+        mesh.vertex_buffer[VertexAttribute::normal] = normal_index;
+
+        const auto uv_index = buffer_manager.create_buffer(vertex_count * 2 * sizeof(float), BufferUsage::vertex);
+        mesh.vertex_buffer[VertexAttribute::uv] = uv_index;
+
+        auto position = buffer_manager.get_buffer_view<float>(position_index).data;
+        auto normal = buffer_manager.get_buffer_view<float>(normal_index).data;
+        auto uv = buffer_manager.get_buffer_view<float>(uv_index).data;
+        for (unsigned int i = 0; i < vertex_count; i++)
+        {
+            position[3 * i] = source->mVertices[i].x;
+            position[3 * i + 1] = source->mVertices[i].y;
+            position[3 * i + 2] = source->mVertices[i].z;
+
+            normal[3 * i] = source->mNormals[i].x;
+            normal[3 * i + 1] = source->mNormals[i].y;
+            normal[3 * i + 2] = source->mNormals[i].z;
+
+            if (source->mTextureCoords[0])
+            {
+                uv[2 * i] = source->mTextureCoords[0][i].x;
+                uv[2 * i + 1] = source->mTextureCoords[0][i].y;
+            }
+            else
+            {
+                uv[2 * i] = 0;
+                uv[2 * i + 1] = 0;
+            }
+        }
+        mesh.vertex_count = vertex_count;
+    }
+
+    {
+        LoadProfiler::Scope scope("index_copy", source->mName.C_Str());
+
+        const auto index_count = 3 * source->mNumFaces;
+        const auto index = buffer_manager.create_buffer(index_count * sizeof(uint32_t), BufferUsage::index);
+        mesh.index_buffer = index;
+        mesh.index_count = index_count;
+
+        auto view = buffer_manager.get_buffer_view<uint32_t>(index);
+        size_t p = 0;
+        for (unsigned int i = 0; i < source->mNumFaces; i++)
+        {
+            const aiFace& face = source->mFaces[i];
+            for (unsigned int j = 0; j < face.mNumIndices; j++)
+            {
+                const unsigned int vertex_index = face.mIndices[j];
+                view.data[p++] = vertex_index;
+            }
+        }
+    }
+}
+
 }
 
 using namespace angry;
 
-Scene::Scene(ResourceManager* resource_manager)
-    : _resource_manager(resource_manager), _enemy_pool(_registry, _max_enemy_count),
-    _bullet_pool(_registry, _max_bullet_count)
+Scene::Scene(ResourceManager* resource_manager, size_t max_chunk_count)
+    : _max_chunk_count(max_chunk_count), _resource_manager(resource_manager), _importer1(std::make_unique<Assimp::Importer>()),
+    _importer2(std::make_unique<Assimp::Importer>()), _component_arena(ComponentArena::Settings()),
+    _registry(ComponentAllocator<entt::entity>(_component_arena)), _enemy_pool(_registry, _max_enemy_count),
+    _bullet_pool(_registry, _max_bullet_count), _chunk_pool(_registry, _max_chunk_count)
+{
+    reserve_storages();
+}
+
+Scene::~Scene()
+{
+    TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
+    for (const auto& scene_texture : _textures)
+    {
+        texture_manager.release_texture(scene_texture.texture);
+    }
+
+    // buffers outlive frames in flight in the buffer manager
+    auto& buffer_manager = _resource_manager->get_buffer_manager();
+    for (auto entity : _registry.view<MeshComponent>())
+    {
+        // player, gun and floor chunks, player meshes get buffers on their first animation update
+        release_mesh_buffers(buffer_manager, _registry.get<MeshComponent>(entity));
+    }
+
+    auto& instanced_mesh_manager = _resource_manager->get_instanced_mesh_manager();
+    for (auto index : {_enemy_instanced_mesh, _bullet_instanced_mesh})
+    {
+        if (index == invalid_handle)
+        {
+            continue;
+        }
+
+        auto& instanced_mesh = instanced_mesh_manager.get_mesh(index);
+        release_mesh_buffers(buffer_manager, instanced_mesh.mesh);
+        instanced_mesh.buffers.for_each([&buffer_manager](InstanceBufferType, size_t buffer) {
+            buffer_manager.release_buffer(buffer);
+        });
+        instanced_mesh_manager.release(index);
+    }
+}
+
+void Scene::reserve_storages()
 {
+    // every entity comes from a pool or is one of the camera, the player and the gun
+    const size_t capacity = _max_enemy_count + _max_bullet_count + _max_chunk_count + 3;
+
+    // storages read together by systems and passes are reserved one after another
+    reserve_component_storages<
+        TransformComponent,
+        MovementComponent,
+        ColliderComponent,
+        InstancedMeshComponent,
+        TimeComponent
+    >(_registry, capacity);
+    reserve_component_storages<MeshComponent, MeshletComponent, ChunkComponent>(_registry, capacity);
+
+    // player and camera
+    reserve_component_storages<
+        AnimationComponent,
+        HealthComponent,
+        LookComponent,
+        InputComponent,
+        ScoreComponent,
+        CameraComponent
+    >(_registry, 1);
 }
 
 void Scene::load(const std::filesystem::path& assets_path)
 {
+    _assets_path = assets_path;
+
     _camera_entity = _registry.create();
     _registry.emplace<CameraComponent>(_camera_entity);
 
@@ -61,13 +237,81 @@ void Scene::load(const std::filesystem::path& assets_path)
     load_player(assets_path);
     load_enemy(assets_path);
     load_bullet(assets_path);
+
+    report_memory();
 }
 
-entt::registry& Scene::get_registry()
+Registry& Scene::get_registry()
 {
     return _registry;
 }
 
+const ComponentArena& Scene::get_component_arena() const
+{
+    return _component_arena;
+}
+
+void Scene::reload(const std::filesystem::path& file_path)
+{
+    if (const auto texture = _resource_manager->get_texture_manager().reload_texture(file_path))
+    {
+        swap_texture(file_path, *texture);
+    }
+
+    if (file_path == _assets_path / "Player" / "Player.fbx")
+    {
+        reload_player(file_path);
+        report_memory();
+    }
+    else if (file_path == _assets_path / "Enemy" / "Enemy.fbx")
+    {
+        reload_enemy(file_path);
+        report_memory();
+    }
+}
+
+const AssetDependencyGraph& Scene::get_asset_graph() const
+{
+    return _asset_graph;
+}
+
+void Scene::report_memory()
+{
+    // storages with their sparse pages, what components keep on the heap is left out
+    const auto& arena = _component_arena.get_statistics();
+    set_tracked_memory(MemoryCategory::registry, arena.used + arena.heap_bytes);
+
+    // player animations live in the first importer, the enemy mesh in the second one
+    size_t animation_bytes = 0;
+    size_t importer_bytes = 0;
+    for (const auto* importer : {_importer1.get(), _importer2.get()})
+    {
+        aiMemoryInfo info;
+        importer->GetMemoryRequirements(info);
+        animation_bytes += info.animations;
+        importer_bytes += info.total - info.animations;
+    }
+    set_tracked_memory(MemoryCategory::animation, animation_bytes);
+    set_tracked_memory(MemoryCategory::importer, importer_bytes);
+}
+
+void Scene::enable_meshlet_culling(entt::entity entity)
+{
+    const auto& mesh = _registry.get<MeshComponent>(entity).mesh;
+    if (mesh.index_count == 0)
+    {
+        throw std::runtime_error("Scene::enable_meshlet_culling() mesh without index buffer");
+    }
+
+    auto& buffer_manager = _resource_manager->get_buffer_manager();
+    const auto positions = buffer_manager.get_buffer_view<float>(mesh.vertex_buffer.at(VertexAttribute::position));
+    const auto indices = buffer_manager.get_buffer_view<uint32_t>(mesh.index_buffer);
+
+    auto& meshlet_component = _registry.emplace_or_replace<MeshletComponent>(entity);
+    meshlet_component.meshlets = build_meshlets(positions.data, mesh.vertex_count, indices.data, mesh.index_count);
+    meshlet_component.visible_ranges.reserve(meshlet_component.meshlets.size());
+}
+
 entt::entity Scene::get_camera() const
 {
     return _camera_entity;
@@ -93,10 +337,36 @@ EntityPool& Scene::get_bullet_pool()
     return _bullet_pool;
 }
 
+EntityPool& Scene::get_chunk_pool()
+{
+    return _chunk_pool;
+}
+
+const EnemyPrefab& Scene::get_enemy_prefab() const
+{
+    return *_enemy_prefab;
+}
+
+const BulletPrefab& Scene::get_bullet_prefab() const
+{
+    return *_bullet_prefab;
+}
+
 void Scene::load_player(const std::filesystem::path& assets_path)
 {
     const std::filesystem::path player_path = assets_path / "Player";
-    auto source_scene = load_scene(_importer1, player_path / "Player.fbx");
+    auto source_scene = load_scene(*_importer1, _resource_manager->get_asset_storage(), player_path / "Player.fbx");
+    add_asset_file(player_path / "Player.fbx");
+
+    const auto textures_path = player_path / "Textures";
+    const std::vector<std::filesystem::path> texture_paths = {
+        textures_path / "Player_D.tga",
+        textures_path / "Player_M.tga",
+        textures_path / "Gun_D.tga",
+        textures_path / "Gun_M.tga"
+    };
+    TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
+    const auto player_textures = texture_manager.create_textures(texture_paths);
 
     {
         _player_entity = _registry.create();
@@ -109,15 +379,10 @@ void Scene::load_player(const std::filesystem::path& assets_path)
         auto& mesh_component = _registry.emplace<MeshComponent>(_player_entity);
         mesh_component.source_mesh = source_scene->mMeshes[0];
         mesh_component.has_shadow = true;
+        mesh_component.shadow_proxy_resolution = 24;
         mesh_component.is_visible = true;
         mesh_component.mesh.render_pass_type = RenderPassType::player;
 
-        const auto textures_path = player_path / "Textures";
-        auto& textures = mesh_component.mesh.material.textures;
-        TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
-        textures[MaterialTexture::diffuse] = texture_manager.create_texture(textures_path / "Player_D.tga");
-        textures[MaterialTexture::specular] = texture_manager.create_texture(textures_path / "Player_M.tga");
-
         auto& movement_component = _registry.emplace<MovementComponent>(_player_entity);
         movement_component.speed = 1.5f;
 
@@ -142,15 +407,10 @@ void Scene::load_player(const std::filesystem::path& assets_path)
         auto& mesh_component = _registry.emplace<MeshComponent>(_gun_entity);
         mesh_component.source_mesh = source_scene->mMeshes[1];
         mesh_component.has_shadow = true;
+        mesh_component.shadow_proxy_resolution = 16;
         mesh_component.is_visible = true;
         mesh_component.mesh.render_pass_type = RenderPassType::player;
 
-        const auto textures_path = player_path / "Textures";
-        auto& textures = mesh_component.mesh.material.textures;
-        TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
-        textures[MaterialTexture::diffuse] = texture_manager.create_texture(textures_path / "Gun_D.tga");
-        textures[MaterialTexture::specular] = texture_manager.create_texture(textures_path / "Gun_M.tga");
-
         auto& movement_component = _registry.emplace<MovementComponent>(_gun_entity);
         movement_component.speed = 1.5f;
 
@@ -159,174 +419,103 @@ void Scene::load_player(const std::filesystem::path& assets_path)
         transform_component.scale = {0.0044f, 0.0044f, 0.0044f};
         transform_component.euler_angles = {0.0f, 0.0f, 0.0f};
     }
+
+    add_texture(texture_paths[0], player_textures[0], MaterialTexture::diffuse, {_player_entity});
+    add_texture(texture_paths[1], player_textures[1], MaterialTexture::specular, {_player_entity});
+    add_texture(texture_paths[2], player_textures[2], MaterialTexture::diffuse, {_gun_entity});
+    add_texture(texture_paths[3], player_textures[3], MaterialTexture::specular, {_gun_entity});
 }
 
 void Scene::load_floor(const std::filesystem::path& assets_path)
 {
-    _floor_entity = _registry.create();
-
-    auto& mesh_component = _registry.emplace<MeshComponent>(_floor_entity);
-    mesh_component.is_visible = true;
-
-    const float floor_size = 100.0f;
-    const float tile_size = 1.0f;
-    const float num_tile_wraps = floor_size / tile_size;
-    const size_t vertex_count = 6;
+    // floor geometry is streamed by WorldStreamingSystem into these chunk slots
+    const auto floor_path = assets_path / "Floor";
+    TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
+    const std::vector<std::filesystem::path> texture_paths = {
+        floor_path / "Floor_D.psd",
+        floor_path / "Floor_N.psd",
+        floor_path / "Floor_M.psd"
+    };
+    const auto floor_textures = texture_manager.create_textures(texture_paths);
 
+    BufferManagerInterface& buffer_manager = _resource_manager->get_buffer_manager();
+    const size_t vertex_count = ChunkComponent::vertex_count;
+    for (auto entity : _chunk_pool.get_idle())
     {
-        std::array<float, 3 * vertex_count> position_buffer{
-            -floor_size / 2, 0.0f, -floor_size / 2,
-            -floor_size / 2, 0.0f, floor_size / 2,
-            floor_size / 2,  0.0f, floor_size / 2,
-            -floor_size / 2, 0.0f, -floor_size / 2,
-            floor_size / 2,  0.0f, floor_size / 2,
-            floor_size / 2,  0.0f, -floor_size / 2
-        };
+        auto& mesh_component = _registry.emplace<MeshComponent>(entity);
+        mesh_component.is_visible = false;
 
-        auto data = reinterpret_cast<const uint8_t*>(position_buffer.data());
-        BufferManagerInterface& buffer_manager = _resource_manager->get_buffer_manager();
-        auto index = buffer_manager.create_buffer(data, vertex_count * 3 * sizeof(float));
-        mesh_component.mesh.vertex_buffer[VertexAttribute::position] = index;
-    }
+        auto& mesh = mesh_component.mesh;
+        mesh.vertex_buffer[VertexAttribute::position] = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float), BufferUsage::vertex);
+        mesh.vertex_buffer[VertexAttribute::uv] = buffer_manager.create_buffer(vertex_count * 2 * sizeof(float), BufferUsage::vertex);
+        mesh.vertex_count = vertex_count;
+        mesh.render_pass_type = RenderPassType::floor;
 
-    {
-        std::array<float, 2 * vertex_count> uv_buffer{
-            0.0f, 0.0f,
-            num_tile_wraps, 0.0f,
-            num_tile_wraps, num_tile_wraps,
-            0.0f, 0.0f,
-            num_tile_wraps, num_tile_wraps,
-            0.0f, num_tile_wraps
-        };
+        auto& transform_component = _registry.emplace<TransformComponent>(entity);
+        transform_component.position = simd_float3{0.0f, 0.0f, 0.0f};
+        transform_component.scale = {1.0f, 1.0f, 1.0f};
+        transform_component.euler_angles = {0.0f, ChunkComponent::rotation, 0.0f};
 
-        auto data = reinterpret_cast<const uint8_t*>(uv_buffer.data());
-        BufferManagerInterface& buffer_manager = _resource_manager->get_buffer_manager();
-        auto index = buffer_manager.create_buffer(data, vertex_count * 2 * sizeof(float));
-        mesh_component.mesh.vertex_buffer[VertexAttribute::uv] = index;
+        _registry.emplace<ChunkComponent>(entity);
     }
-    mesh_component.mesh.vertex_count = vertex_count;
-    mesh_component.mesh.render_pass_type = RenderPassType::floor;
-
-    const auto floor_path = assets_path / "Floor";
-    auto& textures = mesh_component.mesh.material.textures;
-    TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
-    textures[MaterialTexture::diffuse] = texture_manager.create_texture(floor_path / "Floor_D.psd");
-    textures[MaterialTexture::normal] = texture_manager.create_texture(floor_path / "Floor_N.psd");
-    textures[MaterialTexture::specular] = texture_manager.create_texture(floor_path / "Floor_M.psd");
 
-    auto& transform_component = _registry.emplace<TransformComponent>(_floor_entity);
-    transform_component.position = simd_float3{0.0f, 0.0f, 0.0f};
-    transform_component.scale = {1.0f, 1.0f, 1.0f};
-    transform_component.euler_angles = {0.0f, 45.0f * math::radians, 0.0f};
+    const auto& chunks = _chunk_pool.get_idle();
+    add_texture(texture_paths[0], floor_textures[0], MaterialTexture::diffuse, chunks);
+    add_texture(texture_paths[1], floor_textures[1], MaterialTexture::normal, chunks);
+    add_texture(texture_paths[2], floor_textures[2], MaterialTexture::specular, chunks);
 }
 
 void Scene::load_enemy(const std::filesystem::path& assets_path)
 {
     auto& instanced_mesh_manager = _resource_manager->get_instanced_mesh_manager();
-    auto enemy_instanced_mesh = instanced_mesh_manager.create();
+    _enemy_instanced_mesh = instanced_mesh_manager.create();
 
-    auto& instanced_mesh = instanced_mesh_manager.get_mesh(enemy_instanced_mesh);
+    auto& instanced_mesh = instanced_mesh_manager.get_mesh(_enemy_instanced_mesh);
     instanced_mesh.mesh.render_pass_type = RenderPassType::enemy;
     auto& buffer_manager = _resource_manager->get_buffer_manager();
     const auto buffer_size = sizeof(simd_float4x4) * _max_enemy_count;
-    instanced_mesh.buffers[InstanceBufferType::transform] = buffer_manager.create_buffer(buffer_size);
-    instanced_mesh.buffers[InstanceBufferType::aim_rotation] = buffer_manager.create_buffer(buffer_size);
+    instanced_mesh.buffers[InstanceBufferType::transform] = buffer_manager.create_dynamic_buffer(buffer_size, BufferUsage::instance);
+    instanced_mesh.buffers[InstanceBufferType::aim_rotation] = buffer_manager.create_dynamic_buffer(buffer_size, BufferUsage::instance);
     instanced_mesh.count = 0;
     instanced_mesh.max_count = _max_enemy_count;
 
     const std::filesystem::path enemy_path = assets_path / "Enemy";
-    auto source_scene = load_scene(_importer2, enemy_path / "Enemy.fbx");
-
-    auto* source = source_scene->mMeshes[0];
-    auto& mesh = instanced_mesh.mesh;
-
-    const auto vertex_count = source->mNumVertices;
-    const auto position_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float));
-    mesh.vertex_buffer[VertexAttribute::position] = position_index;
-
-    const auto normal_index = buffer_manager.create_buffer(vertex_count * 3 * sizeof(float));
-    mesh.vertex_buffer[VertexAttribute::normal] = normal_index;
-
-    const auto uv_index = buffer_manager.create_buffer(vertex_count * 2 * sizeof(float));
-    mesh.vertex_buffer[VertexAttribute::uv] = uv_index;
-
-    auto position = buffer_manager.get_buffer_view<float>(position_index).data;
-    auto normal = buffer_manager.get_buffer_view<float>(normal_index).data;
-    auto uv = buffer_manager.get_buffer_view<float>(uv_index).data;
-    for (unsigned int i = 0; i < vertex_count; i++)
-    {
-        position[3 * i] = source->mVertices[i].x;
-        position[3 * i + 1] = source->mVertices[i].y;
-        position[3 * i + 2] = source->mVertices[i].z;
-
-        normal[3 * i] = source->mNormals[i].x;
-        normal[3 * i + 1] = source->mNormals[i].y;
-        normal[3 * i + 2] = source->mNormals[i].z;
-
-        if (source->mTextureCoords[0])
-        {
-            uv[2 * i] = source->mTextureCoords[0][i].x;
-            uv[2 * i + 1] = source->mTextureCoords[0][i].y;
-        }
-        else
-        {
-            uv[2 * i] = 0;
-            uv[2 * i + 1] = 0;
-        }
-    }
-    mesh.vertex_count = vertex_count;
+    auto source_scene = load_scene(*_importer2, _resource_manager->get_asset_storage(), enemy_path / "Enemy.fbx");
+    set_mesh_geometry(buffer_manager, instanced_mesh.mesh, source_scene->mMeshes[0]);
+    add_asset_file(enemy_path / "Enemy.fbx");
 
-    const auto index_count = 3 * source->mNumFaces;
-    const auto index = buffer_manager.create_buffer(index_count * sizeof(uint32_t));
-    mesh.index_buffer = index;
-    mesh.index_count = index_count;
-
-    auto view = buffer_manager.get_buffer_view<uint32_t>(index);
-    size_t p = 0;
-    for (unsigned int i = 0; i < source->mNumFaces; i++)
-    {
-        aiFace& face = source->mFaces[i];
-        for (unsigned int j = 0; j < face.mNumIndices; j++)
-        {
-            const unsigned int vertex_index = face.mIndices[j];
-            view.data[p++] = vertex_index;
-        }
-    }
-
-    const auto textures_path = enemy_path / "Textures";
-    auto& textures = mesh.material.textures;
+    const auto texture_path = enemy_path / "Textures" / "Enemy_D.png";
     TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
-    textures[MaterialTexture::diffuse] = texture_manager.create_texture(textures_path / "Enemy_D.png");
+    add_texture(texture_path, texture_manager.create_texture(texture_path), MaterialTexture::diffuse, {},
+                _enemy_instanced_mesh);
 
-    for (int i = 0; i < _max_enemy_count; i++)
-    {
-        auto entity = _enemy_pool.get_idle()[i];
+    TransformComponent transform_component;
+    transform_component.position = {0.0f, 0.0f, 0.0f};
+    transform_component.scale = {0.01f, 0.01f, 0.01f};
+    transform_component.euler_angles = {90.0f * math::radians, 0.0f, 180.0f * math::radians};
 
-        auto& transform_component = _registry.emplace<TransformComponent>(entity);
-        transform_component.position = {0.0f, 0.0f, 0.0f};
-        transform_component.scale = {0.01f, 0.01f, 0.01f};
-        transform_component.euler_angles = {90.0f * math::radians, 0.0f, 180.0f * math::radians};
+    InstancedMeshComponent instanced_mesh_component;
+    instanced_mesh_component.instanced_mesh = _enemy_instanced_mesh;
+    instanced_mesh_component.is_visible = false;
 
-        auto& instanced_mesh_component = _registry.emplace<InstancedMeshComponent>(entity);
-        instanced_mesh_component.instanced_mesh = enemy_instanced_mesh;
-        instanced_mesh_component.is_visible = false;
+    ColliderComponent collider_component;
+    collider_component.capsule = {0.4f, 0.08f};
 
-        auto& collider_component = _registry.emplace<ColliderComponent>(entity);
-        collider_component.capsule = {0.4f, 0.08f};
+    _enemy_prefab.emplace(transform_component, instanced_mesh_component, collider_component, MovementComponent{});
 
-        _registry.emplace<MovementComponent>(entity);
-    }
+    const auto& entities = _enemy_pool.get_idle();
+    _enemy_prefab->instantiate(_registry, entities.cbegin(), entities.cend());
 }
 
 void Scene::load_bullet(const std::filesystem::path& assets_path)
 {
     auto& instanced_mesh_manager = _resource_manager->get_instanced_mesh_manager();
-    auto mesh_index = instanced_mesh_manager.create();
-    auto& instanced_mesh = instanced_mesh_manager.get_mesh(mesh_index);
+    _bullet_instanced_mesh = instanced_mesh_manager.create();
+    auto& instanced_mesh = instanced_mesh_manager.get_mesh(_bullet_instanced_mesh);
 
     const auto buffer_size = sizeof(simd_float4x4) * _max_bullet_count;
     BufferManagerInterface& buffer_manager = _resource_manager->get_buffer_manager();
-    instanced_mesh.buffers[InstanceBufferType::transform] = buffer_manager.create_buffer(buffer_size);
+    instanced_mesh.buffers[InstanceBufferType::transform] = buffer_manager.create_dynamic_buffer(buffer_size, BufferUsage::instance);
     instanced_mesh.count = 0;
     instanced_mesh.max_count = _max_bullet_count;
 
@@ -342,7 +531,7 @@ void Scene::load_bullet(const std::filesystem::path& assets_path)
         };
 
         auto data = reinterpret_cast<const uint8_t*>(buffer.data());
-        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(float));
+        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(float), BufferUsage::vertex);
         instanced_mesh.mesh.vertex_buffer[VertexAttribute::position] = index;
     }
 
@@ -355,7 +544,7 @@ void Scene::load_bullet(const std::filesystem::path& assets_path)
         };
 
         auto data = reinterpret_cast<const uint8_t*>(buffer.data());
-        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(float));
+        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(float), BufferUsage::vertex);
         instanced_mesh.mesh.vertex_buffer[VertexAttribute::uv] = index;
     }
 
@@ -366,7 +555,7 @@ void Scene::load_bullet(const std::filesystem::path& assets_path)
         };
 
         auto data = reinterpret_cast<const uint8_t*>(buffer.data());
-        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(uint32_t));
+        auto index = buffer_manager.create_buffer(data, buffer.size() * sizeof(uint32_t), BufferUsage::index);
         instanced_mesh.mesh.index_buffer = index;
         instanced_mesh.mesh.index_count = buffer.size();
     }
@@ -375,28 +564,126 @@ void Scene::load_bullet(const std::filesystem::path& assets_path)
     instanced_mesh.mesh.render_pass_type = RenderPassType::bullet;
 
     const std::filesystem::path bullet_path = assets_path / "Bullet";
-    auto& mesh = instanced_mesh.mesh;
-    auto& textures = mesh.material.textures;
     TextureManagerInterface& texture_manager = _resource_manager->get_texture_manager();
-    textures[MaterialTexture::diffuse] = texture_manager.create_texture(bullet_path / "Bullet_D.png");
+    const auto region = texture_manager.create_texture_region(bullet_path / "Bullet_D.png");
+    instanced_mesh.mesh.material.uv_transform = region.uv_transform;
+    add_texture(bullet_path / "Bullet_D.png", region.texture, MaterialTexture::diffuse, {}, _bullet_instanced_mesh);
+
+    TransformComponent transform_component;
+    transform_component.position = {0.0f, 0.0f, 0.0f};
+    transform_component.scale = {1.0f, 1.0f, 1.0f};
+    transform_component.euler_angles = {0.0f, 0.0f, 0.0f};
+
+    InstancedMeshComponent instanced_mesh_component;
+    instanced_mesh_component.instanced_mesh = _bullet_instanced_mesh;
+    instanced_mesh_component.is_visible = false;
+
+    ColliderComponent collider_component;
+    collider_component.capsule = {0.3f, 0.03f};
+
+    _bullet_prefab.emplace(
+        transform_component,
+        instanced_mesh_component,
+        collider_component,
+        TimeComponent{},
+        MovementComponent{}
+    );
 
-    for (int i = 0; i < _max_bullet_count; i++)
+    const auto& entities = _bullet_pool.get_idle();
+    _bullet_prefab->instantiate(_registry, entities.cbegin(), entities.cend());
+}
+
+void Scene::reload_player(const std::filesystem::path& file_path)
+{
+    auto importer = std::make_unique<Assimp::Importer>();
+    auto source_scene = load_scene(*importer, _resource_manager->get_asset_storage(), file_path);
+
+    auto& animation_component = _registry.get<AnimationComponent>(_player_entity);
+    animation_component.animation = source_scene->mAnimations[0];
+    animation_component.root_node = source_scene->mRootNode;
+    animation_component.global_inv = source_scene->mRootNode->mTransformation.Inverse();
+
+    // PlayerAnimationSystem creates new buffers for meshes without them, previous buffers go
+    // back to their slabs once frames in flight are done
+    auto& buffer_manager = _resource_manager->get_buffer_manager();
+    const std::array<entt::entity, 2> entities = {_player_entity, _gun_entity};
+    for (size_t i = 0; i < entities.size(); i++)
     {
-        auto entity = _bullet_pool.get_idle()[i];
+        auto& mesh_component = _registry.get<MeshComponent>(entities[i]);
+        mesh_component.source_mesh = source_scene->mMeshes[i];
+        release_mesh_buffers(buffer_manager, mesh_component);
+        if (_registry.try_get<MeshletComponent>(entities[i]) != nullptr)
+        {
+            _registry.remove<MeshletComponent>(entities[i]);
+        }
+    }
 
-        auto& transform_component = _registry.emplace<TransformComponent>(entity);
-        transform_component.position = {0.0f, 0.0f, 0.0f};
-        transform_component.scale = {1.0f, 1.0f, 1.0f};
-        transform_component.euler_angles = {0.0f, 0.0f, 0.0f};
+    _importer1 = std::move(importer);
+}
 
-        auto& instanced_mesh_component = _registry.emplace<InstancedMeshComponent>(entity);
-        instanced_mesh_component.instanced_mesh = mesh_index;
-        instanced_mesh_component.is_visible = false;
+void Scene::reload_enemy(const std::filesystem::path& file_path)
+{
+    auto importer = std::make_unique<Assimp::Importer>();
+    auto source_scene = load_scene(*importer, _resource_manager->get_asset_storage(), file_path);
 
-        auto& collider_component = _registry.emplace<ColliderComponent>(entity);
-        collider_component.capsule = {0.3f, 0.03f};
+    auto& buffer_manager = _resource_manager->get_buffer_manager();
+    auto& instanced_mesh = _resource_manager->get_instanced_mesh_manager().get_mesh(_enemy_instanced_mesh);
+    release_mesh_buffers(buffer_manager, instanced_mesh.mesh);
+    set_mesh_geometry(buffer_manager, instanced_mesh.mesh, source_scene->mMeshes[0]);
+
+    _importer2 = std::move(importer);
+}
 
-        _registry.emplace<TimeComponent>(entity);
-        _registry.emplace<MovementComponent>(entity);
+void Scene::add_asset_file(const std::filesystem::path& file_path)
+{
+    // cooked pack is rebuilt when any loaded file changes, models get no edges to their textures,
+    // a changed texture is swapped in its slots without importing the model again
+    _asset_graph.add_dependency(_assets_path / AssetStorage::pack_file_name, file_path);
+}
+
+void Scene::add_texture(const std::filesystem::path& file_path, size_t texture, MaterialTexture slot,
+                        std::vector<entt::entity> entities, size_t instanced_mesh)
+{
+    _textures.push_back(SceneTexture{file_path, texture, slot, std::move(entities), instanced_mesh});
+    bind_texture(_textures.back());
+    add_asset_file(file_path);
+}
+
+void Scene::bind_texture(const SceneTexture& scene_texture)
+{
+    for (auto entity : scene_texture.entities)
+    {
+        _registry.get<MeshComponent>(entity).mesh.material.textures[scene_texture.slot] = scene_texture.texture;
+    }
+
+    if (scene_texture.instanced_mesh != invalid_handle)
+    {
+        auto& instanced_mesh = _resource_manager->get_instanced_mesh_manager().get_mesh(scene_texture.instanced_mesh);
+        instanced_mesh.mesh.material.textures[scene_texture.slot] = scene_texture.texture;
+    }
+}
+
+void Scene::swap_texture(const std::filesystem::path& file_path, size_t texture)
+{
+    // files which shared the content keep the previous texture and their slots
+    auto& texture_manager = _resource_manager->get_texture_manager();
+    bool is_taken = false;
+    for (auto& scene_texture : _textures)
+    {
+        if (scene_texture.path != file_path)
+        {
+            continue;
+        }
+
+        texture_manager.release_texture(scene_texture.texture);
+        // the copy comes with one reference, the path finds it for the rest
+        scene_texture.texture = is_taken ? texture_manager.create_texture(file_path) : texture;
+        is_taken = true;
+        bind_texture(scene_texture);
+    }
+
+    if (!is_taken)
+    {
+        texture_manager.release_texture(texture);
     }
 }
@@ -11,13 +11,20 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <assimp/Importer.hpp>
 #include <entt/entt.hpp>
 
+#include "asset_dependency_graph.hpp"
+#include "component_arena.hpp"
 #include "entity_pool.hpp"
+#include "mesh.hpp"
+#include "prefabs.hpp"
+#include "registry.hpp"
 #include "resource_manager.hpp"
+#include "slot_map.hpp"
 
 namespace angry
 {
@@ -25,8 +32,10 @@ namespace angry
 class Scene final
 {
 public:
-    explicit Scene(ResourceManager* resource_manager);
-    ~Scene() = default;
+    // `max_chunk_count` is the size of the floor chunk pool, see WorldStreamingSystem::get_max_chunk_count()
+    Scene(ResourceManager* resource_manager, size_t max_chunk_count);
+    // releases textures and mesh buffers, the resource manager has to outlive the scene
+    ~Scene();
 
     Scene(const Scene&) = delete;
     Scene(Scene&&) = delete;
@@ -34,7 +43,19 @@ public:
     Scene& operator=(Scene&&) = delete;
 
     void load(const std::filesystem::path& assets_path);
-    entt::registry& get_registry();
+    Registry& get_registry();
+    const ComponentArena& get_component_arena() const;
+
+    // re-imports a changed file in place, call between frames
+    void reload(const std::filesystem::path& file_path);
+    const AssetDependencyGraph& get_asset_graph() const;
+
+    // builds meshlets for CPU cluster culling, mesh buffers must already exist
+    void enable_meshlet_culling(entt::entity entity);
+
+    // samples registry and imported file memory into the current MemoryTracker, done after
+    // load and reload
+    void report_memory();
 
     entt::entity get_camera() const;
     entt::entity get_player() const;
@@ -42,30 +63,71 @@ public:
 
     EntityPool& get_enemy_pool();
     EntityPool& get_bullet_pool();
+    EntityPool& get_chunk_pool();
+
+    // valid after load()
+    const EnemyPrefab& get_enemy_prefab() const;
+    const BulletPrefab& get_bullet_prefab() const;
+
+private:
+    // a texture manager reference and the material slots it is bound to
+    struct SceneTexture
+    {
+        std::filesystem::path path;
+        size_t texture = 0;
+        MaterialTexture slot = MaterialTexture::diffuse;
+        std::vector<entt::entity> entities;
+        size_t instanced_mesh = invalid_handle;
+    };
 
 private:
+    void reserve_storages();
     void load_floor(const std::filesystem::path& assets_path);
     void load_player(const std::filesystem::path& assets_path);
     void load_enemy(const std::filesystem::path& assets_path);
     void load_bullet(const std::filesystem::path& assets_path);
 
+    void reload_player(const std::filesystem::path& file_path);
+    void reload_enemy(const std::filesystem::path& file_path);
+    void add_asset_file(const std::filesystem::path& file_path);
+
+    // takes the reference, binds it and tracks the file
+    void add_texture(const std::filesystem::path& file_path, size_t texture, MaterialTexture slot,
+                     std::vector<entt::entity> entities, size_t instanced_mesh = invalid_handle);
+    void bind_texture(const SceneTexture& scene_texture);
+    // `texture` is a copy made on reload, it replaces the references held through `file_path`
+    void swap_texture(const std::filesystem::path& file_path, size_t texture);
+
 private:
     const int _max_enemy_count = 16;
     const int _max_bullet_count = 16;
+    const size_t _max_chunk_count;
 
     ResourceManager* _resource_manager;
+    std::filesystem::path _assets_path;
+    AssetDependencyGraph _asset_graph;
 
-    Assimp::Importer _importer1;
-    Assimp::Importer _importer2;
+    // a new importer is swapped in only after successful reload
+    std::unique_ptr<Assimp::Importer> _importer1;
+    std::unique_ptr<Assimp::Importer> _importer2;
 
-    entt::registry _registry;
+    // storages live in the arena, it has to outlive the registry
+    ComponentArena _component_arena;
+    Registry _registry;
     entt::entity _camera_entity;
-    entt::entity _floor_entity;
     entt::entity _player_entity;
     entt::entity _gun_entity;
+    size_t _enemy_instanced_mesh = 0;
+    size_t _bullet_instanced_mesh = 0;
 
     EntityPool _enemy_pool;
     EntityPool _bullet_pool;
+    EntityPool _chunk_pool;
+
+    std::optional<EnemyPrefab> _enemy_prefab;
+    std::optional<BulletPrefab> _bullet_prefab;
+
+    std::vector<SceneTexture> _textures;
 };
 
 }
@@ -51,6 +51,8 @@ struct EnemyInstance
 struct BulletUniforms
 {
     float4x4 pv;
+    // atlas region, uv * xy + zw
+    float4 uv_transform;
 };
 
 struct BulletInstance
@@ -107,6 +107,23 @@ void ShadowMapManager::update(Scene& scene, id<MTLCommandBuffer> command_buffer)
 
     [command_encoder setRenderPipelineState:_render_state.get()];
 
+    // positions of meshes in the same slab only move the offset
+    id<MTLBuffer> bound_buffer = nil;
+    auto bind_vertex_buffer = [&](size_t buffer_index)
+    {
+        id<MTLBuffer> buffer = _buffer_manager->get_buffer(buffer_index);
+        const NSUInteger offset = _buffer_manager->get_buffer_offset(buffer_index);
+        if (buffer == bound_buffer)
+        {
+            [command_encoder setVertexBufferOffset:offset atIndex:0];
+        }
+        else
+        {
+            [command_encoder setVertexBuffer:buffer offset:offset atIndex:0];
+            bound_buffer = buffer;
+        }
+    };
+
     auto entity_view = scene.get_registry().view<MeshComponent>();
     for (auto entity : entity_view)
     {
@@ -121,12 +138,24 @@ void ShadowMapManager::update(Scene& scene, id<MTLCommandBuffer> command_buffer)
         _vertex_uniforms.model_matrix = transform_component.get_matrix();
         [command_encoder setVertexBytes:&_vertex_uniforms length:sizeof(DepthOnlyUniforms) atIndex:1];
 
+        if (mesh_component.shadow_proxy)
+        {
+            const auto& shadow_proxy = *mesh_component.shadow_proxy;
+            bind_vertex_buffer(shadow_proxy.vertex_buffer);
+
+            id<MTLBuffer> index_buffer = _buffer_manager->get_buffer(shadow_proxy.index_buffer);
+            [command_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                        indexCount:shadow_proxy.index_count
+                                         indexType:MTLIndexTypeUInt32
+                                       indexBuffer:index_buffer
+                                 indexBufferOffset:_buffer_manager->get_buffer_offset(shadow_proxy.index_buffer)];
+            continue;
+        }
+
         auto& mesh = mesh_component.mesh;
-        auto p = mesh.vertex_buffer.find(VertexAttribute::position);
-        if (p != mesh.vertex_buffer.end())
+        if (const auto* position = mesh.vertex_buffer.find(VertexAttribute::position))
         {
-            id<MTLBuffer> buffer = _buffer_manager->get_buffer(p->second);
-            [command_encoder setVertexBuffer:buffer offset:0 atIndex:0];
+            bind_vertex_buffer(*position);
         }
 
         if (mesh.index_count > 0)
@@ -136,7 +165,7 @@ void ShadowMapManager::update(Scene& scene, id<MTLCommandBuffer> command_buffer)
                                         indexCount:mesh.index_count
                                          indexType:MTLIndexTypeUInt32
                                        indexBuffer:index_buffer
-                                 indexBufferOffset:0];
+                                 indexBufferOffset:_buffer_manager->get_buffer_offset(mesh.index_buffer)];
         }
         else
         {
@@ -0,0 +1,171 @@
+//
+//  shadow_proxy.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "shadow_proxy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace angry;
+
+namespace
+{
+
+struct Cell
+{
+    std::array<float, 3> sum = {0.0f, 0.0f, 0.0f};
+    uint32_t count = 0;
+    uint32_t vertex = 0;
+    float distance = std::numeric_limits<float>::max();
+};
+
+uint64_t make_triangle_key(uint32_t a, uint32_t b, uint32_t c)
+{
+    // rotate smallest index first, winding is preserved
+    if (b < a && b < c)
+    {
+        std::swap(a, b);
+        std::swap(b, c);
+    }
+    else if (c < a && c < b)
+    {
+        std::swap(a, c);
+        std::swap(b, c);
+    }
+    return (uint64_t(a) << 42) | (uint64_t(b) << 21) | uint64_t(c);
+}
+
+}
+
+ShadowProxyGeometry angry::make_shadow_proxy_geometry(
+    const float* positions,
+    size_t vertex_count,
+    const uint32_t* indices,
+    size_t index_count,
+    unsigned int resolution
+)
+{
+    std::array<float, 3> min_point = {
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max()
+    };
+    std::array<float, 3> max_point = {
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest()
+    };
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            min_point[k] = std::min(min_point[k], positions[3 * i + k]);
+            max_point[k] = std::max(max_point[k], positions[3 * i + k]);
+        }
+    }
+
+    float extent = 0.0f;
+    for (size_t k = 0; k < 3; k++)
+    {
+        extent = std::max(extent, max_point[k] - min_point[k]);
+    }
+    const float cell_size = extent > 0.0f ? extent / std::max(resolution, 1u) : 1.0f;
+
+    const auto get_cell_key = [&](size_t vertex)
+    {
+        uint64_t key = 0;
+        for (size_t k = 0; k < 3; k++)
+        {
+            const auto c = static_cast<uint64_t>((positions[3 * vertex + k] - min_point[k]) / cell_size);
+            key = (key << 21) | std::min<uint64_t>(c, (1 << 21) - 1);
+        }
+        return key;
+    };
+
+    std::vector<uint64_t> vertex_cell(vertex_count);
+    std::unordered_map<uint64_t, Cell> cells;
+    cells.reserve(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        vertex_cell[i] = get_cell_key(i);
+        auto& cell = cells[vertex_cell[i]];
+        for (size_t k = 0; k < 3; k++)
+        {
+            cell.sum[k] += positions[3 * i + k];
+        }
+        cell.count += 1;
+    }
+
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        auto& cell = cells[vertex_cell[i]];
+        float distance = 0.0f;
+        for (size_t k = 0; k < 3; k++)
+        {
+            const float d = positions[3 * i + k] - cell.sum[k] / cell.count;
+            distance += d * d;
+        }
+
+        if (distance < cell.distance)
+        {
+            cell.distance = distance;
+            cell.vertex = static_cast<uint32_t>(i);
+        }
+    }
+
+    ShadowProxyGeometry result;
+    std::unordered_map<uint32_t, uint32_t> proxy_vertex;
+    proxy_vertex.reserve(cells.size());
+    const auto get_proxy_vertex = [&](uint32_t vertex)
+    {
+        const auto source = cells[vertex_cell[vertex]].vertex;
+        auto p = proxy_vertex.emplace(source, static_cast<uint32_t>(result.source_vertices.size()));
+        if (p.second)
+        {
+            result.source_vertices.push_back(source);
+        }
+        return p.first->second;
+    };
+
+    std::unordered_set<uint64_t> triangles;
+    for (size_t i = 0; i + 2 < index_count; i += 3)
+    {
+        const auto a = get_proxy_vertex(indices[i]);
+        const auto b = get_proxy_vertex(indices[i + 1]);
+        const auto c = get_proxy_vertex(indices[i + 2]);
+        if (a == b || b == c || a == c)
+        {
+            continue;
+        }
+
+        if (!triangles.insert(make_triangle_key(a, b, c)).second)
+        {
+            continue;
+        }
+
+        result.indices.push_back(a);
+        result.indices.push_back(b);
+        result.indices.push_back(c);
+    }
+
+    return result;
+}
+
+void angry::update_shadow_proxy_positions(const ShadowProxy& proxy, const float* positions, float* target)
+{
+    for (size_t i = 0; i < proxy.source_vertices.size(); i++)
+    {
+        const auto source = proxy.source_vertices[i];
+        target[3 * i] = positions[3 * source];
+        target[3 * i + 1] = positions[3 * source + 1];
+        target[3 * i + 2] = positions[3 * source + 2];
+    }
+}
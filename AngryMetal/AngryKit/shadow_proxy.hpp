@@ -0,0 +1,47 @@
+//
+//  shadow_proxy.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace angry
+{
+
+struct ShadowProxyGeometry
+{
+    // source vertex represented by every proxy vertex
+    std::vector<uint32_t> source_vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Position-only mesh used by the depth-only pass instead of the full mesh.
+struct ShadowProxy
+{
+    size_t vertex_buffer = 0;
+    size_t index_buffer = 0;
+    size_t index_count = 0;
+    std::vector<uint32_t> source_vertices;
+};
+
+// Vertex clustering: vertices are snapped to a uniform grid with `resolution` cells
+// along the longest side of the bounding box, every cell is represented by the source
+// vertex closest to the cell average and collapsed triangles are dropped.
+ShadowProxyGeometry make_shadow_proxy_geometry(
+    const float* positions,
+    size_t vertex_count,
+    const uint32_t* indices,
+    size_t index_count,
+    unsigned int resolution
+);
+
+// Copies positions of represented vertices, used when the source mesh is animated on CPU.
+void update_shadow_proxy_positions(const ShadowProxy& proxy, const float* positions, float* target);
+
+}
@@ -0,0 +1,316 @@
+//
+//  simulation_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "simulation_benchmark.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "allocation_counter.hpp"
+#include "asset_storage.hpp"
+#include "bullet_system.hpp"
+#include "camera_system.hpp"
+#include "cpu_buffer_manager.hpp"
+#include "cpu_texture_manager.hpp"
+#include "enemy_system.hpp"
+#include "frame_arena.hpp"
+#include "game_restart_system.hpp"
+#include "health_component.hpp"
+#include "input_component.hpp"
+#include "instanced_mesh_manager.hpp"
+#include "memory_tracker.hpp"
+#include "on_exit.hpp"
+#include "player_animation_system.hpp"
+#include "player_input_system.hpp"
+#include "resource_manager.hpp"
+#include "scene.hpp"
+#include "score_component.hpp"
+#include "shooting_system.hpp"
+#include "timer.hpp"
+#include "world_streaming_system.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+enum class SystemIndex
+{
+    game_restart,
+    player_input,
+    world_streaming,
+    shooting,
+    enemy,
+    camera,
+    player_animation,
+    bullet,
+    count
+};
+
+const std::array<const char*, size_t(SystemIndex::count)> system_names = {
+    "game_restart",
+    "player_input",
+    "world_streaming",
+    "shooting",
+    "enemy",
+    "camera",
+    "player_animation",
+    "bullet"
+};
+
+struct SystemTime
+{
+    double seconds = 0.0;
+    double max_seconds = 0.0;
+    size_t steady_allocations = 0;
+};
+
+struct SteadyState
+{
+    size_t frame_count = 0;
+    size_t allocating_frame_count = 0;
+    size_t first_allocating_frame = 0;
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t max_frame_allocations = 0;
+};
+
+struct PageFaults
+{
+    size_t minor = 0;
+    size_t major = 0;
+};
+
+// process wide, the benchmark thread is the only busy one
+PageFaults get_page_faults()
+{
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return PageFaults{size_t(usage.ru_minflt), size_t(usage.ru_majflt)};
+}
+
+AllocationCount get_difference(const AllocationCount& before, const AllocationCount& after)
+{
+    AllocationCount result;
+    result.count = after.count - before.count;
+    result.bytes = after.bytes - before.bytes;
+    result.free_count = after.free_count - before.free_count;
+    return result;
+}
+
+// what the play screen would write for touches on the move and fire buttons
+void update_input(Scene& scene, const Timer& timer)
+{
+    auto& input_component = scene.get_registry().get<InputComponent>(scene.get_player());
+    const float time = timer.get_time_since_start();
+
+    input_component.theta = std::fmod(time * 0.5f, 2.0f * float(M_PI));
+    input_component.direction = simd_float2{std::sin(input_component.theta), std::cos(input_component.theta)};
+    input_component.is_moving = std::fmod(time, 4.0f) < 2.0f;
+    input_component.is_shooting = true;
+}
+
+}
+
+void angry::run_simulation_benchmark(const SimulationBenchmarkSettings& settings, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (settings.require_zero_allocations && !is_allocation_counting_enabled())
+    {
+        throw std::runtime_error("run_simulation_benchmark() allocations are not counted in this build");
+    }
+
+    // resources report to it until the scene and the managers are gone
+    MemoryTracker memory_tracker;
+    MemoryTracker::set_current(&memory_tracker);
+    OnExit uninstall_tracker([]() { MemoryTracker::set_current(nullptr); });
+
+    AssetStorage asset_storage(settings.assets_path);
+    CpuBufferManager buffer_manager;
+    InstancedMeshManager instanced_mesh_manager;
+    FrameArena frame_arena(FrameArena::Settings{});
+    CpuTextureManager texture_manager(asset_storage);
+    ResourceManager resource_manager(buffer_manager, instanced_mesh_manager, texture_manager, asset_storage);
+
+    const auto load_faults = get_page_faults();
+    const auto load_start = Clock::now();
+    const WorldStreamingSystem::Settings world_streaming_settings;
+    Scene scene(&resource_manager, WorldStreamingSystem::get_max_chunk_count(world_streaming_settings));
+    scene.load(settings.assets_path);
+
+    WorldStreamingSystem world_streaming_system(buffer_manager, world_streaming_settings);
+    world_streaming_system.load(scene);
+    const double load_seconds = std::chrono::duration<double>(Clock::now() - load_start).count();
+    const auto run_faults = get_page_faults();
+
+    GameRestartSystem game_restart_system;
+    PlayerInputSystem player_input_system;
+    ShootingSystem shooting_system;
+    EnemySystem enemy_system;
+    CameraSystem camera_system;
+    PlayerAnimationSystem player_animation_system(buffer_manager, frame_arena);
+    BulletSystem bullet_system;
+
+    std::array<SystemTime, size_t(SystemIndex::count)> times;
+    bool is_steady = false;
+    const auto measure = [&](SystemIndex index, const auto& update) {
+        const auto allocations_start = get_thread_allocation_count();
+        const auto start = Clock::now();
+        update();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const size_t allocations = get_difference(allocations_start, get_thread_allocation_count()).count;
+        auto& time = times[size_t(index)];
+        time.seconds += seconds;
+        time.max_seconds = std::max(time.max_seconds, seconds);
+        if (is_steady)
+        {
+            time.steady_allocations += allocations;
+        }
+    };
+
+    Timer timer;
+    size_t restart_count = 0;
+    int best_score = 0;
+    double max_frame_seconds = 0.0;
+    SteadyState steady_state;
+    const auto allocations_before = get_thread_allocation_count();
+    const auto start = Clock::now();
+    for (size_t frame = 0; frame < settings.frame_count; frame++)
+    {
+        const auto frame_start = Clock::now();
+        const auto frame_allocations_start = get_thread_allocation_count();
+        is_steady = frame >= settings.warmup_frame_count;
+        buffer_manager.begin_frame();
+
+        // the game over screen restarts on a tap, here it happens right away
+        auto& registry = scene.get_registry();
+        auto& input_component = registry.get<InputComponent>(scene.get_player());
+        if (registry.get<HealthComponent>(scene.get_player()).health == 0 && !input_component.is_restarting)
+        {
+            best_score = std::max(best_score, registry.get<ScoreComponent>(scene.get_player()).score);
+            input_component.is_restarting = true;
+            restart_count += 1;
+        }
+        update_input(scene, timer);
+
+        // same order as Game.mm
+        const float delta_time = timer.get_delta_time();
+        measure(SystemIndex::game_restart, [&]() { game_restart_system.update(scene, delta_time); });
+        measure(SystemIndex::player_input, [&]() { player_input_system.update(scene, delta_time); });
+        measure(SystemIndex::world_streaming, [&]() { world_streaming_system.update(scene); });
+        measure(SystemIndex::shooting, [&]() { shooting_system.update(scene, timer); });
+        measure(SystemIndex::enemy, [&]() { enemy_system.update(scene, delta_time); });
+        measure(SystemIndex::camera, [&]() { camera_system.update(scene, settings.aspect); });
+        measure(SystemIndex::player_animation, [&]() { player_animation_system.update(scene, timer.get_time_since_start()); });
+        measure(SystemIndex::bullet, [&]() { bullet_system.update(scene, timer); });
+
+        // no GPU here, a frame is done one frame later as if it was rendered while the next one
+        // was recorded
+        buffer_manager.end_frame();
+        if (frame > 0)
+        {
+            buffer_manager.complete_frame();
+        }
+        frame_arena.reset();
+
+        if (is_steady)
+        {
+            const auto frame_allocations = get_difference(frame_allocations_start, get_thread_allocation_count());
+            const size_t allocations = frame_allocations.count;
+            steady_state.frame_count += 1;
+            steady_state.allocations += allocations;
+            steady_state.frees += frame_allocations.free_count;
+            steady_state.max_frame_allocations = std::max(steady_state.max_frame_allocations, allocations);
+            if (allocations > 0 && steady_state.allocating_frame_count++ == 0)
+            {
+                steady_state.first_allocating_frame = frame;
+            }
+        }
+
+        timer.advance(settings.delta_time);
+        max_frame_seconds = std::max(max_frame_seconds, std::chrono::duration<double>(Clock::now() - frame_start).count());
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const auto allocations_after = get_thread_allocation_count();
+    const auto end_faults = get_page_faults();
+    best_score = std::max(best_score, scene.get_registry().get<ScoreComponent>(scene.get_player()).score);
+
+    const double frame_count = double(std::max(settings.frame_count, size_t(1)));
+    output << "{\"frame_count\": " << settings.frame_count
+        << ", \"delta_time\": " << settings.delta_time
+        << ", \"load_seconds\": " << load_seconds
+        << ", \"seconds\": " << seconds
+        << ", \"frame_ms_mean\": " << seconds * 1000.0 / frame_count
+        << ", \"frame_ms_max\": " << max_frame_seconds * 1000.0
+        << ", \"restarts\": " << restart_count
+        << ", \"best_score\": " << best_score
+        << ", \"allocations_counted\": " << (is_allocation_counting_enabled() ? "true" : "false")
+        << ", \"allocations\": " << allocations_after.count - allocations_before.count
+        << ", \"allocated_bytes\": " << allocations_after.bytes - allocations_before.bytes
+        << ", \"steady_state\": {\"frames\": " << steady_state.frame_count
+        << ", \"allocating_frames\": " << steady_state.allocating_frame_count
+        << ", \"allocations\": " << steady_state.allocations
+        << ", \"frees\": " << steady_state.frees
+        << ", \"max_frame_allocations\": " << steady_state.max_frame_allocations << "}"
+        << ", \"page_faults\": {\"load_minor\": " << run_faults.minor - load_faults.minor
+        << ", \"load_major\": " << run_faults.major - load_faults.major
+        << ", \"run_minor\": " << end_faults.minor - run_faults.minor
+        << ", \"run_major\": " << end_faults.major - run_faults.major << "}";
+
+    const auto& buffers = buffer_manager.get_statistics();
+    output << ", \"buffers\": {\"slabs\": " << buffers.slab_count
+        << ", \"slab_bytes\": " << buffers.slab_bytes
+        << ", \"allocations\": " << buffers.allocation_count
+        << ", \"allocated_bytes\": " << buffers.allocated_bytes
+        << ", \"dedicated_slabs\": " << buffers.dedicated_slab_count
+        << ", \"dedicated_bytes\": " << buffers.dedicated_bytes << "}";
+
+    const auto& frame_ring = buffer_manager.get_frame_ring();
+    output << ", \"frame_ring\": {\"frames_in_flight\": " << frame_ring.get_frame_count()
+        << ", \"bytes\": " << frame_ring.get_size()
+        << ", \"max_frame_used\": " << frame_ring.get_statistics().max_frame_used
+        << ", \"grows\": " << frame_ring.get_statistics().grow_count << "}";
+
+    const auto& components = scene.get_component_arena().get_statistics();
+    output << ", \"component_arena\": {\"bytes\": " << components.capacity
+        << ", \"used\": " << components.used
+        << ", \"heap_allocations\": " << components.heap_count
+        << ", \"heap_bytes\": " << components.heap_bytes << "}";
+
+    const auto& arena = frame_arena.get_statistics();
+    output << ", \"frame_arena\": {\"bytes\": " << arena.capacity
+        << ", \"max_used\": " << arena.max_used
+        << ", \"overflows\": " << arena.overflow_count << "}";
+
+    scene.report_memory();
+    output << ", \"memory\": ";
+    memory_tracker.write_json(output);
+    output << ", \"systems\": [";
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        output << (i == 0 ? "" : ", ")
+            << "{\"name\": \"" << system_names[i]
+            << "\", \"ms_mean\": " << times[i].seconds * 1000.0 / frame_count
+            << ", \"ms_max\": " << times[i].max_seconds * 1000.0
+            << ", \"steady_allocations\": " << times[i].steady_allocations << "}";
+    }
+    output << "]}\n";
+
+    if (settings.require_zero_allocations && steady_state.allocating_frame_count > 0)
+    {
+        throw std::runtime_error("run_simulation_benchmark() " + std::to_string(steady_state.allocations)
+            + " allocations in " + std::to_string(steady_state.allocating_frame_count)
+            + " steady state frames, first in frame " + std::to_string(steady_state.first_allocating_frame));
+    }
+}
@@ -0,0 +1,36 @@
+//
+//  simulation_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+
+namespace angry
+{
+
+struct SimulationBenchmarkSettings
+{
+    std::filesystem::path assets_path;
+    // one minute of game time at the default step, raise it for soak runs
+    size_t frame_count = 3600;
+    float delta_time = 1.0f / 60.0f;
+    float aspect = 16.0f / 9.0f;
+    // frames after these are steady state, pools and arenas have grown to what the game needs
+    size_t warmup_frame_count = 120;
+    // throws if a steady state frame allocates, needs a build with ANGRY_COUNT_ALLOCATIONS
+    bool require_zero_allocations = false;
+};
+
+// Loads the scene against the CPU resource backend and runs every game system with a fixed
+// step and scripted input: the player turns, walks in bursts and keeps shooting, and restarts
+// after dying. Writes per-system update time and allocations, page faults, restarts, score,
+// slab, frame ring, component and frame arena and memory use as JSON.
+void run_simulation_benchmark(const SimulationBenchmarkSettings& settings, std::ostream& output);
+
+}
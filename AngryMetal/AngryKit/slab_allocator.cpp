@@ -0,0 +1,137 @@
+//
+//  slab_allocator.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "slab_allocator.hpp"
+
+#include <stdexcept>
+
+using namespace angry;
+
+namespace
+{
+
+bool is_power_of_two(size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+}
+
+SlabAllocator::SlabAllocator(const Settings& settings) : _settings(settings)
+{
+    if (!is_power_of_two(settings.min_class_size)
+        || !is_power_of_two(settings.max_class_size)
+        || settings.min_class_size > settings.max_class_size
+        || settings.max_class_size > settings.slab_size)
+    {
+        throw std::runtime_error("SlabAllocator::SlabAllocator() class sizes are not powers of two up to slab size");
+    }
+
+    _classes.resize(get_class_index(settings.max_class_size) + 1);
+}
+
+SlabAllocator::Allocation SlabAllocator::allocate(size_t size, bool& is_new_slab)
+{
+    is_new_slab = false;
+    _statistics.allocation_count += 1;
+
+    if (size > _settings.max_class_size)
+    {
+        const size_t slab_size = (size + _settings.min_class_size - 1) / _settings.min_class_size * _settings.min_class_size;
+        is_new_slab = true;
+        _statistics.allocated_bytes += slab_size;
+        return Allocation{add_slab(slab_size, true), 0, slab_size};
+    }
+
+    const size_t class_index = get_class_index(size);
+    const size_t class_size = _settings.min_class_size << class_index;
+    _statistics.allocated_bytes += class_size;
+
+    auto& size_class = _classes[class_index];
+    if (!size_class.free_blocks.empty())
+    {
+        const Allocation result = size_class.free_blocks.back();
+        size_class.free_blocks.pop_back();
+        return result;
+    }
+
+    // blocks which were never used come from the rest of the last slab of the class
+    if (!size_class.slab || size_class.next_offset + class_size > _settings.slab_size)
+    {
+        size_class.slab = add_slab(_settings.slab_size, false);
+        size_class.next_offset = 0;
+        is_new_slab = true;
+    }
+
+    const Allocation result{*size_class.slab, size_class.next_offset, class_size};
+    size_class.next_offset += class_size;
+    return result;
+}
+
+bool SlabAllocator::release(const Allocation& allocation)
+{
+    _statistics.allocation_count -= 1;
+    _statistics.allocated_bytes -= allocation.capacity;
+
+    auto& slab = _slabs[allocation.slab];
+    if (!slab.is_dedicated)
+    {
+        // class slabs are kept, a level with many meshes tends to come back
+        _classes[get_class_index(allocation.capacity)].free_blocks.push_back(allocation);
+        return false;
+    }
+
+    _statistics.slab_count -= 1;
+    _statistics.slab_bytes -= slab.size;
+    _statistics.dedicated_slab_count -= 1;
+    _statistics.dedicated_bytes -= slab.size;
+    slab = Slab();
+    _free_slabs.push_back(allocation.slab);
+    return true;
+}
+
+size_t SlabAllocator::get_slab_size(size_t slab) const
+{
+    return _slabs[slab].size;
+}
+
+const SlabAllocator::Statistics& SlabAllocator::get_statistics() const
+{
+    return _statistics;
+}
+
+size_t SlabAllocator::get_class_index(size_t size) const
+{
+    size_t result = 0;
+    while ((_settings.min_class_size << result) < size)
+    {
+        result += 1;
+    }
+    return result;
+}
+
+size_t SlabAllocator::add_slab(size_t size, bool is_dedicated)
+{
+    _statistics.slab_count += 1;
+    _statistics.slab_bytes += size;
+    if (is_dedicated)
+    {
+        _statistics.dedicated_slab_count += 1;
+        _statistics.dedicated_bytes += size;
+    }
+
+    if (!_free_slabs.empty())
+    {
+        const size_t result = _free_slabs.back();
+        _free_slabs.pop_back();
+        _slabs[result] = Slab{size, is_dedicated};
+        return result;
+    }
+
+    _slabs.push_back(Slab{size, is_dedicated});
+    return _slabs.size() - 1;
+}
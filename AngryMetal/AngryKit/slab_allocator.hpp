@@ -0,0 +1,95 @@
+//
+//  slab_allocator.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace angry
+{
+
+// Carves buffers out of big slabs. Sizes up to `max_class_size` are rounded up to a power of
+// two class and share slabs of that class, bigger ones get a slab of their own. Only slab
+// indices and offsets live here, buffer managers own the memory.
+class SlabAllocator final
+{
+public:
+    struct Settings
+    {
+        // every class slab holds at least 8 blocks of the biggest class
+        size_t slab_size = 1024 * 1024;
+        // smallest class, every offset is aligned to it
+        size_t min_class_size = 256;
+        size_t max_class_size = 128 * 1024;
+    };
+
+    struct Allocation
+    {
+        size_t slab = 0;
+        size_t offset = 0;
+        // class size, or the slab size for a slab of its own
+        size_t capacity = 0;
+    };
+
+    struct Statistics
+    {
+        size_t slab_count = 0;
+        size_t slab_bytes = 0;
+        size_t allocation_count = 0;
+        // capacity of live allocations, the rest of slab bytes is free or rounding
+        size_t allocated_bytes = 0;
+        // slabs of one allocation each, part of the slab totals
+        size_t dedicated_slab_count = 0;
+        size_t dedicated_bytes = 0;
+    };
+
+public:
+    explicit SlabAllocator(const Settings& settings);
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator(SlabAllocator&&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(SlabAllocator&&) = delete;
+
+    // `is_new_slab` asks the manager to create memory of `get_slab_size` for the slab index,
+    // indices of released slabs are used again
+    Allocation allocate(size_t size, bool& is_new_slab);
+    // true when the allocation had a slab of its own, the manager frees its memory
+    bool release(const Allocation& allocation);
+
+    size_t get_slab_size(size_t slab) const;
+    const Statistics& get_statistics() const;
+
+private:
+    struct Slab
+    {
+        size_t size = 0;
+        bool is_dedicated = false;
+    };
+
+    struct SizeClass
+    {
+        // released blocks, the last one is taken first
+        std::vector<Allocation> free_blocks;
+        std::optional<size_t> slab;
+        size_t next_offset = 0;
+    };
+
+    size_t get_class_index(size_t size) const;
+    size_t add_slab(size_t size, bool is_dedicated);
+
+private:
+    const Settings _settings;
+    std::vector<Slab> _slabs;
+    std::vector<size_t> _free_slabs;
+    std::vector<SizeClass> _classes;
+    Statistics _statistics;
+};
+
+}
@@ -0,0 +1,170 @@
+//
+//  slot_map.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace angry
+{
+
+// Resource handles stay plain size_t: the slot in the low 32 bits, its generation in the high
+// ones. Generations start at 1, so a zero initialized handle never resolves.
+static_assert(sizeof(size_t) == sizeof(uint64_t), "handles need 64 bit size_t");
+
+constexpr size_t invalid_handle = 0;
+
+constexpr size_t make_handle(uint32_t slot, uint32_t generation)
+{
+    return (size_t(generation) << 32) | slot;
+}
+
+constexpr uint32_t get_handle_slot(size_t handle)
+{
+    return uint32_t(handle);
+}
+
+constexpr uint32_t get_handle_generation(size_t handle)
+{
+    return uint32_t(handle >> 32);
+}
+
+// Values are kept packed for iteration, slots point into them. A released slot is reused
+// with the next generation, so handles to the old value stop resolving instead of reaching
+// whatever took its place.
+template<typename T>
+class SlotMap final
+{
+public:
+    using ValueArray = std::vector<T>;
+
+public:
+    SlotMap() = default;
+
+    SlotMap(const SlotMap&) = delete;
+    SlotMap(SlotMap&&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+    SlotMap& operator=(SlotMap&&) = delete;
+
+    size_t insert(T value)
+    {
+        const size_t handle = get_next_handle();
+        const uint32_t slot = get_handle_slot(handle);
+        if (slot == _slots.size())
+        {
+            _slots.push_back(Slot{});
+        }
+        else
+        {
+            _free_slots.pop_back();
+        }
+
+        _slots[slot].value = uint32_t(_values.size());
+        _values.push_back(std::move(value));
+        _value_slots.push_back(slot);
+        return handle;
+    }
+
+    // what `insert` returns next, for values which have to know their handle while they are made
+    size_t get_next_handle() const
+    {
+        if (!_free_slots.empty())
+        {
+            const uint32_t slot = _free_slots.back();
+            return make_handle(slot, _slots[slot].generation);
+        }
+        return make_handle(uint32_t(_slots.size()), 1);
+    }
+
+    bool contains(size_t handle) const
+    {
+        const uint32_t slot = get_handle_slot(handle);
+        return slot < _slots.size()
+            && _slots[slot].generation == get_handle_generation(handle)
+            && _slots[slot].value != free_value;
+    }
+
+    T& get(size_t handle)
+    {
+        return _values[get_value_index(handle)];
+    }
+
+    const T& get(size_t handle) const
+    {
+        return _values[get_value_index(handle)];
+    }
+
+    // the last value takes the place of the erased one
+    T erase(size_t handle)
+    {
+        const uint32_t index = get_value_index(handle);
+        T result = std::move(_values[index]);
+
+        const uint32_t last = uint32_t(_values.size() - 1);
+        if (index != last)
+        {
+            _values[index] = std::move(_values[last]);
+            _value_slots[index] = _value_slots[last];
+            _slots[_value_slots[index]].value = index;
+        }
+        _values.pop_back();
+        _value_slots.pop_back();
+
+        auto& slot = _slots[get_handle_slot(handle)];
+        slot.value = free_value;
+        slot.generation = slot.generation == UINT32_MAX ? 1 : slot.generation + 1;
+        _free_slots.push_back(get_handle_slot(handle));
+        return result;
+    }
+
+    // live values in no particular order, insert and erase move them
+    ValueArray& get_values()
+    {
+        return _values;
+    }
+
+    const ValueArray& get_values() const
+    {
+        return _values;
+    }
+
+    size_t size() const
+    {
+        return _values.size();
+    }
+
+private:
+    static constexpr uint32_t free_value = UINT32_MAX;
+
+    struct Slot
+    {
+        uint32_t value = free_value;
+        uint32_t generation = 1;
+    };
+
+    uint32_t get_value_index(size_t handle) const
+    {
+        if (!contains(handle))
+        {
+            throw std::runtime_error("SlotMap::get() handle was released or never created");
+        }
+        return _slots[get_handle_slot(handle)].value;
+    }
+
+private:
+    ValueArray _values;
+    std::vector<uint32_t> _value_slots;
+    std::vector<Slot> _slots;
+    // the last one is reused first
+    std::vector<uint32_t> _free_slots;
+};
+
+}
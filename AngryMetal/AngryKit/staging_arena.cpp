@@ -0,0 +1,148 @@
+//
+//  staging_arena.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "staging_arena.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace angry;
+
+namespace
+{
+
+// every allocation is preceded by its size, padded to keep the alignment
+const size_t header_size = StagingArena::alignment;
+
+size_t align_size(size_t size)
+{
+    return (size + StagingArena::alignment - 1) & ~(StagingArena::alignment - 1);
+}
+
+}
+
+StagingArena::StagingArena(size_t block_size) : _block_size(block_size)
+{
+}
+
+void* StagingArena::allocate(size_t size)
+{
+    const size_t required = header_size + align_size(size);
+    if (_blocks.empty() || _blocks.back().used + required > _blocks.back().capacity)
+    {
+        add_block(std::max(_block_size, required));
+    }
+
+    auto& block = _blocks.back();
+    uint8_t* result = block.data.get() + block.used + header_size;
+    block.used += required;
+
+    set_size(result, size);
+    _last = result;
+    return result;
+}
+
+void* StagingArena::reallocate(void* pointer, size_t size)
+{
+    if (pointer == nullptr)
+    {
+        return allocate(size);
+    }
+
+    const size_t old_size = get_size(pointer);
+    if (size <= old_size || try_grow(pointer, size))
+    {
+        return pointer;
+    }
+
+    void* result = allocate(size);
+    std::memcpy(result, pointer, old_size);
+    return result;
+}
+
+bool StagingArena::try_grow(void* pointer, size_t size)
+{
+    if (pointer == nullptr || pointer != _last)
+    {
+        return false;
+    }
+
+    auto& block = _blocks.back();
+    const size_t offset = _last - block.data.get();
+    if (offset + align_size(size) > block.capacity)
+    {
+        return false;
+    }
+
+    block.used = offset + align_size(size);
+    set_size(pointer, size);
+    return true;
+}
+
+void StagingArena::release(void* pointer)
+{
+    if (pointer != nullptr && pointer == _last)
+    {
+        _blocks.back().used = _last - _blocks.back().data.get() - header_size;
+        _last = nullptr;
+    }
+}
+
+bool StagingArena::contains(const void* pointer) const
+{
+    const auto* p = static_cast<const uint8_t*>(pointer);
+    return std::any_of(_blocks.cbegin(), _blocks.cend(), [p](const Block& block) {
+        return p >= block.data.get() && p < block.data.get() + block.capacity;
+    });
+}
+
+void StagingArena::reset()
+{
+    if (_blocks.size() > 1)
+    {
+        const size_t capacity = get_capacity();
+        _blocks.clear();
+        add_block(capacity);
+    }
+
+    if (!_blocks.empty())
+    {
+        _blocks.back().used = 0;
+    }
+    _last = nullptr;
+}
+
+size_t StagingArena::get_capacity() const
+{
+    size_t result = 0;
+    for (const auto& block : _blocks)
+    {
+        result += block.capacity;
+    }
+    return result;
+}
+
+size_t StagingArena::get_size(const void* pointer)
+{
+    size_t result = 0;
+    std::memcpy(&result, static_cast<const uint8_t*>(pointer) - header_size, sizeof(result));
+    return result;
+}
+
+void StagingArena::set_size(void* pointer, size_t size)
+{
+    std::memcpy(static_cast<uint8_t*>(pointer) - header_size, &size, sizeof(size));
+}
+
+void StagingArena::add_block(size_t capacity)
+{
+    Block block;
+    // not value initialized, pixels overwrite it anyway
+    block.data.reset(new uint8_t[capacity]);
+    block.capacity = capacity;
+    _blocks.push_back(std::move(block));
+}
@@ -0,0 +1,65 @@
+//
+//  staging_arena.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace angry
+{
+
+// Bump allocator for decoded pixels, memory is returned all at once by `reset`.
+// Not thread safe, use one arena per thread.
+class StagingArena final
+{
+public:
+    static constexpr size_t alignment = 16;
+
+    explicit StagingArena(size_t block_size = 4 * 1024 * 1024);
+
+    StagingArena(const StagingArena&) = delete;
+    StagingArena(StagingArena&&) = delete;
+    StagingArena& operator=(const StagingArena&) = delete;
+    StagingArena& operator=(StagingArena&&) = delete;
+
+    void* allocate(size_t size);
+    void* reallocate(void* pointer, size_t size);
+
+    // only the last allocation can grow in place or give its memory back
+    bool try_grow(void* pointer, size_t size);
+    void release(void* pointer);
+
+    bool contains(const void* pointer) const;
+
+    // keeps capacity, several blocks are merged into one
+    void reset();
+
+    size_t get_capacity() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    static size_t get_size(const void* pointer);
+    static void set_size(void* pointer, size_t size);
+
+    void add_block(size_t capacity);
+
+private:
+    size_t _block_size;
+    std::vector<Block> _blocks;
+    uint8_t* _last = nullptr;
+};
+
+}
@@ -0,0 +1,189 @@
+//
+//  texture_atlas.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "mipmap.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+struct Cell
+{
+    size_t page = 0;
+    int x = 0;
+    int y = 0;
+};
+
+int align_up(int value, int alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void copy_image(const AtlasImage& image, int gutter, int x, int y, AtlasPage& page)
+{
+    uint8_t* target = page.pixels.data();
+    for (int j = -gutter; j < image.height + gutter; j++)
+    {
+        const int source_y = std::clamp(j, 0, image.height - 1);
+        const uint8_t* source_row = image.data + size_t(source_y) * size_t(image.width) * size_t(image.components);
+        uint8_t* target_row = target + (size_t(y + j) * size_t(page.width) + size_t(x)) * 4;
+        for (int i = -gutter; i < image.width + gutter; i++)
+        {
+            const uint8_t* p = source_row + size_t(std::clamp(i, 0, image.width - 1)) * size_t(image.components);
+            uint8_t* q = target_row + i * 4;
+            if (image.components == 4)
+            {
+                std::memcpy(q, p, 4);
+            }
+            else
+            {
+                q[0] = p[0];
+                q[1] = p[0];
+                q[2] = p[0];
+                q[3] = 255;
+            }
+        }
+    }
+}
+
+}
+
+size_t angry::get_atlas_level_count(const AtlasSettings& settings)
+{
+    size_t result = 1;
+    for (int gutter = settings.gutter; gutter >= 4; gutter /= 2)
+    {
+        result += 1;
+    }
+    return result;
+}
+
+Atlas angry::build_atlas(const std::vector<AtlasImage>& images, const AtlasSettings& settings)
+{
+    const size_t level_count = get_atlas_level_count(settings);
+    // cells start on texel boundaries of the last level
+    const int alignment = 1 << (level_count - 1);
+    const int gutter = settings.gutter;
+
+    for (const auto& image : images)
+    {
+        if (image.components != 1 && image.components != 4)
+        {
+            std::stringstream t;
+            t << "build_atlas() unsupported number of components " << image.components;
+            throw std::runtime_error(t.str());
+        }
+    }
+
+    // tall images first keep shelves dense
+    std::vector<size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return images[a].height > images[b].height;
+    });
+
+    Atlas atlas;
+    std::vector<Cell> cells(images.size());
+    int shelf_x = 0;
+    int shelf_y = 0;
+    int shelf_height = 0;
+    for (auto index : order)
+    {
+        const auto& image = images[index];
+        const int width = align_up(image.width + 2 * gutter, alignment);
+        const int height = align_up(image.height + 2 * gutter, alignment);
+        if (width > settings.max_page_size || height > settings.max_page_size)
+        {
+            std::stringstream t;
+            t << "build_atlas() image " << image.width << "x" << image.height << " does not fit into a page";
+            throw std::runtime_error(t.str());
+        }
+
+        if (atlas.pages.empty())
+        {
+            atlas.pages.emplace_back();
+        }
+
+        if (shelf_x + width > settings.max_page_size)
+        {
+            shelf_x = 0;
+            shelf_y += shelf_height;
+            shelf_height = 0;
+        }
+
+        if (shelf_y + height > settings.max_page_size)
+        {
+            atlas.pages.emplace_back();
+            shelf_x = 0;
+            shelf_y = 0;
+            shelf_height = 0;
+        }
+
+        cells[index] = Cell{atlas.pages.size() - 1, shelf_x + gutter, shelf_y + gutter};
+        shelf_x += width;
+        shelf_height = std::max(shelf_height, height);
+
+        auto& page = atlas.pages.back();
+        page.width = std::max(page.width, shelf_x);
+        page.height = std::max(page.height, shelf_y + shelf_height);
+    }
+
+    for (auto& page : atlas.pages)
+    {
+        size_t size = 0;
+        for (size_t level = 0; level < level_count; level++)
+        {
+            page.level_offsets.push_back(size);
+            size += 4 * size_t(get_mip_level_size(page.width, level)) * size_t(get_mip_level_size(page.height, level));
+        }
+        page.pixels.resize(size);
+    }
+
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        auto& page = atlas.pages[cells[i].page];
+        copy_image(images[i], gutter, cells[i].x, cells[i].y, page);
+
+        TextureRegion region;
+        region.texture = cells[i].page;
+        region.uv_transform = simd_float4{
+            float(images[i].width) / float(page.width),
+            float(images[i].height) / float(page.height),
+            float(cells[i].x) / float(page.width),
+            float(cells[i].y) / float(page.height)
+        };
+        atlas.regions.push_back(region);
+    }
+
+    // UI and effect sprites are color, the gutter keeps neighbours out of the filter taps
+    for (auto& page : atlas.pages)
+    {
+        for (size_t level = 1; level < level_count; level++)
+        {
+            downsample(
+                page.pixels.data() + page.level_offsets[level - 1],
+                get_mip_level_size(page.width, level - 1),
+                get_mip_level_size(page.height, level - 1),
+                4,
+                MipmapContent::color,
+                MipmapFilter::kaiser,
+                page.pixels.data() + page.level_offsets[level]
+            );
+        }
+    }
+
+    return atlas;
+}
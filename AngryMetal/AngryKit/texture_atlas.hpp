@@ -0,0 +1,57 @@
+//
+//  texture_atlas.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "texture_manager_interface.hpp"
+
+namespace angry
+{
+
+struct AtlasSettings
+{
+    int max_page_size = 2048;
+    // edge pixels are repeated around every image, the gutter halves at every mip level
+    int gutter = 16;
+};
+
+// Grey or BGRA pixels like decoded images.
+struct AtlasImage
+{
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    const uint8_t* data = nullptr;
+};
+
+// BGRA with the mip chain, levels follow each other in `pixels`.
+struct AtlasPage
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+    std::vector<size_t> level_offsets;
+};
+
+struct Atlas
+{
+    std::vector<AtlasPage> pages;
+    // one per image, `texture` is an index in `pages`
+    std::vector<TextureRegion> regions;
+};
+
+// Mip levels stop while every image still has two gutter pixels, enough for the filter taps.
+size_t get_atlas_level_count(const AtlasSettings& settings);
+
+// Shelf packing, same image sizes always give the same layout.
+Atlas build_atlas(const std::vector<AtlasImage>& images, const AtlasSettings& settings);
+
+}
@@ -0,0 +1,240 @@
+//
+//  texture_cache.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace angry;
+
+namespace
+{
+
+constexpr uint64_t prime1 = 0x9e3779b185ebca87ull;
+constexpr uint64_t prime2 = 0xc2b2ae3d27d4eb4full;
+constexpr uint64_t prime3 = 0x165667b19e3779f9ull;
+
+uint64_t rotate_left(uint64_t value, int shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+uint64_t load_word(const uint8_t* data)
+{
+    uint64_t result;
+    std::memcpy(&result, data, sizeof(result));
+    return result;
+}
+
+uint64_t mix(uint64_t accumulator, uint64_t word)
+{
+    return rotate_left(accumulator + word * prime2, 31) * prime1;
+}
+
+}
+
+// xxHash64 style rounds, four independent lanes keep the multipliers busy
+uint64_t angry::get_content_hash(const uint8_t* data, size_t size)
+{
+    uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32)
+    {
+        for (size_t i = 0; i < 4; i++)
+        {
+            lanes[i] = mix(lanes[i], load_word(data + offset + 8 * i));
+        }
+    }
+
+    uint64_t result = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7)
+        + rotate_left(lanes[2], 12) + rotate_left(lanes[3], 18) + size;
+    for (; offset + 8 <= size; offset += 8)
+    {
+        result = rotate_left(result ^ mix(0, load_word(data + offset)), 27) * prime1 + prime3;
+    }
+
+    for (; offset < size; offset++)
+    {
+        result = rotate_left(result ^ (data[offset] * prime3), 11) * prime1;
+    }
+
+    result ^= result >> 33;
+    result *= prime2;
+    result ^= result >> 29;
+    result *= prime3;
+    result ^= result >> 32;
+    return result;
+}
+
+TextureContentKey angry::get_texture_content_key(const uint8_t* file_data, size_t file_size)
+{
+    return TextureContentKey{get_content_hash(file_data, file_size), file_size};
+}
+
+double TextureCache::Statistics::get_hit_rate() const
+{
+    return request_count == 0 ? 0.0 : double(path_hit_count + content_hit_count) / double(request_count);
+}
+
+std::optional<size_t> TextureCache::acquire(const std::filesystem::path& file_path)
+{
+    _statistics.request_count += 1;
+
+    const auto texture = find(file_path);
+    if (!texture)
+    {
+        return std::nullopt;
+    }
+
+    auto& entry = _entries.at(*texture);
+    entry.reference_count += 1;
+    _statistics.path_hit_count += 1;
+    _statistics.saved_bytes += entry.byte_size;
+    return texture;
+}
+
+void TextureCache::acquire(size_t texture, const std::filesystem::path& file_path)
+{
+    auto& entry = _entries.at(texture);
+    entry.reference_count += 1;
+    _statistics.content_hit_count += 1;
+    _statistics.saved_bytes += entry.byte_size;
+
+    const auto path = file_path.string();
+    if (_paths.emplace(path, texture).second)
+    {
+        entry.paths.push_back(path);
+    }
+}
+
+std::optional<size_t> TextureCache::find(const TextureContentKey& key) const
+{
+    if (key.file_size == 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto p = _contents.find(key.hash);
+    if (p == _contents.end() || _entries.at(p->second).key.file_size != key.file_size)
+    {
+        return std::nullopt;
+    }
+    return p->second;
+}
+
+std::optional<size_t> TextureCache::find(const std::filesystem::path& file_path) const
+{
+    const auto p = _paths.find(file_path.string());
+    if (p == _paths.end())
+    {
+        return std::nullopt;
+    }
+    return p->second;
+}
+
+bool TextureCache::is_current(size_t texture, const TextureContentKey& key) const
+{
+    const auto p = _entries.find(texture);
+    return p != _entries.end()
+        && key.file_size != 0
+        && p->second.key.file_size == key.file_size
+        && p->second.key.hash == key.hash;
+}
+
+bool TextureCache::is_shared(size_t texture) const
+{
+    const auto p = _entries.find(texture);
+    return p != _entries.end() && p->second.paths.size() > 1;
+}
+
+void TextureCache::add(size_t texture, const std::filesystem::path& file_path, const TextureContentKey& key, size_t byte_size)
+{
+    Entry entry;
+    entry.reference_count = 1;
+    entry.key = key;
+    entry.byte_size = byte_size;
+    entry.paths.push_back(file_path.string());
+
+    _paths[entry.paths.back()] = texture;
+    _entries[texture] = std::move(entry);
+    add_content(texture, key);
+
+    _statistics.texture_count += 1;
+    _statistics.texture_bytes += byte_size;
+}
+
+void TextureCache::update(size_t texture, const TextureContentKey& key, size_t byte_size)
+{
+    auto& entry = _entries.at(texture);
+    remove_content(texture, entry.key);
+    _statistics.texture_bytes -= entry.byte_size;
+
+    entry.key = key;
+    entry.byte_size = byte_size;
+    add_content(texture, key);
+    _statistics.texture_bytes += byte_size;
+}
+
+void TextureCache::split(size_t texture, const std::filesystem::path& file_path, size_t copy,
+                         const TextureContentKey& key, size_t byte_size)
+{
+    // references stay with `texture` until their holders swap them for the copy
+    auto& paths = _entries.at(texture).paths;
+    paths.erase(std::remove(paths.begin(), paths.end(), file_path.string()), paths.end());
+    add(copy, file_path, key, byte_size);
+}
+
+bool TextureCache::release(size_t texture)
+{
+    const auto p = _entries.find(texture);
+    if (p == _entries.end())
+    {
+        return false;
+    }
+
+    auto& entry = p->second;
+    entry.reference_count -= 1;
+    if (entry.reference_count > 0)
+    {
+        return false;
+    }
+
+    for (const auto& path : entry.paths)
+    {
+        _paths.erase(path);
+    }
+    remove_content(texture, entry.key);
+
+    _statistics.texture_count -= 1;
+    _statistics.texture_bytes -= entry.byte_size;
+    _entries.erase(p);
+    return true;
+}
+
+const TextureCache::Statistics& TextureCache::get_statistics() const
+{
+    return _statistics;
+}
+
+void TextureCache::add_content(size_t texture, const TextureContentKey& key)
+{
+    if (key.file_size != 0)
+    {
+        // an older texture with the same content keeps serving hits
+        _contents.emplace(key.hash, texture);
+    }
+}
+
+void TextureCache::remove_content(size_t texture, const TextureContentKey& key)
+{
+    const auto p = _contents.find(key.hash);
+    if (key.file_size != 0 && p != _contents.end() && p->second == texture)
+    {
+        _contents.erase(p);
+    }
+}
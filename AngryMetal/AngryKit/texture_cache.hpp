@@ -0,0 +1,104 @@
+//
+//  texture_cache.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace angry
+{
+
+uint64_t get_content_hash(const uint8_t* data, size_t size);
+
+// Hash of the source file bytes, identical files are found before they are decoded.
+struct TextureContentKey
+{
+    uint64_t hash = 0;
+    // 0 if the content is unknown, such textures are found by path only
+    size_t file_size = 0;
+};
+
+TextureContentKey get_texture_content_key(const uint8_t* file_data, size_t file_size);
+
+// Maps paths and content to texture indices and counts references. The cache does not own
+// textures, the manager destroys one when `release` returns true.
+class TextureCache final
+{
+public:
+    struct Statistics
+    {
+        size_t request_count = 0;
+        size_t path_hit_count = 0;
+        size_t content_hit_count = 0;
+        // texture memory which was not allocated again thanks to hits
+        size_t saved_bytes = 0;
+
+        size_t texture_count = 0;
+        size_t texture_bytes = 0;
+
+        double get_hit_rate() const;
+    };
+
+public:
+    TextureCache() = default;
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache(TextureCache&&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    TextureCache& operator=(TextureCache&&) = delete;
+
+    // counts a request, a hit is a new reference
+    std::optional<size_t> acquire(const std::filesystem::path& file_path);
+    // content hit for a file read under another path, which is then found by path as well
+    void acquire(size_t texture, const std::filesystem::path& file_path);
+
+    // does not change the cache, safe to call from concurrent read callbacks
+    std::optional<size_t> find(const TextureContentKey& key) const;
+    std::optional<size_t> find(const std::filesystem::path& file_path) const;
+    bool is_current(size_t texture, const TextureContentKey& key) const;
+    // more than one path was loaded as this texture
+    bool is_shared(size_t texture) const;
+
+    // new texture with one reference
+    void add(size_t texture, const std::filesystem::path& file_path, const TextureContentKey& key, size_t byte_size);
+    // content of a reloaded texture
+    void update(size_t texture, const TextureContentKey& key, size_t byte_size);
+    // copy on write of a shared texture, `file_path` leaves it for `copy` with one reference
+    void split(size_t texture, const std::filesystem::path& file_path, size_t copy, const TextureContentKey& key,
+               size_t byte_size);
+
+    // true when the last reference is gone, unknown textures are never released
+    bool release(size_t texture);
+
+    const Statistics& get_statistics() const;
+
+private:
+    struct Entry
+    {
+        size_t reference_count = 0;
+        TextureContentKey key;
+        size_t byte_size = 0;
+        std::vector<std::string> paths;
+    };
+
+    void add_content(size_t texture, const TextureContentKey& key);
+    void remove_content(size_t texture, const TextureContentKey& key);
+
+private:
+    std::unordered_map<size_t, Entry> _entries;
+    std::unordered_map<std::string, size_t> _paths;
+    std::unordered_map<uint64_t, size_t> _contents;
+    Statistics _statistics;
+};
+
+}
@@ -0,0 +1,801 @@
+//
+//  texture_compression.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace angry;
+
+namespace
+{
+
+// 4x4 texels in RGBA order, values are 0..255
+using Texels = std::array<std::array<float, 4>, 16>;
+
+struct Channels
+{
+    size_t first = 0;
+    size_t count = 0;
+};
+
+// interpolation weights of a format in ascending order
+struct Levels
+{
+    std::array<float, 8> weights = {};
+    size_t count = 0;
+};
+
+struct LineFit
+{
+    // quantized endpoints
+    std::array<float, 4> e0 = {};
+    std::array<float, 4> e1 = {};
+    // index into Levels of every texel
+    std::array<uint8_t, 16> levels = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+using Quantizer = void (*)(std::array<float, 4>& endpoint);
+
+const Levels bc1_levels = {{0.0f, 1.0f / 3.0f, 2.0f / 3.0f, 1.0f}, 4};
+const Levels bc4_levels = {{0.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f, 1.0f}, 8};
+
+// unquantized ASTC weights for QUANT_8 and QUANT_4, 0..64
+const std::array<int, 8> astc_weights_8 = {0, 9, 18, 27, 37, 46, 55, 64};
+const std::array<int, 4> astc_weights_4 = {0, 21, 43, 64};
+
+const Levels astc_levels_8 = {{0.0f, 9.0f / 64, 18.0f / 64, 27.0f / 64, 37.0f / 64, 46.0f / 64, 55.0f / 64, 1.0f}, 8};
+const Levels astc_levels_4 = {{0.0f, 21.0f / 64, 43.0f / 64, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 4};
+
+// single partition 4x4 weight grid: QUANT_8 weights for RGB, QUANT_4 for RGBA, endpoints are QUANT_256
+const uint32_t astc_block_mode_rgb = 83;
+const uint32_t astc_block_mode_rgba = 66;
+const uint32_t astc_cem_rgb = 8;
+const uint32_t astc_cem_rgba = 12;
+
+size_t get_iteration_count(CompressionPreset preset)
+{
+    return preset == CompressionPreset::fast ? 0 : 3;
+}
+
+void quantize_8bit(std::array<float, 4>& endpoint)
+{
+    for (auto& value : endpoint)
+    {
+        value = std::round(std::clamp(value, 0.0f, 255.0f));
+    }
+}
+
+int to_bits(float value, int max)
+{
+    return int(std::round(std::clamp(value, 0.0f, 255.0f) * float(max) / 255.0f));
+}
+
+int expand_5(int value)
+{
+    return (value << 3) | (value >> 2);
+}
+
+int expand_6(int value)
+{
+    return (value << 2) | (value >> 4);
+}
+
+void quantize_565(std::array<float, 4>& endpoint)
+{
+    endpoint[0] = float(expand_5(to_bits(endpoint[0], 31)));
+    endpoint[1] = float(expand_6(to_bits(endpoint[1], 63)));
+    endpoint[2] = float(expand_5(to_bits(endpoint[2], 31)));
+}
+
+uint16_t pack_565(const std::array<float, 4>& endpoint)
+{
+    return uint16_t((to_bits(endpoint[0], 31) << 11) | (to_bits(endpoint[1], 63) << 5) | to_bits(endpoint[2], 31));
+}
+
+Texels fetch_block(const uint8_t* pixels, int width, int height, int components, int block_x, int block_y)
+{
+    Texels result;
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            // partial blocks repeat the edge
+            const int px = std::min(4 * block_x + x, width - 1);
+            const int py = std::min(4 * block_y + y, height - 1);
+            const uint8_t* p = pixels + (size_t(py) * size_t(width) + size_t(px)) * size_t(components);
+
+            auto& texel = result[size_t(4 * y + x)];
+            if (components == 1)
+            {
+                texel = {float(p[0]), float(p[0]), float(p[0]), 255.0f};
+            }
+            else
+            {
+                texel = {float(p[2]), float(p[1]), float(p[0]), float(p[3])};
+            }
+        }
+    }
+    return result;
+}
+
+std::array<float, 4> get_principal_axis(const Texels& texels, Channels channels, const std::array<float, 4>& mean)
+{
+    std::array<std::array<float, 4>, 4> covariance = {};
+    std::array<float, 4> low, high;
+    low.fill(255.0f);
+    high.fill(0.0f);
+    for (const auto& texel : texels)
+    {
+        for (size_t i = channels.first; i < channels.first + channels.count; i++)
+        {
+            low[i] = std::min(low[i], texel[i]);
+            high[i] = std::max(high[i], texel[i]);
+            for (size_t k = channels.first; k < channels.first + channels.count; k++)
+            {
+                covariance[i][k] += (texel[i] - mean[i]) * (texel[k] - mean[k]);
+            }
+        }
+    }
+
+    // power iteration from the bounding box diagonal
+    std::array<float, 4> axis = {};
+    for (size_t i = channels.first; i < channels.first + channels.count; i++)
+    {
+        axis[i] = high[i] - low[i];
+    }
+
+    for (size_t iteration = 0; iteration < 8; iteration++)
+    {
+        std::array<float, 4> next = {};
+        float length = 0.0f;
+        for (size_t i = channels.first; i < channels.first + channels.count; i++)
+        {
+            for (size_t k = channels.first; k < channels.first + channels.count; k++)
+            {
+                next[i] += covariance[i][k] * axis[k];
+            }
+            length = std::max(length, std::abs(next[i]));
+        }
+
+        if (length == 0.0f)
+        {
+            break;
+        }
+        for (auto& value : next)
+        {
+            value /= length;
+        }
+        axis = next;
+    }
+
+    float length = 0.0f;
+    for (float value : axis)
+    {
+        length += value * value;
+    }
+    length = std::sqrt(length);
+    if (length > 0.0f)
+    {
+        for (auto& value : axis)
+        {
+            value /= length;
+        }
+    }
+    return axis;
+}
+
+void assign_levels(const Texels& texels, Channels channels, const Levels& levels, LineFit& fit)
+{
+    fit.error = 0.0f;
+    for (size_t t = 0; t < texels.size(); t++)
+    {
+        float best_error = std::numeric_limits<float>::max();
+        for (size_t level = 0; level < levels.count; level++)
+        {
+            const float w = levels.weights[level];
+            float error = 0.0f;
+            for (size_t i = channels.first; i < channels.first + channels.count; i++)
+            {
+                const float d = fit.e0[i] + w * (fit.e1[i] - fit.e0[i]) - texels[t][i];
+                error += d * d;
+            }
+
+            if (error < best_error)
+            {
+                best_error = error;
+                fit.levels[t] = uint8_t(level);
+            }
+        }
+        fit.error += best_error;
+    }
+}
+
+// Endpoints along the principal axis, `iterations` least squares refinements keep the best result.
+LineFit fit_line(const Texels& texels, Channels channels, const Levels& levels, Quantizer quantize, size_t iterations)
+{
+    std::array<float, 4> mean = {};
+    for (const auto& texel : texels)
+    {
+        for (size_t i = channels.first; i < channels.first + channels.count; i++)
+        {
+            mean[i] += texel[i] / float(texels.size());
+        }
+    }
+
+    const auto axis = get_principal_axis(texels, channels, mean);
+    float t_min = 0.0f;
+    float t_max = 0.0f;
+    for (const auto& texel : texels)
+    {
+        float t = 0.0f;
+        for (size_t i = channels.first; i < channels.first + channels.count; i++)
+        {
+            t += (texel[i] - mean[i]) * axis[i];
+        }
+        t_min = std::min(t_min, t);
+        t_max = std::max(t_max, t);
+    }
+
+    std::array<float, 4> e0 = {};
+    std::array<float, 4> e1 = {};
+    for (size_t i = channels.first; i < channels.first + channels.count; i++)
+    {
+        e0[i] = std::clamp(mean[i] + t_min * axis[i], 0.0f, 255.0f);
+        e1[i] = std::clamp(mean[i] + t_max * axis[i], 0.0f, 255.0f);
+    }
+
+    LineFit best;
+    for (size_t iteration = 0; ; iteration++)
+    {
+        LineFit fit;
+        fit.e0 = e0;
+        fit.e1 = e1;
+        quantize(fit.e0);
+        quantize(fit.e1);
+        assign_levels(texels, channels, levels, fit);
+        if (fit.error < best.error)
+        {
+            best = fit;
+        }
+
+        if (iteration == iterations || best.error == 0.0f)
+        {
+            break;
+        }
+
+        // minimize the error of unquantized endpoints for the chosen weights
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        std::array<float, 4> x0 = {};
+        std::array<float, 4> x1 = {};
+        for (size_t t = 0; t < texels.size(); t++)
+        {
+            const float w = levels.weights[fit.levels[t]];
+            a += (1.0f - w) * (1.0f - w);
+            b += w * (1.0f - w);
+            c += w * w;
+            for (size_t i = channels.first; i < channels.first + channels.count; i++)
+            {
+                x0[i] += (1.0f - w) * texels[t][i];
+                x1[i] += w * texels[t][i];
+            }
+        }
+
+        const float determinant = a * c - b * b;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            break;
+        }
+
+        for (size_t i = channels.first; i < channels.first + channels.count; i++)
+        {
+            e0[i] = std::clamp((c * x0[i] - b * x1[i]) / determinant, 0.0f, 255.0f);
+            e1[i] = std::clamp((a * x1[i] - b * x0[i]) / determinant, 0.0f, 255.0f);
+        }
+    }
+    return best;
+}
+
+void write_bits(uint8_t* block, size_t offset, size_t count, uint64_t value)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t bit = offset + i;
+        block[bit / 8] |= uint8_t(((value >> i) & 1) << (bit % 8));
+    }
+}
+
+uint64_t read_bits(const uint8_t* block, size_t offset, size_t count)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t bit = offset + i;
+        result |= uint64_t((block[bit / 8] >> (bit % 8)) & 1) << i;
+    }
+    return result;
+}
+
+void encode_bc1(const Texels& texels, CompressionPreset preset, uint8_t* block)
+{
+    const auto fit = fit_line(texels, {0, 3}, bc1_levels, quantize_565, get_iteration_count(preset));
+
+    // four color mode needs c0 > c1, codes 2 and 3 are the 1/3 and 2/3 points
+    uint16_t c0 = pack_565(fit.e0);
+    uint16_t c1 = pack_565(fit.e1);
+    std::array<uint32_t, 4> codes = {0, 2, 3, 1};
+    if (c0 < c1)
+    {
+        std::swap(c0, c1);
+        codes = {1, 3, 2, 0};
+    }
+    else if (c0 == c1)
+    {
+        codes = {0, 0, 0, 0};
+    }
+
+    uint32_t indices = 0;
+    for (size_t t = 0; t < texels.size(); t++)
+    {
+        indices |= codes[fit.levels[t]] << (2 * t);
+    }
+
+    write_bits(block, 0, 16, c0);
+    write_bits(block, 16, 16, c1);
+    write_bits(block, 32, 32, indices);
+}
+
+void encode_bc4(const Texels& texels, size_t channel, CompressionPreset preset, uint8_t* block)
+{
+    const auto fit = fit_line(texels, {channel, 1}, bc4_levels, quantize_8bit, get_iteration_count(preset));
+
+    // eight value mode needs a0 > a1, codes 2..7 are the interpolated points from a0 to a1
+    int a0 = int(fit.e0[channel]);
+    int a1 = int(fit.e1[channel]);
+    std::array<uint64_t, 8> codes = {0, 2, 3, 4, 5, 6, 7, 1};
+    if (a0 < a1)
+    {
+        std::swap(a0, a1);
+        std::reverse(codes.begin(), codes.end());
+    }
+    else if (a0 == a1)
+    {
+        codes.fill(0);
+    }
+
+    uint64_t indices = 0;
+    for (size_t t = 0; t < texels.size(); t++)
+    {
+        indices |= codes[fit.levels[t]] << (3 * t);
+    }
+
+    write_bits(block, 0, 8, uint64_t(a0));
+    write_bits(block, 8, 8, uint64_t(a1));
+    write_bits(block, 16, 48, indices);
+}
+
+void encode_astc(const Texels& texels, CompressionPreset preset, uint8_t* block)
+{
+    const bool has_alpha = std::any_of(texels.cbegin(), texels.cend(), [](const auto& texel) {
+        return texel[3] < 255.0f;
+    });
+    const Channels channels = has_alpha ? Channels{0, 4} : Channels{0, 3};
+    const Levels& levels = has_alpha ? astc_levels_4 : astc_levels_8;
+
+    auto fit = fit_line(texels, channels, levels, quantize_8bit, get_iteration_count(preset));
+
+    // decoder applies blue contraction unless the second endpoint has the larger sum
+    const float s0 = fit.e0[0] + fit.e0[1] + fit.e0[2];
+    const float s1 = fit.e1[0] + fit.e1[1] + fit.e1[2];
+    if (s1 < s0)
+    {
+        std::swap(fit.e0, fit.e1);
+        for (auto& level : fit.levels)
+        {
+            level = uint8_t(levels.count - 1 - level);
+        }
+    }
+
+    write_bits(block, 0, 11, has_alpha ? astc_block_mode_rgba : astc_block_mode_rgb);
+    write_bits(block, 11, 2, 0);
+    write_bits(block, 13, 4, has_alpha ? astc_cem_rgba : astc_cem_rgb);
+
+    // endpoint values are interleaved per channel: r0 r1 g0 g1 b0 b1 (a0 a1)
+    size_t offset = 17;
+    for (size_t i = 0; i < channels.count; i++)
+    {
+        write_bits(block, offset, 8, uint64_t(fit.e0[i]));
+        write_bits(block, offset + 8, 8, uint64_t(fit.e1[i]));
+        offset += 16;
+    }
+
+    // weights are stored bit reversed from the top of the block
+    const size_t weight_bits = has_alpha ? 2 : 3;
+    for (size_t t = 0; t < texels.size(); t++)
+    {
+        for (size_t i = 0; i < weight_bits; i++)
+        {
+            const size_t bit = 127 - (t * weight_bits + i);
+            block[bit / 8] |= uint8_t(((fit.levels[t] >> i) & 1) << (bit % 8));
+        }
+    }
+}
+
+void encode_block(const Texels& texels, CompressedFormat format, CompressionPreset preset, uint8_t* block)
+{
+    switch (format)
+    {
+        case CompressedFormat::bc1:
+        {
+            encode_bc1(texels, preset, block);
+            break;
+        }
+
+        case CompressedFormat::bc3:
+        {
+            encode_bc4(texels, 3, preset, block);
+            encode_bc1(texels, preset, block + 8);
+            break;
+        }
+
+        case CompressedFormat::bc4:
+        {
+            encode_bc4(texels, 0, preset, block);
+            break;
+        }
+
+        case CompressedFormat::bc5:
+        {
+            encode_bc4(texels, 0, preset, block);
+            encode_bc4(texels, 1, preset, block + 8);
+            break;
+        }
+
+        case CompressedFormat::astc_4x4:
+        {
+            encode_astc(texels, preset, block);
+            break;
+        }
+    }
+}
+
+// decoded texels are RGBA
+using DecodedBlock = std::array<std::array<uint8_t, 4>, 16>;
+
+void decode_bc1(const uint8_t* block, bool is_four_color, DecodedBlock& result)
+{
+    const uint32_t c0 = uint32_t(read_bits(block, 0, 16));
+    const uint32_t c1 = uint32_t(read_bits(block, 16, 16));
+
+    std::array<std::array<int, 4>, 4> palette;
+    palette[0] = {expand_5(int(c0 >> 11)), expand_6(int((c0 >> 5) & 63)), expand_5(int(c0 & 31)), 255};
+    palette[1] = {expand_5(int(c1 >> 11)), expand_6(int((c1 >> 5) & 63)), expand_5(int(c1 & 31)), 255};
+    for (size_t i = 0; i < 3; i++)
+    {
+        if (is_four_color || c0 > c1)
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+        else
+        {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+            palette[3][i] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = is_four_color || c0 > c1 ? 255 : 0;
+
+    for (size_t t = 0; t < result.size(); t++)
+    {
+        const auto& color = palette[read_bits(block, 32 + 2 * t, 2)];
+        for (size_t i = 0; i < 4; i++)
+        {
+            result[t][i] = uint8_t(color[i]);
+        }
+    }
+}
+
+void decode_bc4(const uint8_t* block, size_t channel, DecodedBlock& result)
+{
+    const int a0 = int(block[0]);
+    const int a1 = int(block[1]);
+
+    std::array<int, 8> palette = {a0, a1};
+    for (int k = 1; k < 7; k++)
+    {
+        if (a0 > a1)
+        {
+            palette[size_t(k + 1)] = ((7 - k) * a0 + k * a1) / 7;
+        }
+        else if (k < 5)
+        {
+            palette[size_t(k + 1)] = ((5 - k) * a0 + k * a1) / 5;
+        }
+    }
+    if (a0 <= a1)
+    {
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (size_t t = 0; t < result.size(); t++)
+    {
+        result[t][channel] = uint8_t(palette[read_bits(block, 16 + 3 * t, 3)]);
+    }
+}
+
+void decode_astc(const uint8_t* block, DecodedBlock& result)
+{
+    const uint32_t block_mode = uint32_t(read_bits(block, 0, 11));
+    const uint32_t cem = uint32_t(read_bits(block, 13, 4));
+    const bool is_rgb = block_mode == astc_block_mode_rgb && cem == astc_cem_rgb;
+    const bool is_rgba = block_mode == astc_block_mode_rgba && cem == astc_cem_rgba;
+    if ((!is_rgb && !is_rgba) || read_bits(block, 11, 2) != 0)
+    {
+        std::stringstream t;
+        t << "decompress() unsupported ASTC block mode " << block_mode << " with endpoint mode " << cem;
+        throw std::runtime_error(t.str());
+    }
+
+    const size_t channel_count = is_rgba ? 4 : 3;
+    std::array<int, 4> e0 = {0, 0, 0, 255};
+    std::array<int, 4> e1 = {0, 0, 0, 255};
+    for (size_t i = 0; i < channel_count; i++)
+    {
+        e0[i] = int(read_bits(block, 17 + 16 * i, 8));
+        e1[i] = int(read_bits(block, 25 + 16 * i, 8));
+    }
+
+    if (e1[0] + e1[1] + e1[2] < e0[0] + e0[1] + e0[2])
+    {
+        // blue contraction
+        std::swap(e0, e1);
+        for (auto* e : {&e0, &e1})
+        {
+            (*e)[0] = ((*e)[0] + (*e)[2]) >> 1;
+            (*e)[1] = ((*e)[1] + (*e)[2]) >> 1;
+        }
+    }
+
+    const size_t weight_bits = is_rgba ? 2 : 3;
+    for (size_t t = 0; t < result.size(); t++)
+    {
+        uint32_t level = 0;
+        for (size_t i = 0; i < weight_bits; i++)
+        {
+            const size_t bit = 127 - (t * weight_bits + i);
+            level |= uint32_t((block[bit / 8] >> (bit % 8)) & 1) << i;
+        }
+        const int w = is_rgba ? astc_weights_4[level] : astc_weights_8[level];
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            // interpolation on 16-bit expanded endpoints, top byte is the unorm8 result
+            const int c0 = (e0[i] << 8) | e0[i];
+            const int c1 = (e1[i] << 8) | e1[i];
+            result[t][i] = uint8_t(((c0 * (64 - w) + c1 * w + 32) >> 6) >> 8);
+        }
+    }
+}
+
+DecodedBlock decode_block(const uint8_t* block, CompressedFormat format)
+{
+    DecodedBlock result;
+    for (auto& texel : result)
+    {
+        texel = {0, 0, 0, 255};
+    }
+
+    switch (format)
+    {
+        case CompressedFormat::bc1:
+        {
+            decode_bc1(block, false, result);
+            break;
+        }
+
+        case CompressedFormat::bc3:
+        {
+            decode_bc1(block + 8, true, result);
+            decode_bc4(block, 3, result);
+            break;
+        }
+
+        case CompressedFormat::bc4:
+        {
+            decode_bc4(block, 0, result);
+            break;
+        }
+
+        case CompressedFormat::bc5:
+        {
+            decode_bc4(block, 0, result);
+            decode_bc4(block + 8, 1, result);
+            break;
+        }
+
+        case CompressedFormat::astc_4x4:
+        {
+            decode_astc(block, result);
+            break;
+        }
+    }
+    return result;
+}
+
+Channels get_stored_channels(CompressedFormat format)
+{
+    switch (format)
+    {
+        case CompressedFormat::bc1:
+            return {0, 3};
+        case CompressedFormat::bc4:
+            return {0, 1};
+        case CompressedFormat::bc5:
+            return {0, 2};
+        case CompressedFormat::bc3:
+        case CompressedFormat::astc_4x4:
+            return {0, 4};
+    }
+    return {0, 4};
+}
+
+}
+
+size_t angry::get_block_bytes(CompressedFormat format)
+{
+    return format == CompressedFormat::bc1 || format == CompressedFormat::bc4 ? 8 : 16;
+}
+
+size_t angry::get_compressed_size(CompressedFormat format, int width, int height)
+{
+    return size_t((width + 3) / 4) * size_t((height + 3) / 4) * get_block_bytes(format);
+}
+
+const char* angry::get_format_name(CompressedFormat format)
+{
+    switch (format)
+    {
+        case CompressedFormat::bc1:
+            return "bc1";
+        case CompressedFormat::bc3:
+            return "bc3";
+        case CompressedFormat::bc4:
+            return "bc4";
+        case CompressedFormat::bc5:
+            return "bc5";
+        case CompressedFormat::astc_4x4:
+            return "astc_4x4";
+    }
+    return "";
+}
+
+std::vector<uint8_t> angry::compress(
+    const uint8_t* pixels,
+    int width,
+    int height,
+    int components,
+    CompressedFormat format,
+    CompressionPreset preset,
+    size_t thread_count
+)
+{
+    if (components != 1 && components != 4)
+    {
+        std::stringstream t;
+        t << "compress() unsupported number of components " << components;
+        throw std::runtime_error(t.str());
+    }
+
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+    const size_t block_bytes = get_block_bytes(format);
+    std::vector<uint8_t> result(get_compressed_size(format, width, height), 0);
+
+    // rows of blocks are taken by whichever thread is free
+    std::atomic<int> next_row(0);
+    auto encode_rows = [&] {
+        for (int y = next_row++; y < blocks_y; y = next_row++)
+        {
+            for (int x = 0; x < blocks_x; x++)
+            {
+                const auto texels = fetch_block(pixels, width, height, components, x, y);
+                uint8_t* block = result.data() + (size_t(y) * size_t(blocks_x) + size_t(x)) * block_bytes;
+                encode_block(texels, format, preset, block);
+            }
+        }
+    };
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min(thread_count, size_t(blocks_y));
+
+    std::vector<std::future<void>> tasks;
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        tasks.push_back(std::async(std::launch::async, encode_rows));
+    }
+    encode_rows();
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    return result;
+}
+
+std::vector<uint8_t> angry::decompress(const uint8_t* blocks, int width, int height, CompressedFormat format)
+{
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+    const size_t block_bytes = get_block_bytes(format);
+
+    std::vector<uint8_t> result(4 * size_t(width) * size_t(height));
+    for (int by = 0; by < blocks_y; by++)
+    {
+        for (int bx = 0; bx < blocks_x; bx++)
+        {
+            const auto texels = decode_block(blocks + (size_t(by) * size_t(blocks_x) + size_t(bx)) * block_bytes, format);
+            for (int y = 0; y < 4 && 4 * by + y < height; y++)
+            {
+                for (int x = 0; x < 4 && 4 * bx + x < width; x++)
+                {
+                    const auto& texel = texels[size_t(4 * y + x)];
+                    uint8_t* p = result.data() + 4 * (size_t(4 * by + y) * size_t(width) + size_t(4 * bx + x));
+                    p[0] = texel[2];
+                    p[1] = texel[1];
+                    p[2] = texel[0];
+                    p[3] = texel[3];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+double angry::get_psnr(const uint8_t* pixels, int components, const uint8_t* decoded, int width, int height, CompressedFormat format)
+{
+    const auto channels = get_stored_channels(format);
+
+    double squared_error = 0.0;
+    for (size_t i = 0; i < size_t(width) * size_t(height); i++)
+    {
+        const uint8_t* p = pixels + i * size_t(components);
+        const std::array<int, 4> source = components == 1
+            ? std::array<int, 4>{p[0], p[0], p[0], 255}
+            : std::array<int, 4>{p[2], p[1], p[0], p[3]};
+        const uint8_t* d = decoded + 4 * i;
+        const std::array<int, 4> result = {d[2], d[1], d[0], d[3]};
+
+        for (size_t c = channels.first; c < channels.first + channels.count; c++)
+        {
+            const double difference = double(source[c] - result[c]);
+            squared_error += difference * difference;
+        }
+    }
+
+    const double mse = squared_error / (double(width) * double(height) * double(channels.count));
+    if (mse == 0.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
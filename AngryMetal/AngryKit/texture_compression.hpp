@@ -0,0 +1,62 @@
+//
+//  texture_compression.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace angry
+{
+
+// All formats use 4x4 blocks.
+enum class CompressedFormat
+{
+    // RGB, 8 bytes
+    bc1,
+    // RGB and alpha, 16 bytes
+    bc3,
+    // red, 8 bytes
+    bc4,
+    // red and green for normal maps, 16 bytes
+    bc5,
+    // RGB or RGBA chosen per block, 16 bytes
+    astc_4x4
+};
+
+enum class CompressionPreset
+{
+    // endpoints from the principal axis
+    fast,
+    // endpoints refined by least squares
+    quality
+};
+
+size_t get_block_bytes(CompressedFormat format);
+size_t get_compressed_size(CompressedFormat format, int width, int height);
+const char* get_format_name(CompressedFormat format);
+
+// Pixels are grey or BGRA like decoded images, grey is used as every color channel.
+// Rows of blocks are split between `thread_count` threads, 0 means hardware concurrency.
+std::vector<uint8_t> compress(
+    const uint8_t* pixels,
+    int width,
+    int height,
+    int components,
+    CompressedFormat format,
+    CompressionPreset preset,
+    size_t thread_count = 0
+);
+
+// Returns BGRA pixels, channels the format does not store are 0 (255 for alpha).
+std::vector<uint8_t> decompress(const uint8_t* blocks, int width, int height, CompressedFormat format);
+
+// Over the channels the format stores, infinity for a lossless result.
+double get_psnr(const uint8_t* pixels, int components, const uint8_t* decoded, int width, int height, CompressedFormat format);
+
+}
@@ -0,0 +1,195 @@
+//
+//  texture_cooker.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_cooker.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace angry;
+
+namespace
+{
+
+bool has_alpha(const Image& image)
+{
+    if (image.components != 4)
+    {
+        return false;
+    }
+
+    const size_t pixel_count = size_t(image.width) * size_t(image.height);
+    for (size_t i = 0; i < pixel_count; i++)
+    {
+        if (image.data[4 * i + 3] != 255)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TextureFormat get_texture_format(CompressedFormat format)
+{
+    switch (format)
+    {
+        case CompressedFormat::bc1:
+            return TextureFormat::bc1;
+        case CompressedFormat::bc3:
+            return TextureFormat::bc3;
+        case CompressedFormat::bc4:
+            return TextureFormat::bc4;
+        case CompressedFormat::bc5:
+            return TextureFormat::bc5;
+        case CompressedFormat::astc_4x4:
+            return TextureFormat::astc_4x4;
+    }
+    return TextureFormat::astc_4x4;
+}
+
+const char* get_texture_format_name(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::r8_unorm:
+            return "r8_unorm";
+        case TextureFormat::bgra8_unorm:
+            return "bgra8_unorm";
+        case TextureFormat::bc1:
+            return "bc1";
+        case TextureFormat::bc3:
+            return "bc3";
+        case TextureFormat::bc4:
+            return "bc4";
+        case TextureFormat::bc5:
+            return "bc5";
+        case TextureFormat::astc_4x4:
+            return "astc_4x4";
+    }
+    return "unknown";
+}
+
+}
+
+bool angry::is_texture_source(const std::filesystem::path& file_path)
+{
+    auto extension = file_path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".png" || extension == ".tga" || extension == ".psd" || extension == ".jpg";
+}
+
+std::filesystem::path angry::get_cooked_texture_path(const std::filesystem::path& file_path)
+{
+    return std::filesystem::path(file_path).replace_extension(".atex");
+}
+
+CompressedFormat angry::get_desktop_format(const Image& image, MipmapContent content)
+{
+    if (content == MipmapContent::normal)
+    {
+        return CompressedFormat::bc5;
+    }
+    if (image.components == 1)
+    {
+        return CompressedFormat::bc4;
+    }
+    return has_alpha(image) ? CompressedFormat::bc3 : CompressedFormat::bc1;
+}
+
+void angry::cook_texture(const std::filesystem::path& file_path, const TextureCookSettings& settings)
+{
+    Image image(file_path);
+    image.convert_to_bgra();
+
+    const auto content = get_mipmap_content(file_path);
+    image.generate_mipmaps(content, settings.mipmap_filter);
+
+    std::vector<TextureLevelData> levels = {{image.width, image.height, image.data}};
+    for (const auto& level : image.mip_levels)
+    {
+        levels.push_back({level.width, level.height, level.data});
+    }
+
+    if (!settings.is_compressed)
+    {
+        const auto format = image.components == 1 ? TextureFormat::r8_unorm : TextureFormat::bgra8_unorm;
+        write_texture_file(get_cooked_texture_path(file_path), format, levels);
+        return;
+    }
+
+    const auto format = settings.is_desktop ? get_desktop_format(image, content) : CompressedFormat::astc_4x4;
+
+    // compressed levels have to outlive `levels`
+    std::vector<std::vector<uint8_t>> blocks;
+    blocks.reserve(levels.size());
+    for (auto& level : levels)
+    {
+        blocks.push_back(compress(level.data, level.width, level.height, image.components, format, settings.preset));
+        level.data = blocks.back().data();
+    }
+    write_texture_file(get_cooked_texture_path(file_path), get_texture_format(format), levels);
+}
+
+std::vector<std::filesystem::path> angry::cook_textures(const std::filesystem::path& directory, const TextureCookSettings& settings)
+{
+    std::vector<std::filesystem::path> file_paths;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (entry.is_regular_file() && is_texture_source(entry.path()))
+        {
+            file_paths.push_back(entry.path());
+        }
+    }
+    // same order on every file system
+    std::sort(file_paths.begin(), file_paths.end());
+
+    std::vector<std::filesystem::path> result;
+    result.reserve(file_paths.size());
+    for (const auto& file_path : file_paths)
+    {
+        cook_texture(file_path, settings);
+        result.push_back(get_cooked_texture_path(file_path));
+    }
+    return result;
+}
+
+void angry::run_texture_cooker(const std::filesystem::path& directory, const TextureCookSettings& settings, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto start = Clock::now();
+    const auto cooked_paths = cook_textures(directory, settings);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    output << "{\"seconds\": " << seconds << ", \"textures\": [";
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < cooked_paths.size(); i++)
+    {
+        const TextureFile file(cooked_paths[i]);
+        const auto& header = file.get_header();
+        size_t bytes = 0;
+        for (uint32_t level = 0; level < header.level_count; level++)
+        {
+            bytes += file.get_level(level).size;
+        }
+        total_bytes += bytes;
+
+        output << (i == 0 ? "" : ", ")
+            << "{\"file\": \"" << cooked_paths[i].lexically_relative(directory).generic_string()
+            << "\", \"format\": \"" << get_texture_format_name(header.format)
+            << "\", \"width\": " << header.width
+            << ", \"height\": " << header.height
+            << ", \"levels\": " << header.level_count
+            << ", \"bytes\": " << bytes << "}";
+    }
+    output << "], \"bytes\": " << total_bytes << "}\n";
+}
@@ -0,0 +1,50 @@
+//
+//  texture_cooker.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+#include "image.hpp"
+#include "mipmap.hpp"
+#include "texture_compression.hpp"
+#include "texture_file.hpp"
+
+namespace angry
+{
+
+struct TextureCookSettings
+{
+    bool is_compressed = true;
+    // BC formats instead of ASTC
+    bool is_desktop = false;
+    CompressionPreset preset = CompressionPreset::quality;
+    MipmapFilter mipmap_filter = MipmapFilter::kaiser;
+};
+
+// Source images stb_image decodes.
+bool is_texture_source(const std::filesystem::path& file_path);
+
+// Cooked file lives next to the source with `.atex` extension.
+std::filesystem::path get_cooked_texture_path(const std::filesystem::path& file_path);
+
+// Grey is BC4, normal maps BC5, images with alpha BC3, everything else BC1.
+CompressedFormat get_desktop_format(const Image& image, MipmapContent content);
+
+// Decodes, converts to BGRA, builds the mip chain and compresses it.
+void cook_texture(const std::filesystem::path& file_path, const TextureCookSettings& settings);
+
+// Cooks every source image of `directory` recursively, returns the cooked files.
+std::vector<std::filesystem::path> cook_textures(const std::filesystem::path& directory, const TextureCookSettings& settings);
+
+// Cooks the textures of `directory` and maps every cooked file back the way texture managers
+// load it, writes format, size, levels and cook time of each as JSON.
+void run_texture_cooker(const std::filesystem::path& directory, const TextureCookSettings& settings, std::ostream& output);
+
+}
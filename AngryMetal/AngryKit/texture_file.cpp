@@ -0,0 +1,184 @@
+//
+//  texture_file.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "on_exit.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+bool is_compressed(TextureFormat format)
+{
+    return format != TextureFormat::r8_unorm && format != TextureFormat::bgra8_unorm;
+}
+
+size_t get_block_bytes(TextureFormat format)
+{
+    return format == TextureFormat::bc1 || format == TextureFormat::bc4 ? 8 : 16;
+}
+
+}
+
+size_t angry::get_bytes_per_row(TextureFormat format, int width)
+{
+    switch (format)
+    {
+        case TextureFormat::r8_unorm:
+            return size_t(width);
+        case TextureFormat::bgra8_unorm:
+            return 4 * size_t(width);
+        default:
+            return size_t((width + 3) / 4) * get_block_bytes(format);
+    }
+}
+
+size_t angry::get_level_size(TextureFormat format, int width, int height)
+{
+    const size_t rows = is_compressed(format) ? size_t((height + 3) / 4) : size_t(height);
+    return rows * get_bytes_per_row(format, width);
+}
+
+void angry::write_texture_file(
+    const std::filesystem::path& file_path,
+    TextureFormat format,
+    const std::vector<TextureLevelData>& levels
+)
+{
+    if (levels.empty())
+    {
+        throw std::runtime_error("write_texture_file() no levels");
+    }
+
+    TextureFileHeader header;
+    header.format = format;
+    header.width = uint32_t(levels.front().width);
+    header.height = uint32_t(levels.front().height);
+    header.level_count = uint32_t(levels.size());
+
+    std::vector<TextureFileLevel> table;
+    uint64_t offset = sizeof(header) + levels.size() * sizeof(TextureFileLevel);
+    for (const auto& level : levels)
+    {
+        TextureFileLevel entry;
+        entry.offset = (offset + texture_file_level_alignment - 1) / texture_file_level_alignment * texture_file_level_alignment;
+        entry.size = get_level_size(format, level.width, level.height);
+        entry.width = uint32_t(level.width);
+        entry.height = uint32_t(level.height);
+        entry.bytes_per_row = uint32_t(get_bytes_per_row(format, level.width));
+        table.push_back(entry);
+
+        offset = entry.offset + entry.size;
+    }
+
+    std::ofstream stream(file_path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(TextureFileLevel));
+
+    offset = sizeof(header) + table.size() * sizeof(TextureFileLevel);
+    const char padding[texture_file_level_alignment] = {};
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        stream.write(padding, table[i].offset - offset);
+        stream.write(reinterpret_cast<const char*>(levels[i].data), table[i].size);
+        offset = table[i].offset + table[i].size;
+    }
+
+    if (!stream)
+    {
+        std::stringstream t;
+        t << "write_texture_file() fail to write " << file_path;
+        throw std::runtime_error(t.str());
+    }
+}
+
+TextureFile::TextureFile(const std::filesystem::path& file_path)
+{
+    const int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        std::stringstream t;
+        t << "TextureFile() fail to open " << file_path << ", " << std::strerror(errno);
+        throw std::runtime_error(t.str());
+    }
+    OnExit close_file([file]() {
+        close(file);
+    });
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0 || size_t(file_stat.st_size) < sizeof(TextureFileHeader))
+    {
+        std::stringstream t;
+        t << "TextureFile() fail to read " << file_path;
+        throw std::runtime_error(t.str());
+    }
+
+    _size = size_t(file_stat.st_size);
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED)
+    {
+        std::stringstream t;
+        t << "TextureFile() fail to map " << file_path << ", " << std::strerror(errno);
+        throw std::runtime_error(t.str());
+    }
+    _data = static_cast<uint8_t*>(data);
+
+    // levels are about to be uploaded as a whole
+    madvise(_data, _size, MADV_WILLNEED);
+
+    const auto& header = get_header();
+    bool is_valid = std::memcmp(header.magic, TextureFileHeader().magic, sizeof(header.magic)) == 0
+        && header.version == TextureFileHeader().version
+        && header.level_count > 0
+        && sizeof(TextureFileHeader) + header.level_count * sizeof(TextureFileLevel) <= _size;
+    for (size_t i = 0; is_valid && i < header.level_count; i++)
+    {
+        const auto& level = get_level(i);
+        is_valid = level.offset + level.size <= _size;
+    }
+
+    if (!is_valid)
+    {
+        munmap(_data, _size);
+        std::stringstream t;
+        t << "TextureFile() unsupported file format " << file_path;
+        throw std::runtime_error(t.str());
+    }
+}
+
+TextureFile::~TextureFile()
+{
+    munmap(_data, _size);
+}
+
+const TextureFileHeader& TextureFile::get_header() const
+{
+    return *reinterpret_cast<const TextureFileHeader*>(_data);
+}
+
+const TextureFileLevel& TextureFile::get_level(size_t index) const
+{
+    return reinterpret_cast<const TextureFileLevel*>(_data + sizeof(TextureFileHeader))[index];
+}
+
+const uint8_t* TextureFile::get_level_data(size_t index) const
+{
+    return _data + get_level(index).offset;
+}
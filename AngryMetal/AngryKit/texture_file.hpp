@@ -0,0 +1,93 @@
+//
+//  texture_file.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace angry
+{
+
+// Texture file layout: header, level table, level data aligned to `level_alignment`.
+// Pixels are stored the way the GPU takes them, all numbers are little endian.
+
+enum class TextureFormat : uint32_t
+{
+    r8_unorm = 0,
+    bgra8_unorm = 1,
+    bc1 = 2,
+    bc3 = 3,
+    bc4 = 4,
+    bc5 = 5,
+    astc_4x4 = 6
+};
+
+struct TextureFileHeader
+{
+    char magic[4] = {'A', 'T', 'E', 'X'};
+    uint32_t version = 1;
+    TextureFormat format = TextureFormat::bgra8_unorm;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t level_count = 0;
+    uint64_t reserved = 0;
+};
+
+struct TextureFileLevel
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // of texels for plain formats, of 4x4 blocks for compressed ones
+    uint32_t bytes_per_row = 0;
+    uint32_t reserved = 0;
+};
+
+struct TextureLevelData
+{
+    int width = 0;
+    int height = 0;
+    const uint8_t* data = nullptr;
+};
+
+constexpr size_t texture_file_level_alignment = 256;
+
+size_t get_bytes_per_row(TextureFormat format, int width);
+size_t get_level_size(TextureFormat format, int width, int height);
+
+void write_texture_file(
+    const std::filesystem::path& file_path,
+    TextureFormat format,
+    const std::vector<TextureLevelData>& levels
+);
+
+// Maps the whole file, level data is used in place without copies.
+class TextureFile final
+{
+public:
+    explicit TextureFile(const std::filesystem::path& file_path);
+    ~TextureFile();
+
+    TextureFile(const TextureFile&) = delete;
+    TextureFile(TextureFile&&) = delete;
+    TextureFile& operator=(const TextureFile&) = delete;
+    TextureFile& operator=(TextureFile&&) = delete;
+
+    const TextureFileHeader& get_header() const;
+    const TextureFileLevel& get_level(size_t index) const;
+    const uint8_t* get_level_data(size_t index) const;
+
+private:
+    uint8_t* _data = nullptr;
+    size_t _size = 0;
+};
+
+}
@@ -9,10 +9,22 @@
 
 #import <Metal/Metal.h>
 
+#include <future>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "asset_storage.hpp"
+#include "image.hpp"
+#include "mipmap.hpp"
 #include "texture_manager_interface.hpp"
 #include "objc_ref.h"
+#include "slot_map.hpp"
+#include "staging_arena.hpp"
+#include "texture_atlas.hpp"
+#include "texture_cache.hpp"
+#include "texture_file.hpp"
+#include "texture_streamer.hpp"
 
 namespace angry
 {
@@ -20,7 +32,23 @@ namespace angry
 class TextureManager final : public TextureManagerInterface
 {
 public:
-    explicit TextureManager(id<MTLDevice> device);
+    struct Settings
+    {
+        // full mip chain is generated on load, turn off to compare sampling bandwidth
+        bool is_mipmapped = true;
+        MipmapFilter mipmap_filter = MipmapFilter::kaiser;
+
+        // small UI and effect images packed into shared pages on the first region request
+        std::vector<std::filesystem::path> atlas_paths;
+        AtlasSettings atlas;
+
+        // cooked textures start with their low levels, the rest follows as they are drawn
+        bool is_streamed = true;
+        TextureStreamer::Settings streaming;
+    };
+
+public:
+    TextureManager(id<MTLDevice> device, const AssetStorage& asset_storage, const Settings& settings);
 
     TextureManager(const TextureManager&) = delete;
     TextureManager(TextureManager&&) = delete;
@@ -28,14 +56,63 @@ public:
     TextureManager& operator=(TextureManager&&) = delete;
 
     size_t create_texture(const std::filesystem::path& file_path) override;
+    std::vector<size_t> create_textures(const std::vector<std::filesystem::path>& file_paths) override;
+    TextureRegion create_texture_region(const std::filesystem::path& file_path) override;
+    std::optional<size_t> reload_texture(const std::filesystem::path& file_path) override;
+    void release_texture(size_t index) override;
 
     id<MTLTexture> get_texture(size_t index);
 
+    // once per frame before drawing, swaps in finished levels and requests new ones
+    void update_streaming();
+    // textures drawn in this frame keep or get their high levels
+    void mark_used(size_t index);
+
+    const TextureCache::Statistics& get_cache_statistics() const;
+
+private:
+    using TextureRef = objc::Ref<id<MTLTexture>>;
+
+    // Empty if there is no cooked file or the device can not sample its format.
+    // `index` is the handle the texture gets, streamed levels are tracked by it.
+    TextureRef load_cooked_texture(const std::filesystem::path& file_path, size_t index);
+    MTLPixelFormat get_pixel_format(TextureFormat format) const;
+
+    // reload keeps page textures in place, so the layout has to stay the same
+    void load_atlas();
+
+    void prepare_image(Image& image, const std::filesystem::path& file_path) const;
+    TextureRef make_texture(const Image& image);
+    TextureRef make_texture(TextureFormat format, const std::vector<TextureLevelData>& levels);
+    // levels from `top_level` on, safe to call on a worker thread
+    TextureRef make_texture(const TextureFile& file, size_t top_level);
+
 private:
     id<MTLDevice> _device;
+    const AssetStorage& _asset_storage;
+    const Settings _settings;
 
-    using TextureRef = objc::Ref<id<MTLTexture>>;
-    std::vector<TextureRef> _textures;
+    SlotMap<TextureRef> _textures;
+    TextureCache _cache;
+
+    // empty until the atlas is loaded, handles of page textures in `_textures`
+    std::vector<TextureRegion> _atlas_regions;
+    std::vector<size_t> _atlas_pages;
+
+    // reset after every batch, capacity is kept for the next one
+    std::vector<std::unique_ptr<StagingArena>> _staging_arenas;
+
+    struct PendingLevels
+    {
+        size_t index = 0;
+        std::future<TextureRef> texture;
+    };
+
+    TextureStreamer _streamer;
+    uint64_t _frame = 1;
+    std::unordered_map<size_t, std::shared_ptr<TextureFile>> _streamed_files;
+    // last member, workers finish before the rest is destroyed
+    std::vector<PendingLevels> _pending_levels;
 };
 
 }
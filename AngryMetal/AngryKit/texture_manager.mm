@@ -7,87 +7,296 @@
 
 #include "texture_manager.h"
 
-#import <Accelerate/Accelerate.h>
-
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <sstream>
 #include <stdexcept>
 
-#include "image.hpp"
+#include "load_profiler.hpp"
+#include "memory_tracker.hpp"
+#include "texture_cooker.hpp"
 
 using namespace angry;
 
-TextureManager::TextureManager(id<MTLDevice> device) : _device(device)
+namespace
+{
+
+// formats the manager does not create are counted as BGRA
+TextureFormat get_texture_format(MTLPixelFormat pixel_format)
+{
+    switch (pixel_format)
+    {
+        case MTLPixelFormatR8Unorm:
+            return TextureFormat::r8_unorm;
+        case MTLPixelFormatASTC_4x4_LDR:
+            return TextureFormat::astc_4x4;
+        default:
+            break;
+    }
+
+    if (@available(iOS 16.4, *))
+    {
+        switch (pixel_format)
+        {
+            case MTLPixelFormatBC1_RGBA:
+                return TextureFormat::bc1;
+            case MTLPixelFormatBC3_RGBA:
+                return TextureFormat::bc3;
+            case MTLPixelFormatBC4_RUnorm:
+                return TextureFormat::bc4;
+            case MTLPixelFormatBC5_RGUnorm:
+                return TextureFormat::bc5;
+            default:
+                break;
+        }
+    }
+    return TextureFormat::bgra8_unorm;
+}
+
+// the top level is the base, everything else the allocation holds counts as mip levels
+void track_texture(id<MTLTexture> texture, bool is_added)
+{
+    if (texture == nil)
+    {
+        return;
+    }
+
+    const auto format = get_texture_format(texture.pixelFormat);
+    const size_t base_bytes = get_level_size(format, int(texture.width), int(texture.height));
+    const size_t allocated_bytes = texture.allocatedSize;
+    const size_t mip_bytes = allocated_bytes > base_bytes ? allocated_bytes - base_bytes : 0;
+    if (is_added)
+    {
+        track_texture_memory(format, base_bytes, mip_bytes);
+    }
+    else
+    {
+        untrack_texture_memory(format, base_bytes, mip_bytes);
+    }
+}
+
+bool is_same_region(const TextureRegion& a, const TextureRegion& b)
+{
+    return a.texture == b.texture
+        && a.uv_transform.x == b.uv_transform.x
+        && a.uv_transform.y == b.uv_transform.y
+        && a.uv_transform.z == b.uv_transform.z
+        && a.uv_transform.w == b.uv_transform.w;
+}
+
+}
+
+TextureManager::TextureManager(id<MTLDevice> device, const AssetStorage& asset_storage, const Settings& settings)
+    : _device(device), _asset_storage(asset_storage), _settings(settings), _streamer(settings.streaming)
 {
 }
 
 size_t TextureManager::create_texture(const std::filesystem::path& file_path)
 {
-    Image image(file_path);
+    return create_textures({file_path}).front();
+}
 
-    MTLPixelFormat pixel_format = MTLPixelFormatInvalid;
-    std::vector<unsigned char> buffer;
-    NSUInteger bytes_per_row = 0;
-    switch (image.components)
+std::vector<size_t> TextureManager::create_textures(const std::vector<std::filesystem::path>& file_paths)
+{
+    std::vector<size_t> result(file_paths.size());
+
+    // cooked textures are uploaded straight from the mapped file, the rest is decoded
+    std::vector<std::filesystem::path> source_paths;
+    std::vector<size_t> source_indices;
+    for (size_t i = 0; i < file_paths.size(); i++)
     {
-        case 1:
+        if (const auto texture = _cache.acquire(file_paths[i]))
         {
-            // grey
+            result[i] = *texture;
+            continue;
+        }
 
-            pixel_format = MTLPixelFormatR8Unorm;
-            bytes_per_row = 1 * image.width;
-            break;
+        auto texture = load_cooked_texture(file_paths[i], _textures.get_next_handle());
+        if (!texture)
+        {
+            source_paths.push_back(file_paths[i]);
+            source_indices.push_back(i);
+            continue;
         }
 
-        case 3:
+        result[i] = _textures.insert(texture);
+        _cache.add(result[i], file_paths[i], TextureContentKey(), texture.get().allocatedSize);
+        track_texture(texture.get(), true);
+    }
+
+    if (source_paths.empty())
+    {
+        return result;
+    }
+
+    // one arena per file, callbacks run concurrently
+    while (_staging_arenas.size() < source_paths.size())
+    {
+        _staging_arenas.push_back(std::make_unique<StagingArena>());
+    }
+
+    // the cache is not changed until the batch is read, files it already has are not decoded
+    std::vector<TextureContentKey> keys(source_paths.size());
+    std::vector<std::unique_ptr<Image>> images(source_paths.size());
+    _asset_storage.read(source_paths, [&](size_t index, std::vector<uint8_t>& data) {
+        keys[index] = get_texture_content_key(data.data(), data.size());
+        if (_cache.find(keys[index]))
         {
-            // red, green, blue
+            return;
+        }
 
-            vImage_Buffer source;
-            source.data = image.data;
-            source.height = image.height;
-            source.width = image.width;
-            source.rowBytes = 3 * image.width;
+        const auto item = source_paths[index].filename().string();
+        {
+            LoadProfiler::Scope scope("image_decode", item);
+            images[index] = std::make_unique<Image>(data.data(), data.size(), *_staging_arenas[index]);
+        }
 
-            vImage_Buffer target;
-            buffer.resize(4 * image.width * image.height);
-            target.data = buffer.data();
-            target.height = image.height;
-            target.width = image.width;
-            target.rowBytes = 4 * image.width;
+        prepare_image(*images[index], source_paths[index]);
+    });
 
-            if (vImageConvert_RGB888toBGRA8888(&source, NULL, 0, &target, NO, kvImageNoFlags) != kvImageNoError)
-            {
-                throw std::runtime_error("create_texture() fail to convert from RGB888 to BGRA8888");
-            }
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        // identical files in one batch are decoded, only the first one is uploaded
+        if (const auto texture = _cache.find(keys[i]))
+        {
+            _cache.acquire(*texture, source_paths[i]);
+            result[source_indices[i]] = *texture;
+            continue;
+        }
 
-            pixel_format = MTLPixelFormatBGRA8Unorm;
-            bytes_per_row = 4 * image.width;
+        LoadProfiler::Scope scope("texture_upload", source_paths[i].filename().string());
+        auto texture = make_texture(*images[i]);
+        result[source_indices[i]] = _textures.insert(texture);
+        _cache.add(result[source_indices[i]], source_paths[i], keys[i], texture.get().allocatedSize);
+        track_texture(texture.get(), true);
+    }
+
+    images.clear();
+    for (auto& arena : _staging_arenas)
+    {
+        arena->reset();
+    }
+    return result;
+}
+
+TextureRegion TextureManager::create_texture_region(const std::filesystem::path& file_path)
+{
+    const auto& atlas_paths = _settings.atlas_paths;
+    const auto p = std::find(atlas_paths.cbegin(), atlas_paths.cend(), file_path);
+    if (p == atlas_paths.cend())
+    {
+        TextureRegion region;
+        region.texture = create_texture(file_path);
+        return region;
+    }
+
+    // every listed image is packed at once so they share pages
+    if (_atlas_regions.empty())
+    {
+        load_atlas();
+    }
+    return _atlas_regions[p - atlas_paths.cbegin()];
+}
+
+std::optional<size_t> TextureManager::reload_texture(const std::filesystem::path& file_path)
+{
+    const auto& atlas_paths = _settings.atlas_paths;
+    if (!_atlas_regions.empty() && std::find(atlas_paths.cbegin(), atlas_paths.cend(), file_path) != atlas_paths.cend())
+    {
+        load_atlas();
+        return std::nullopt;
+    }
+
+    const auto index = _cache.find(file_path);
+    if (!index)
+    {
+        return std::nullopt;
+    }
+
+    // a saved but unchanged file is not decoded again, edited source wins over a cooked file
+    const auto file_data = _asset_storage.read(file_path);
+    const auto key = get_texture_content_key(file_data.data(), file_data.size());
+    if (_cache.is_current(*index, key))
+    {
+        return std::nullopt;
+    }
+
+    Image image(file_data.data(), file_data.size());
+    prepare_image(image, file_path);
+
+    // files which shared the content keep it, the edited one gets a texture of its own
+    if (_cache.is_shared(*index))
+    {
+        auto texture = make_texture(image);
+        const auto copy = _textures.insert(texture);
+        track_texture(texture.get(), true);
+        _cache.split(*index, file_path, copy, key, texture.get().allocatedSize);
+        return copy;
+    }
+
+    _streamer.remove(*index);
+    _streamed_files.erase(*index);
+
+    // command buffers in flight keep the previous texture alive
+    auto& texture = _textures.get(*index);
+    track_texture(texture.get(), false);
+    texture = make_texture(image);
+    track_texture(texture.get(), true);
+    _cache.update(*index, key, texture.get().allocatedSize);
+    return std::nullopt;
+}
+
+void TextureManager::release_texture(size_t index)
+{
+    // atlas pages are not in the cache, they live as long as the manager
+    if (_cache.release(index))
+    {
+        // command buffers in flight retain the texture, the slot is free at once
+        track_texture(_textures.erase(index).get(), false);
+        _streamer.remove(index);
+        _streamed_files.erase(index);
+    }
+}
+
+void TextureManager::prepare_image(Image& image, const std::filesystem::path& file_path) const
+{
+    const auto item = file_path.filename().string();
+    {
+        LoadProfiler::Scope scope("texture_conversion", item);
+        image.convert_to_bgra();
+    }
+
+    if (_settings.is_mipmapped)
+    {
+        LoadProfiler::Scope scope("mipmap_generation", item);
+        image.generate_mipmaps(get_mipmap_content(file_path), _settings.mipmap_filter);
+    }
+}
+
+TextureManager::TextureRef TextureManager::make_texture(const Image& image)
+{
+    MTLPixelFormat pixel_format = MTLPixelFormatInvalid;
+    NSUInteger bytes_per_row = 0;
+    switch (image.components)
+    {
+        case 1:
+        {
+            // grey
+
+            pixel_format = MTLPixelFormatR8Unorm;
+            bytes_per_row = 1 * image.width;
             break;
         }
 
         case 4:
         {
-            // red, green, blue, alpha
+            // blue, green, red, alpha
 
-            vImage_Buffer source;
-            source.data = image.data;
-            source.height = image.height;
-            source.width = image.width;
-            source.rowBytes = 4 * image.width;
-
-            vImage_Buffer target;
-            buffer.resize(4 * image.width * image.height);
-            target.data = buffer.data();
-            target.height = image.height;
-            target.width = image.width;
-            target.rowBytes = 4 * image.width;
-
-            // from RGBA (0, 1, 2, 3) to BGRA
-            const uint8_t permute_map[4] = {2, 1, 0, 3};
-            if (vImagePermuteChannels_ARGB8888(&source, &target, permute_map, kvImageNoFlags) != kvImageNoError)
+            if (!image.is_bgra)
             {
-                throw std::runtime_error("create_texture() fail to permute channels");
+                throw std::runtime_error("TextureManager::make_texture() image is not converted to BGRA");
             }
 
             pixel_format = MTLPixelFormatBGRA8Unorm;
@@ -106,21 +315,278 @@ size_t TextureManager::create_texture(const std::filesystem::path& file_path)
     auto* descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:pixel_format
                                                                           width:image.width
                                                                          height:image.height
-                                                                      mipmapped:NO];
+                                                                      mipmapped:!image.mip_levels.empty()];
     descriptor.storageMode = MTLStorageModeShared;
     TextureRef texture([_device newTextureWithDescriptor:descriptor]);
 
     MTLRegion region = MTLRegionMake2D(0, 0, image.width, image.height);
-    const void* pixel_bytes = buffer.empty() ? image.data : buffer.data();
-    [texture.get() replaceRegion:region mipmapLevel:0 withBytes:pixel_bytes bytesPerRow:bytes_per_row];
+    [texture.get() replaceRegion:region mipmapLevel:0 withBytes:image.data bytesPerRow:bytes_per_row];
+
+    const NSUInteger bytes_per_pixel = bytes_per_row / image.width;
+    for (size_t i = 0; i < image.mip_levels.size(); i++)
+    {
+        const auto& level = image.mip_levels[i];
+        region = MTLRegionMake2D(0, 0, level.width, level.height);
+        [texture.get() replaceRegion:region
+                         mipmapLevel:i + 1
+                           withBytes:level.data
+                         bytesPerRow:bytes_per_pixel * level.width];
+    }
+
+    return texture;
+}
+
+TextureManager::TextureRef TextureManager::load_cooked_texture(const std::filesystem::path& file_path, size_t index)
+{
+    const auto cooked_path = get_cooked_texture_path(file_path);
+    std::error_code error;
+    if (!std::filesystem::exists(cooked_path, error))
+    {
+        return TextureRef();
+    }
+
+    LoadProfiler::Scope scope("texture_upload", cooked_path.filename().string());
+    auto file = std::make_shared<TextureFile>(cooked_path);
+    const auto& header = file->get_header();
+    if (get_pixel_format(header.format) == MTLPixelFormatInvalid)
+    {
+        return TextureRef();
+    }
+
+    size_t base_level = 0;
+    if (_settings.is_streamed)
+    {
+        std::vector<int> level_sizes;
+        std::vector<size_t> level_bytes;
+        for (size_t i = 0; i < header.level_count; i++)
+        {
+            const auto& level = file->get_level(i);
+            level_sizes.push_back(int(std::max(level.width, level.height)));
+            level_bytes.push_back(level.size);
+        }
+
+        // the file stays mapped, higher levels are read from it when they are requested
+        base_level = _streamer.get_base_level(level_sizes);
+        if (base_level > 0)
+        {
+            _streamer.add(index, std::move(level_bytes), base_level);
+            _streamed_files[index] = file;
+        }
+    }
+    return make_texture(*file, base_level);
+}
 
-    size_t index = _textures.size();
-    _textures.push_back(texture);
+TextureManager::TextureRef TextureManager::make_texture(const TextureFile& file, size_t top_level)
+{
+    std::vector<TextureLevelData> levels;
+    for (size_t i = top_level; i < file.get_header().level_count; i++)
+    {
+        const auto& level = file.get_level(i);
+        levels.push_back(TextureLevelData{int(level.width), int(level.height), file.get_level_data(i)});
+    }
+    return make_texture(file.get_header().format, levels);
+}
+
+TextureManager::TextureRef TextureManager::make_texture(TextureFormat format, const std::vector<TextureLevelData>& levels)
+{
+    auto* descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:get_pixel_format(format)
+                                                                          width:levels.front().width
+                                                                         height:levels.front().height
+                                                                      mipmapped:NO];
+    descriptor.mipmapLevelCount = levels.size();
+    descriptor.storageMode = MTLStorageModeShared;
+    TextureRef texture([_device newTextureWithDescriptor:descriptor]);
 
-    return index;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        const auto& level = levels[i];
+        [texture.get() replaceRegion:MTLRegionMake2D(0, 0, level.width, level.height)
+                         mipmapLevel:i
+                           withBytes:level.data
+                         bytesPerRow:get_bytes_per_row(format, level.width)];
+    }
+
+    return texture;
+}
+
+void TextureManager::load_atlas()
+{
+    const auto& file_paths = _settings.atlas_paths;
+    while (_staging_arenas.size() < file_paths.size())
+    {
+        _staging_arenas.push_back(std::make_unique<StagingArena>());
+    }
+
+    // pages get mips of their own, images are only converted
+    std::vector<std::unique_ptr<Image>> images(file_paths.size());
+    _asset_storage.read(file_paths, [&](size_t index, std::vector<uint8_t>& data) {
+        LoadProfiler::Scope scope("image_decode", file_paths[index].filename().string());
+        images[index] = std::make_unique<Image>(data.data(), data.size(), *_staging_arenas[index]);
+        images[index]->convert_to_bgra();
+    });
+
+    std::vector<AtlasImage> atlas_images;
+    for (const auto& image : images)
+    {
+        atlas_images.push_back(AtlasImage{image->width, image->height, image->components, image->data});
+    }
+
+    Atlas atlas;
+    {
+        LoadProfiler::Scope scope("atlas_packing");
+        atlas = build_atlas(atlas_images, _settings.atlas);
+    }
+
+    images.clear();
+    for (auto& arena : _staging_arenas)
+    {
+        arena->reset();
+    }
+
+    if (!_atlas_regions.empty())
+    {
+        bool is_same_layout = atlas.pages.size() == _atlas_pages.size();
+        for (size_t i = 0; is_same_layout && i < atlas.regions.size(); i++)
+        {
+            auto region = atlas.regions[i];
+            region.texture = _atlas_pages[region.texture];
+            is_same_layout = is_same_region(region, _atlas_regions[i]);
+        }
+
+        if (!is_same_layout)
+        {
+            throw std::runtime_error("TextureManager::load_atlas() image size changed, restart to repack the atlas");
+        }
+    }
+
+    for (size_t i = 0; i < atlas.pages.size(); i++)
+    {
+        LoadProfiler::Scope scope("texture_upload", "atlas");
+        const auto& page = atlas.pages[i];
+        std::vector<TextureLevelData> levels;
+        for (size_t level = 0; level < page.level_offsets.size(); level++)
+        {
+            levels.push_back(TextureLevelData{
+                get_mip_level_size(page.width, level),
+                get_mip_level_size(page.height, level),
+                page.pixels.data() + page.level_offsets[level]
+            });
+        }
+
+        auto texture = make_texture(TextureFormat::bgra8_unorm, levels);
+        if (_atlas_pages.size() == i)
+        {
+            _atlas_pages.push_back(_textures.insert(texture));
+            track_texture(texture.get(), true);
+        }
+        else
+        {
+            // command buffers in flight keep the previous page alive
+            auto& page = _textures.get(_atlas_pages[i]);
+            track_texture(page.get(), false);
+            page = texture;
+            track_texture(texture.get(), true);
+        }
+    }
+
+    if (_atlas_regions.empty())
+    {
+        for (auto region : atlas.regions)
+        {
+            region.texture = _atlas_pages[region.texture];
+            _atlas_regions.push_back(region);
+        }
+    }
+}
+
+MTLPixelFormat TextureManager::get_pixel_format(TextureFormat format) const
+{
+    switch (format)
+    {
+        case TextureFormat::r8_unorm:
+            return MTLPixelFormatR8Unorm;
+
+        case TextureFormat::bgra8_unorm:
+            return MTLPixelFormatBGRA8Unorm;
+
+        case TextureFormat::astc_4x4:
+            return [_device supportsFamily:MTLGPUFamilyApple2] ? MTLPixelFormatASTC_4x4_LDR : MTLPixelFormatInvalid;
+
+        case TextureFormat::bc1:
+        case TextureFormat::bc3:
+        case TextureFormat::bc4:
+        case TextureFormat::bc5:
+        {
+            if (@available(iOS 16.4, *))
+            {
+                if (!_device.supportsBCTextureCompression)
+                {
+                    return MTLPixelFormatInvalid;
+                }
+
+                switch (format)
+                {
+                    case TextureFormat::bc1:
+                        return MTLPixelFormatBC1_RGBA;
+                    case TextureFormat::bc3:
+                        return MTLPixelFormatBC3_RGBA;
+                    case TextureFormat::bc4:
+                        return MTLPixelFormatBC4_RUnorm;
+                    default:
+                        return MTLPixelFormatBC5_RGUnorm;
+                }
+            }
+            return MTLPixelFormatInvalid;
+        }
+    }
+    return MTLPixelFormatInvalid;
 }
 
 id<MTLTexture> TextureManager::get_texture(size_t index)
 {
-    return _textures[index].get();
+    return _textures.get(index).get();
+}
+
+void TextureManager::update_streaming()
+{
+    // a finished texture replaces the previous one, command buffers in flight keep that alive
+    for (auto p = _pending_levels.begin(); p != _pending_levels.end();)
+    {
+        if (p->texture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++p;
+            continue;
+        }
+
+        auto texture = p->texture.get();
+        if (_streamer.complete(p->index))
+        {
+            auto& streamed = _textures.get(p->index);
+            track_texture(streamed.get(), false);
+            streamed = texture;
+            track_texture(texture.get(), true);
+        }
+        p = _pending_levels.erase(p);
+    }
+
+    for (const auto& request : _streamer.update(_frame))
+    {
+        auto file = _streamed_files.at(request.texture);
+        auto texture = std::async(std::launch::async, [this, file, top_level = request.top_level]() {
+            return make_texture(*file, top_level);
+        });
+        _pending_levels.push_back(PendingLevels{request.texture, std::move(texture)});
+    }
+
+    _frame += 1;
+}
+
+void TextureManager::mark_used(size_t index)
+{
+    _streamer.mark_used(index, _frame);
+}
+
+const TextureCache::Statistics& TextureManager::get_cache_statistics() const
+{
+    return _cache.get_statistics();
 }
@@ -8,15 +8,41 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <simd/simd.h>
 
 namespace angry
 {
 
+struct TextureRegion
+{
+    size_t texture = 0;
+    // uv * xy + zw, identity for a texture of its own
+    simd_float4 uv_transform = {1.0f, 1.0f, 0.0f, 0.0f};
+};
+
 struct TextureManagerInterface
 {
     virtual ~TextureManagerInterface() = default;
 
+    // a path or file content loaded before returns the same texture with one more reference
     virtual size_t create_texture(const std::filesystem::path& file_path) = 0;
+
+    // files are read in one batch and decoded as they arrive
+    virtual std::vector<size_t> create_textures(const std::vector<std::filesystem::path>& file_paths) = 0;
+
+    // small images may share an atlas page, draws with the same page need no texture rebind
+    virtual TextureRegion create_texture_region(const std::filesystem::path& file_path) = 0;
+
+    // Replaces content of the texture created from `file_path`, its index stays valid. A texture
+    // other files share is copied on write instead: the new one with one reference is returned
+    // and the caller swaps it in for the references it holds through `file_path`.
+    virtual std::optional<size_t> reload_texture(const std::filesystem::path& file_path) = 0;
+
+    // the texture is destroyed when its last reference is released, its handle stops resolving
+    virtual void release_texture(size_t index) = 0;
 };
 
 }
@@ -0,0 +1,203 @@
+//
+//  texture_streamer.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_streamer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace angry;
+
+TextureStreamer::TextureStreamer(const Settings& settings) : _settings(settings)
+{
+}
+
+size_t TextureStreamer::get_base_level(const std::vector<int>& level_sizes) const
+{
+    for (size_t i = 0; i < level_sizes.size(); i++)
+    {
+        if (level_sizes[i] <= _settings.resident_size)
+        {
+            return i;
+        }
+    }
+    return level_sizes.empty() ? 0 : level_sizes.size() - 1;
+}
+
+void TextureStreamer::add(size_t texture, std::vector<size_t> level_bytes, size_t base_level)
+{
+    Entry entry;
+    entry.level_bytes = std::move(level_bytes);
+    entry.base_level = base_level;
+    entry.top_level = base_level;
+    entry.pending_level = base_level;
+
+    _resident_bytes += get_bytes(entry, base_level);
+    _entries[texture] = std::move(entry);
+}
+
+void TextureStreamer::remove(size_t texture)
+{
+    const auto p = _entries.find(texture);
+    if (p == _entries.end())
+    {
+        return;
+    }
+
+    // a request in flight has its bytes committed already
+    _resident_bytes -= get_bytes(p->second, p->second.pending_level);
+    if (p->second.is_pending)
+    {
+        _pending_count -= 1;
+    }
+    _entries.erase(p);
+}
+
+bool TextureStreamer::contains(size_t texture) const
+{
+    return _entries.find(texture) != _entries.end();
+}
+
+void TextureStreamer::mark_used(size_t texture, uint64_t frame)
+{
+    const auto p = _entries.find(texture);
+    if (p != _entries.end())
+    {
+        p->second.last_used_frame = frame;
+    }
+}
+
+std::vector<TextureStreamer::Request> TextureStreamer::update(uint64_t frame)
+{
+    std::vector<Request> result;
+
+    std::vector<std::pair<size_t, Entry*>> order;
+    order.reserve(_entries.size());
+    for (auto& e : _entries)
+    {
+        if (!e.second.is_pending)
+        {
+            order.emplace_back(e.first, &e.second);
+        }
+    }
+
+    // least recently drawn first, ties in texture order keep decisions stable
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        if (a.second->last_used_frame != b.second->last_used_frame)
+        {
+            return a.second->last_used_frame < b.second->last_used_frame;
+        }
+        return a.first < b.first;
+    });
+
+    const auto is_idle = [&](const Entry& entry) {
+        return frame - entry.last_used_frame > _settings.idle_frames;
+    };
+
+    for (auto& [texture, entry] : order)
+    {
+        if (_pending_count == _settings.max_pending_count)
+        {
+            return result;
+        }
+
+        if (entry->top_level < entry->base_level && is_idle(*entry))
+        {
+            request(texture, *entry, entry->base_level, result);
+        }
+    }
+
+    for (auto& [texture, entry] : order)
+    {
+        if (_resident_bytes <= _settings.budget_bytes || _pending_count == _settings.max_pending_count)
+        {
+            break;
+        }
+
+        if (!entry->is_pending && entry->top_level < entry->base_level)
+        {
+            request(texture, *entry, entry->top_level + 1, result);
+        }
+    }
+
+    for (auto p = order.rbegin(); p != order.rend(); ++p)
+    {
+        auto& [texture, entry] = *p;
+        // frames start at 1, never drawn textures stay at their base level
+        if (_pending_count == _settings.max_pending_count || entry->last_used_frame == 0 || is_idle(*entry))
+        {
+            break;
+        }
+
+        if (entry->is_pending || entry->top_level == 0)
+        {
+            continue;
+        }
+
+        if (_resident_bytes + entry->level_bytes[entry->top_level - 1] <= _settings.budget_bytes)
+        {
+            request(texture, *entry, entry->top_level - 1, result);
+            continue;
+        }
+
+        // the least recently drawn texture gives a level back, the load fits on a later frame
+        const auto victim = std::find_if(order.begin(), order.end(), [&](const auto& e) {
+            return !e.second->is_pending
+                && e.second->top_level < e.second->base_level
+                && e.second->last_used_frame < entry->last_used_frame;
+        });
+        if (victim != order.end())
+        {
+            request(victim->first, *victim->second, victim->second->top_level + 1, result);
+        }
+
+        // more recently drawn textures are not passed over for smaller levels of older ones
+        break;
+    }
+
+    return result;
+}
+
+bool TextureStreamer::complete(size_t texture)
+{
+    const auto p = _entries.find(texture);
+    if (p == _entries.end() || !p->second.is_pending)
+    {
+        return false;
+    }
+
+    p->second.top_level = p->second.pending_level;
+    p->second.is_pending = false;
+    _pending_count -= 1;
+    return true;
+}
+
+size_t TextureStreamer::get_resident_bytes() const
+{
+    return _resident_bytes;
+}
+
+const TextureStreamer::Settings& TextureStreamer::get_settings() const
+{
+    return _settings;
+}
+
+size_t TextureStreamer::get_bytes(const Entry& entry, size_t top_level) const
+{
+    return std::accumulate(entry.level_bytes.cbegin() + top_level, entry.level_bytes.cend(), size_t(0));
+}
+
+void TextureStreamer::request(size_t texture, Entry& entry, size_t top_level, std::vector<Request>& requests)
+{
+    _resident_bytes -= get_bytes(entry, entry.top_level);
+    _resident_bytes += get_bytes(entry, top_level);
+
+    entry.pending_level = top_level;
+    entry.is_pending = true;
+    _pending_count += 1;
+    requests.push_back(Request{texture, top_level});
+}
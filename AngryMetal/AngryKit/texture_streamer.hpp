@@ -0,0 +1,89 @@
+//
+//  texture_streamer.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace angry
+{
+
+// Decides which mip levels of streamed textures are resident. Only the bookkeeping lives
+// here, the texture manager loads levels and reports back with `complete`.
+class TextureStreamer final
+{
+public:
+    struct Settings
+    {
+        // memory of all streamed levels, levels loaded with the texture count as well
+        size_t budget_bytes = 128 * 1024 * 1024;
+        // levels up to this size are loaded with the texture and never evicted
+        int resident_size = 128;
+        // textures not drawn for this long give their streamed levels back
+        uint64_t idle_frames = 300;
+        // requests in flight, each one is a texture rebuilt on a worker thread
+        size_t max_pending_count = 4;
+    };
+
+    struct Request
+    {
+        size_t texture = 0;
+        // new first resident level
+        size_t top_level = 0;
+    };
+
+public:
+    explicit TextureStreamer(const Settings& settings);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer(TextureStreamer&&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+    // first level which is loaded with the texture
+    size_t get_base_level(const std::vector<int>& level_sizes) const;
+
+    void add(size_t texture, std::vector<size_t> level_bytes, size_t base_level);
+    void remove(size_t texture);
+    bool contains(size_t texture) const;
+
+    void mark_used(size_t texture, uint64_t frame);
+
+    // Most recently drawn textures get one finer level per request while the budget allows,
+    // idle and then least recently drawn ones lose levels. Bytes are committed on request.
+    std::vector<Request> update(uint64_t frame);
+    // false if the texture was removed while its request was in flight
+    bool complete(size_t texture);
+
+    size_t get_resident_bytes() const;
+    const Settings& get_settings() const;
+
+private:
+    struct Entry
+    {
+        std::vector<size_t> level_bytes;
+        size_t base_level = 0;
+        size_t top_level = 0;
+        size_t pending_level = 0;
+        bool is_pending = false;
+        uint64_t last_used_frame = 0;
+    };
+
+    size_t get_bytes(const Entry& entry, size_t top_level) const;
+    void request(size_t texture, Entry& entry, size_t top_level, std::vector<Request>& requests);
+
+private:
+    const Settings _settings;
+    std::unordered_map<size_t, Entry> _entries;
+    size_t _resident_bytes = 0;
+    size_t _pending_count = 0;
+};
+
+}
@@ -0,0 +1,255 @@
+//
+//  texture_streaming_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "texture_streaming_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "on_exit.hpp"
+#include "texture_file.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+struct StreamedTexture
+{
+    std::unique_ptr<TextureFile> file;
+    size_t top_level = 0;
+    // what the GPU texture would hold, replaced when a request is done
+    std::vector<uint8_t> levels;
+};
+
+struct PendingLevels
+{
+    size_t texture = 0;
+    size_t top_level = 0;
+    std::future<std::vector<uint8_t>> levels;
+};
+
+std::vector<std::filesystem::path> find_cooked_textures(const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> result;
+    std::error_code error;
+    if (directory.empty() || !std::filesystem::is_directory(directory, error))
+    {
+        return result;
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".atex")
+        {
+            result.push_back(entry.path());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::filesystem::path> write_textures(const TextureStreamingBenchmarkSettings& settings,
+                                                  const std::filesystem::path& directory)
+{
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::filesystem::path> result;
+    for (size_t i = 0; i < settings.texture_count; i++)
+    {
+        // every level has a value of its own so a wrong level shows up in a capture
+        std::vector<std::vector<uint8_t>> pixels;
+        for (int size = settings.texture_size; size > 0; size /= 2)
+        {
+            pixels.emplace_back(size_t(size) * size_t(size) * 4, uint8_t(i * 16 + pixels.size()));
+        }
+
+        std::vector<TextureLevelData> levels;
+        for (size_t level = 0; level < pixels.size(); level++)
+        {
+            const int size = settings.texture_size >> level;
+            levels.push_back(TextureLevelData{size, size, pixels[level].data()});
+        }
+
+        result.push_back(directory / ("texture_" + std::to_string(i) + ".atex"));
+        write_texture_file(result.back(), TextureFormat::bgra8_unorm, levels);
+    }
+    return result;
+}
+
+// TextureManager::make_texture() with a file and a top level, without the device
+std::vector<uint8_t> load_levels(const TextureFile& file, size_t top_level)
+{
+    std::vector<uint8_t> result;
+    for (size_t i = top_level; i < file.get_header().level_count; i++)
+    {
+        const auto* data = file.get_level_data(i);
+        result.insert(result.end(), data, data + file.get_level(i).size);
+    }
+    return result;
+}
+
+}
+
+void angry::run_texture_streaming_benchmark(const TextureStreamingBenchmarkSettings& settings, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto file_paths = find_cooked_textures(settings.assets_path);
+    const bool is_generated = file_paths.empty();
+    const auto generated_path = std::filesystem::temp_directory_path() / "angry_texture_streaming";
+    OnExit remove_generated([&]() {
+        std::error_code error;
+        if (is_generated)
+        {
+            std::filesystem::remove_all(generated_path, error);
+        }
+    });
+    if (is_generated)
+    {
+        file_paths = write_textures(settings, generated_path);
+    }
+
+    size_t full_bytes = 0;
+    for (const auto& file_path : file_paths)
+    {
+        const TextureFile file(file_path);
+        for (size_t i = 0; i < file.get_header().level_count; i++)
+        {
+            full_bytes += file.get_level(i).size;
+        }
+    }
+
+    output << "{\"textures\": " << file_paths.size()
+        << ", \"generated\": " << (is_generated ? "true" : "false")
+        << ", \"full_bytes\": " << full_bytes
+        << ", \"frame_count\": " << settings.frame_count
+        << ", \"drawn_count\": " << settings.drawn_count
+        << ", \"runs\": [";
+
+    for (size_t run = 0; run < settings.budgets.size(); run++)
+    {
+        auto streaming = settings.streaming;
+        streaming.budget_bytes = settings.budgets[run];
+        TextureStreamer streamer(streaming);
+
+        // same as TextureManager::load_cooked_texture(), small levels come with the texture
+        std::vector<StreamedTexture> textures(file_paths.size());
+        for (size_t i = 0; i < textures.size(); i++)
+        {
+            auto& texture = textures[i];
+            texture.file = std::make_unique<TextureFile>(file_paths[i]);
+
+            std::vector<int> level_sizes;
+            std::vector<size_t> level_bytes;
+            for (size_t level = 0; level < texture.file->get_header().level_count; level++)
+            {
+                const auto& file_level = texture.file->get_level(level);
+                level_sizes.push_back(int(std::max(file_level.width, file_level.height)));
+                level_bytes.push_back(file_level.size);
+            }
+
+            texture.top_level = streamer.get_base_level(level_sizes);
+            if (texture.top_level > 0)
+            {
+                streamer.add(i, std::move(level_bytes), texture.top_level);
+            }
+            texture.levels = load_levels(*texture.file, texture.top_level);
+        }
+        const size_t load_bytes = streamer.get_resident_bytes();
+
+        std::vector<PendingLevels> pending;
+        double update_seconds = 0.0;
+        double max_update_seconds = 0.0;
+        size_t finer_count = 0;
+        size_t coarser_count = 0;
+        size_t streamed_bytes = 0;
+        size_t max_resident_bytes = 0;
+        size_t draw_count = 0;
+        size_t top_level_draw_count = 0;
+        size_t drawn_level_sum = 0;
+
+        // frames start at 1 like in TextureManager
+        for (uint64_t frame = 1; frame <= settings.frame_count; frame++)
+        {
+            const auto update_start = Clock::now();
+
+            // TextureManager::update_streaming(), levels this size are rebuilt within a frame
+            for (auto& p : pending)
+            {
+                auto levels = p.levels.get();
+                if (streamer.complete(p.texture))
+                {
+                    streamed_bytes += levels.size();
+                    textures[p.texture].levels = std::move(levels);
+                    textures[p.texture].top_level = p.top_level;
+                }
+            }
+            pending.clear();
+
+            for (const auto& request : streamer.update(frame))
+            {
+                if (request.top_level < textures[request.texture].top_level)
+                {
+                    finer_count += 1;
+                }
+                else
+                {
+                    coarser_count += 1;
+                }
+
+                const auto* file = textures[request.texture].file.get();
+                auto levels = std::async(std::launch::async, [file, top_level = request.top_level]() {
+                    return load_levels(*file, top_level);
+                });
+                pending.push_back(PendingLevels{request.texture, request.top_level, std::move(levels)});
+            }
+
+            const double seconds = std::chrono::duration<double>(Clock::now() - update_start).count();
+            update_seconds += seconds;
+            max_update_seconds = std::max(max_update_seconds, seconds);
+            max_resident_bytes = std::max(max_resident_bytes, streamer.get_resident_bytes());
+
+            // the renderer marks textures while it draws, after the update of the frame
+            const size_t first = size_t(frame / std::max(settings.frames_per_texture, size_t(1)));
+            for (size_t k = 0; k < std::min(settings.drawn_count, textures.size()); k++)
+            {
+                const size_t index = (first + k) % textures.size();
+                streamer.mark_used(index, frame + 1);
+
+                draw_count += 1;
+                drawn_level_sum += textures[index].top_level;
+                top_level_draw_count += textures[index].top_level == 0 ? 1 : 0;
+            }
+        }
+
+        for (auto& p : pending)
+        {
+            p.levels.wait();
+        }
+
+        const double frame_count = double(std::max(settings.frame_count, size_t(1)));
+        output << (run == 0 ? "" : ", ")
+            << "{\"budget_bytes\": " << streaming.budget_bytes
+            << ", \"load_bytes\": " << load_bytes
+            << ", \"update_ms_mean\": " << update_seconds * 1000.0 / frame_count
+            << ", \"update_ms_max\": " << max_update_seconds * 1000.0
+            << ", \"finer_requests\": " << finer_count
+            << ", \"coarser_requests\": " << coarser_count
+            << ", \"streamed_bytes\": " << streamed_bytes
+            << ", \"resident_bytes\": " << streamer.get_resident_bytes()
+            << ", \"max_resident_bytes\": " << max_resident_bytes
+            << ", \"top_level_draws\": " << double(top_level_draw_count) / double(std::max(draw_count, size_t(1)))
+            << ", \"drawn_level_mean\": " << double(drawn_level_sum) / double(std::max(draw_count, size_t(1)))
+            << "}";
+    }
+
+    output << "]}\n";
+}
@@ -0,0 +1,43 @@
+//
+//  texture_streaming_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+#include "texture_streamer.hpp"
+
+namespace angry
+{
+
+struct TextureStreamingBenchmarkSettings
+{
+    // cooked .atex files found here are streamed, without them textures are generated
+    std::filesystem::path assets_path;
+    TextureStreamer::Settings streaming;
+    // every run uses its own budget, the rest of the settings is shared
+    std::vector<size_t> budgets = {4 * 1024 * 1024, 16 * 1024 * 1024};
+
+    size_t frame_count = 600;
+    // textures drawn in a frame, the window moves to the next texture every `frames_per_texture`
+    size_t drawn_count = 4;
+    size_t frames_per_texture = 30;
+
+    // generated textures, BGRA with a full mip chain
+    size_t texture_count = 16;
+    int texture_size = 512;
+};
+
+// Loads cooked textures at their base level the way the texture managers do and draws a
+// moving window of them, every request rebuilds the texture from the mapped file. Writes
+// update time, streamed bytes and how often drawn textures had their top level as JSON.
+void run_texture_streaming_benchmark(const TextureStreamingBenchmarkSettings& settings, std::ostream& output);
+
+}
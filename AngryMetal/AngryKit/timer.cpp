@@ -35,6 +35,12 @@ void Timer::update()
     _last_time = x;
 }
 
+void Timer::advance(float delta_time)
+{
+    _time_since_start += delta_time;
+    _delta_time = delta_time;
+}
+
 float Timer::get_time_since_start() const
 {
     return _time_since_start;
@@ -18,6 +18,8 @@ class Timer final
 public:
     void reset();
     void update();
+    // steps by a fixed delta instead of the clock, for simulations without a display
+    void advance(float delta_time);
 
     float get_time_since_start() const;
     float get_delta_time() const;
@@ -0,0 +1,533 @@
+//
+//  virtual_texture.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "virtual_texture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace angry;
+
+namespace
+{
+
+constexpr uint32_t level_shift = 28;
+constexpr uint32_t x_shift = 14;
+constexpr uint32_t coordinate_mask = max_virtual_page_count - 1;
+
+bool is_power_of_two(uint32_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// sorts by id and sums up duplicates
+void merge_requests(std::vector<PageRequest>& requests)
+{
+    if (requests.empty())
+    {
+        return;
+    }
+
+    std::sort(requests.begin(), requests.end(), [](const auto& a, const auto& b) {
+        return a.id < b.id;
+    });
+
+    size_t last = 0;
+    for (size_t i = 1; i < requests.size(); i++)
+    {
+        if (requests[i].id == requests[last].id)
+        {
+            requests[last].count += requests[i].count;
+            requests[last].is_requested = requests[last].is_requested || requests[i].is_requested;
+        }
+        else
+        {
+            requests[++last] = requests[i];
+        }
+    }
+    requests.resize(last + 1);
+}
+
+uint32_t get_level_count_for(uint32_t page_count)
+{
+    uint32_t result = 1;
+    while (page_count > 1)
+    {
+        page_count >>= 1;
+        result += 1;
+    }
+    return result;
+}
+
+}
+
+PageId angry::make_page_id(uint32_t level, uint32_t x, uint32_t y)
+{
+    return (level << level_shift) | ((x & coordinate_mask) << x_shift) | (y & coordinate_mask);
+}
+
+uint32_t angry::get_page_level(PageId id)
+{
+    return id >> level_shift;
+}
+
+uint32_t angry::get_page_x(PageId id)
+{
+    return (id >> x_shift) & coordinate_mask;
+}
+
+uint32_t angry::get_page_y(PageId id)
+{
+    return id & coordinate_mask;
+}
+
+PageId angry::get_parent_page(PageId id)
+{
+    return make_page_id(get_page_level(id) + 1, get_page_x(id) / 2, get_page_y(id) / 2);
+}
+
+PageTable::PageTable(uint32_t page_count) : _page_count(page_count)
+{
+    if (!is_power_of_two(page_count) || page_count > max_virtual_page_count)
+    {
+        throw std::runtime_error("PageTable::PageTable() page count is not a power of two up to 16384");
+    }
+
+    const uint32_t level_count = get_level_count_for(page_count);
+    // no page at all is one level coarser than the coarsest one
+    const Entry empty{invalid_slot, level_count};
+    for (uint32_t level = 0; level < level_count; level++)
+    {
+        const size_t count = get_page_count(level);
+        _levels.emplace_back(count * count, empty);
+    }
+}
+
+uint32_t PageTable::get_level_count() const
+{
+    return uint32_t(_levels.size());
+}
+
+uint32_t PageTable::get_page_count(uint32_t level) const
+{
+    return _page_count >> level;
+}
+
+void PageTable::map(PageId id, uint32_t slot)
+{
+    const uint32_t level = get_page_level(id);
+    assign(level, get_page_x(id), get_page_y(id), level, Entry{slot, level}, false);
+}
+
+void PageTable::unmap(PageId id)
+{
+    const uint32_t level = get_page_level(id);
+    const Entry fallback = level + 1 < get_level_count()
+        ? get_entry(get_parent_page(id))
+        : Entry{invalid_slot, get_level_count()};
+    assign(level, get_page_x(id), get_page_y(id), level, fallback, true);
+}
+
+const PageTable::Entry& PageTable::get_entry(PageId id) const
+{
+    const uint32_t level = get_page_level(id);
+    return _levels[level][size_t(get_page_y(id)) * get_page_count(level) + get_page_x(id)];
+}
+
+const std::vector<PageTable::Entry>& PageTable::get_entries(uint32_t level) const
+{
+    return _levels[level];
+}
+
+void PageTable::assign(uint32_t level, uint32_t x, uint32_t y, uint32_t page_level, const Entry& entry, bool is_unmap)
+{
+    // an entry is never coarser than the entry of its parent, so a finer one is kept with its subtree
+    auto& current = _levels[level][size_t(y) * get_page_count(level) + x];
+    if (current.level < page_level)
+    {
+        return;
+    }
+    if (is_unmap && current.level != page_level)
+    {
+        return;
+    }
+
+    current = entry;
+    if (level == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        assign(level - 1, 2 * x + (i & 1), 2 * y + (i >> 1), page_level, entry, is_unmap);
+    }
+}
+
+PhysicalPageCache::PhysicalPageCache(size_t slot_count) : _slots(slot_count)
+{
+    if (slot_count == 0 || slot_count >= invalid_slot)
+    {
+        throw std::runtime_error("PhysicalPageCache::PhysicalPageCache() wrong slot count");
+    }
+
+    for (uint32_t i = 0; i < uint32_t(slot_count); i++)
+    {
+        push_back(i);
+    }
+}
+
+std::optional<uint32_t> PhysicalPageCache::find(PageId id) const
+{
+    const auto p = _pages.find(id);
+    if (p == _pages.end())
+    {
+        return std::nullopt;
+    }
+    return p->second;
+}
+
+void PhysicalPageCache::touch(uint32_t slot, uint64_t frame)
+{
+    _slots[slot].last_used_frame = frame;
+    if (!_slots[slot].is_pinned)
+    {
+        unlink(slot);
+        push_back(slot);
+    }
+}
+
+std::optional<uint32_t> PhysicalPageCache::reserve(uint64_t frame, PageId& evicted)
+{
+    evicted = invalid_page;
+
+    if (!can_reserve(frame))
+    {
+        return std::nullopt;
+    }
+
+    const uint32_t slot = _head;
+    auto& entry = _slots[slot];
+    if (entry.page != invalid_page)
+    {
+        evicted = entry.page;
+        _pages.erase(entry.page);
+    }
+
+    unlink(slot);
+    entry.page = invalid_page;
+    entry.last_used_frame = frame;
+    return slot;
+}
+
+void PhysicalPageCache::commit(uint32_t slot, PageId id, uint64_t frame, bool is_pinned)
+{
+    auto& entry = _slots[slot];
+    entry.page = id;
+    entry.last_used_frame = frame;
+    entry.is_pinned = is_pinned;
+    if (!is_pinned)
+    {
+        push_back(slot);
+    }
+
+    _pages[id] = slot;
+}
+
+bool PhysicalPageCache::can_reserve(uint64_t frame) const
+{
+    // the list is in use order, if its head was used during this frame every slot was
+    return _head != invalid_slot && (_slots[_head].page == invalid_page || _slots[_head].last_used_frame != frame);
+}
+
+PageId PhysicalPageCache::get_page(uint32_t slot) const
+{
+    return _slots[slot].page;
+}
+
+size_t PhysicalPageCache::get_slot_count() const
+{
+    return _slots.size();
+}
+
+size_t PhysicalPageCache::get_resident_count() const
+{
+    return _pages.size();
+}
+
+void PhysicalPageCache::unlink(uint32_t slot)
+{
+    auto& entry = _slots[slot];
+    if (entry.previous != invalid_slot)
+    {
+        _slots[entry.previous].next = entry.next;
+    }
+    else
+    {
+        _head = entry.next;
+    }
+
+    if (entry.next != invalid_slot)
+    {
+        _slots[entry.next].previous = entry.previous;
+    }
+    else
+    {
+        _tail = entry.previous;
+    }
+
+    entry.previous = invalid_slot;
+    entry.next = invalid_slot;
+}
+
+void PhysicalPageCache::push_back(uint32_t slot)
+{
+    auto& entry = _slots[slot];
+    entry.previous = _tail;
+    entry.next = invalid_slot;
+    if (_tail != invalid_slot)
+    {
+        _slots[_tail].next = slot;
+    }
+    else
+    {
+        _head = slot;
+    }
+    _tail = slot;
+}
+
+void angry::analyze_feedback(const PageId* feedback, size_t count, uint32_t level_count, std::vector<PageRequest>& requests)
+{
+    requests.clear();
+
+    // ids outside of the texture are samples which did not hit it
+    const auto is_valid = [level_count](PageId id) {
+        const uint32_t level = get_page_level(id);
+        if (id == invalid_page || level >= level_count)
+        {
+            return false;
+        }
+        const uint32_t page_count = 1u << (level_count - 1 - level);
+        return get_page_x(id) < page_count && get_page_y(id) < page_count;
+    };
+
+    // neighbour samples mostly hit the same page, runs are collapsed before anything is sorted
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!is_valid(feedback[i]))
+        {
+            continue;
+        }
+
+        if (!requests.empty() && requests.back().id == feedback[i])
+        {
+            requests.back().count += 1;
+        }
+        else
+        {
+            requests.push_back(PageRequest{feedback[i], 1, true});
+        }
+    }
+    merge_requests(requests);
+
+    const size_t requested_count = requests.size();
+    for (size_t i = 0; i < requested_count; i++)
+    {
+        for (PageId id = requests[i].id; get_page_level(id) + 1 < level_count;)
+        {
+            id = get_parent_page(id);
+            requests.push_back(PageRequest{id, requests[i].count, false});
+        }
+    }
+    merge_requests(requests);
+}
+
+double VirtualTexture::Statistics::get_hit_rate() const
+{
+    return requested_count == 0 ? 0.0 : double(resident_hit_count) / double(requested_count);
+}
+
+VirtualTexture::VirtualTexture(const Settings& settings, PageProducer producer)
+    : _settings(settings)
+    , _producer(std::move(producer))
+    , _page_table(settings.page_count)
+    , _cache(settings.physical_page_count)
+{
+    if (_settings.page_size <= 0 || _settings.page_border < 0 || _settings.max_pending_count == 0)
+    {
+        throw std::runtime_error("VirtualTexture::VirtualTexture() wrong page settings");
+    }
+
+    // the coarsest page is the fallback of every other one
+    _frame = 1;
+    const PageId root = make_page_id(_page_table.get_level_count() - 1, 0, 0);
+    apply(root, *reserve(), produce(root), true);
+    _statistics.resident_count = _cache.get_resident_count();
+}
+
+VirtualTexture::~VirtualTexture()
+{
+    for (auto& page : _pending)
+    {
+        page.pixels.wait();
+    }
+}
+
+void VirtualTexture::update(const PageId* feedback, size_t count)
+{
+    _frame += 1;
+    _statistics.frame_count += 1;
+
+    analyze_feedback(feedback, count, _page_table.get_level_count(), _requests);
+
+    // pages of this frame are touched first so finished loads do not evict them
+    _missing.clear();
+    for (const auto& request : _requests)
+    {
+        const auto slot = _cache.find(request.id);
+        if (request.is_requested)
+        {
+            _statistics.requested_count += 1;
+            _statistics.resident_hit_count += slot ? 1 : 0;
+        }
+
+        if (slot)
+        {
+            _cache.touch(*slot, _frame);
+            continue;
+        }
+
+        const bool is_pending = std::any_of(_pending.cbegin(), _pending.cend(), [&](const auto& page) {
+            return page.id == request.id;
+        });
+        if (!is_pending)
+        {
+            _missing.push_back(request);
+        }
+    }
+
+    apply_finished(false);
+
+    std::sort(_missing.begin(), _missing.end(), [](const auto& a, const auto& b) {
+        const uint32_t a_level = get_page_level(a.id);
+        const uint32_t b_level = get_page_level(b.id);
+        if (a_level != b_level)
+        {
+            return a_level > b_level;
+        }
+        if (a.count != b.count)
+        {
+            return a.count > b.count;
+        }
+        return a.id < b.id;
+    });
+
+    for (const auto& request : _missing)
+    {
+        if (_pending.size() == _settings.max_pending_count)
+        {
+            break;
+        }
+
+        // every other slot is in use this frame or waits for its own load
+        const auto slot = reserve();
+        if (!slot)
+        {
+            break;
+        }
+
+        const PageId id = request.id;
+        _pending.push_back(PendingPage{id, *slot, std::async(std::launch::async, [this, id]() {
+            return produce(id);
+        })});
+    }
+
+    _statistics.resident_count = _cache.get_resident_count();
+    _statistics.pending_count = _pending.size();
+}
+
+std::vector<VirtualTexture::PageUpload> VirtualTexture::take_uploads()
+{
+    std::vector<PageUpload> result;
+    result.swap(_uploads);
+    return result;
+}
+
+void VirtualTexture::flush()
+{
+    apply_finished(true);
+    _statistics.resident_count = _cache.get_resident_count();
+    _statistics.pending_count = _pending.size();
+}
+
+const PageTable& VirtualTexture::get_page_table() const
+{
+    return _page_table;
+}
+
+const VirtualTexture::Statistics& VirtualTexture::get_statistics() const
+{
+    return _statistics;
+}
+
+const VirtualTexture::Settings& VirtualTexture::get_settings() const
+{
+    return _settings;
+}
+
+int VirtualTexture::get_padded_page_size() const
+{
+    return _settings.page_size + 2 * _settings.page_border;
+}
+
+std::optional<uint32_t> VirtualTexture::reserve()
+{
+    PageId evicted = invalid_page;
+    const auto slot = _cache.reserve(_frame, evicted);
+    if (evicted != invalid_page)
+    {
+        // samples fall back to a coarser page before the slot is overwritten
+        _page_table.unmap(evicted);
+        _statistics.eviction_count += 1;
+    }
+    return slot;
+}
+
+void VirtualTexture::apply(PageId id, uint32_t slot, std::vector<uint8_t> pixels, bool is_pinned)
+{
+    _cache.commit(slot, id, _frame, is_pinned);
+    _page_table.map(id, slot);
+    _statistics.load_count += 1;
+
+    _uploads.push_back(PageUpload{slot, id, std::move(pixels)});
+}
+
+void VirtualTexture::apply_finished(bool is_blocking)
+{
+    auto p = _pending.begin();
+    while (p != _pending.end())
+    {
+        if (is_blocking || p->pixels.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            apply(p->id, p->slot, p->pixels.get(), false);
+            p = _pending.erase(p);
+        }
+        else
+        {
+            ++p;
+        }
+    }
+}
+
+std::vector<uint8_t> VirtualTexture::produce(PageId id) const
+{
+    const int size = get_padded_page_size();
+    std::vector<uint8_t> result(size_t(size) * size_t(size) * 4);
+    _producer(id, size, result.data());
+    return result;
+}
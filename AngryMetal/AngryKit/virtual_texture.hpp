@@ -0,0 +1,232 @@
+//
+//  virtual_texture.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace angry
+{
+
+// Page address of a virtual texture: mip level in the top 4 bits, then page x and y.
+using PageId = uint32_t;
+
+constexpr PageId invalid_page = 0xffffffff;
+constexpr uint32_t invalid_slot = 0xffffffff;
+constexpr uint32_t max_virtual_page_count = 1 << 14;
+
+PageId make_page_id(uint32_t level, uint32_t x, uint32_t y);
+uint32_t get_page_level(PageId id);
+uint32_t get_page_x(PageId id);
+uint32_t get_page_y(PageId id);
+// page of the next coarser level covering `id`
+PageId get_parent_page(PageId id);
+
+// CPU copy of the indirection texture. Every entry points to the finest resident page
+// covering it, so a missing page is sampled from a coarser one.
+class PageTable final
+{
+public:
+    struct Entry
+    {
+        uint32_t slot = invalid_slot;
+        uint32_t level = 0;
+    };
+
+public:
+    // pages per side of the finest level, a power of two
+    explicit PageTable(uint32_t page_count);
+
+    PageTable(const PageTable&) = delete;
+    PageTable(PageTable&&) = delete;
+    PageTable& operator=(const PageTable&) = delete;
+    PageTable& operator=(PageTable&&) = delete;
+
+    uint32_t get_level_count() const;
+    uint32_t get_page_count(uint32_t level) const;
+
+    void map(PageId id, uint32_t slot);
+    // entries of the page fall back to the page its parent entry points to
+    void unmap(PageId id);
+
+    const Entry& get_entry(PageId id) const;
+    const std::vector<Entry>& get_entries(uint32_t level) const;
+
+private:
+    void assign(uint32_t level, uint32_t x, uint32_t y, uint32_t page_level, const Entry& entry, bool is_unmap);
+
+private:
+    const uint32_t _page_count;
+    std::vector<std::vector<Entry>> _levels;
+};
+
+// Least recently used order over the slots of the physical page texture.
+class PhysicalPageCache final
+{
+public:
+    explicit PhysicalPageCache(size_t slot_count);
+
+    PhysicalPageCache(const PhysicalPageCache&) = delete;
+    PhysicalPageCache(PhysicalPageCache&&) = delete;
+    PhysicalPageCache& operator=(const PhysicalPageCache&) = delete;
+    PhysicalPageCache& operator=(PhysicalPageCache&&) = delete;
+
+    std::optional<uint32_t> find(PageId id) const;
+    void touch(uint32_t slot, uint64_t frame);
+
+    // Takes the least recently used slot for a page about to load, `evicted` is the page which
+    // was there. Pinned pages and pages used during `frame` are never taken, nullopt if only
+    // those are left. The slot is out of the use order and unknown to `find` until `commit`.
+    std::optional<uint32_t> reserve(uint64_t frame, PageId& evicted);
+    void commit(uint32_t slot, PageId id, uint64_t frame, bool is_pinned);
+
+    // false while every slot is pinned or was used during `frame`
+    bool can_reserve(uint64_t frame) const;
+
+    PageId get_page(uint32_t slot) const;
+    size_t get_slot_count() const;
+    size_t get_resident_count() const;
+
+private:
+    struct Slot
+    {
+        PageId page = invalid_page;
+        uint64_t last_used_frame = 0;
+        bool is_pinned = false;
+        uint32_t previous = invalid_slot;
+        uint32_t next = invalid_slot;
+    };
+
+    void unlink(uint32_t slot);
+    void push_back(uint32_t slot);
+
+private:
+    std::vector<Slot> _slots;
+    std::unordered_map<PageId, uint32_t> _pages;
+    // least recently used first
+    uint32_t _head = invalid_slot;
+    uint32_t _tail = invalid_slot;
+};
+
+struct PageRequest
+{
+    PageId id = invalid_page;
+    // feedback samples which asked for the page or one of its descendants
+    uint32_t count = 0;
+    // false for ancestors which were only added as fallback
+    bool is_requested = false;
+};
+
+// Turns a feedback buffer, one page id per sample, into a list of unique pages sorted by id.
+// Ancestors of every requested page are added, they are the fallback while it loads.
+void analyze_feedback(const PageId* feedback, size_t count, uint32_t level_count, std::vector<PageRequest>& requests);
+
+// Fills one page with its border, `pixels` is BGRA8 of `size` by `size`. Called on worker threads.
+using PageProducer = std::function<void(PageId id, int size, uint8_t* pixels)>;
+
+// Page table, physical cache and asynchronous loads of a virtual texture. The renderer feeds
+// the sampled page ids every frame and uploads the pages returned by `take_uploads`.
+class VirtualTexture final
+{
+public:
+    struct Settings
+    {
+        // pages per side of the finest level, a power of two
+        uint32_t page_count = 512;
+        // texels of a page without its border
+        int page_size = 128;
+        // texels repeated from neighbour pages so filtering does not cross into another page
+        int page_border = 4;
+        // pages of the physical texture, the coarsest page is always one of them
+        size_t physical_page_count = 1024;
+        // pages produced on worker threads at the same time
+        size_t max_pending_count = 16;
+    };
+
+    struct Statistics
+    {
+        size_t frame_count = 0;
+        // unique pages of the feedback, ancestors not included
+        size_t requested_count = 0;
+        size_t resident_hit_count = 0;
+        size_t load_count = 0;
+        size_t eviction_count = 0;
+        size_t resident_count = 0;
+        size_t pending_count = 0;
+
+        double get_hit_rate() const;
+    };
+
+    struct PageUpload
+    {
+        uint32_t slot = invalid_slot;
+        PageId id = invalid_page;
+        std::vector<uint8_t> pixels;
+    };
+
+public:
+    // loads the coarsest page before it returns
+    VirtualTexture(const Settings& settings, PageProducer producer);
+    ~VirtualTexture();
+
+    VirtualTexture(const VirtualTexture&) = delete;
+    VirtualTexture(VirtualTexture&&) = delete;
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+    VirtualTexture& operator=(VirtualTexture&&) = delete;
+
+    // Applies finished loads, marks requested pages as used and starts loads for missing
+    // ones, coarse levels first and then pages requested by more samples.
+    void update(const PageId* feedback, size_t count);
+
+    // pages written into physical slots since the last call
+    std::vector<PageUpload> take_uploads();
+
+    // blocks until every load in flight is applied
+    void flush();
+
+    const PageTable& get_page_table() const;
+    const Statistics& get_statistics() const;
+    const Settings& get_settings() const;
+    int get_padded_page_size() const;
+
+private:
+    struct PendingPage
+    {
+        PageId id = invalid_page;
+        // reserved when the load starts, so a finished load always has a place
+        uint32_t slot = invalid_slot;
+        std::future<std::vector<uint8_t>> pixels;
+    };
+
+    std::optional<uint32_t> reserve();
+    void apply(PageId id, uint32_t slot, std::vector<uint8_t> pixels, bool is_pinned);
+    void apply_finished(bool is_blocking);
+    std::vector<uint8_t> produce(PageId id) const;
+
+private:
+    const Settings _settings;
+    const PageProducer _producer;
+    PageTable _page_table;
+    PhysicalPageCache _cache;
+
+    uint64_t _frame = 0;
+    std::vector<PageRequest> _requests;
+    std::vector<PageRequest> _missing;
+    std::vector<PageUpload> _uploads;
+    Statistics _statistics;
+
+    // last member, loads in flight finish before anything they read is destroyed
+    std::vector<PendingPage> _pending;
+};
+
+}
@@ -0,0 +1,217 @@
+//
+//  virtual_texture_benchmark.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "virtual_texture_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace angry;
+
+namespace
+{
+
+struct Camera
+{
+    float x = 0.0f;
+    float z = 0.0f;
+    float heading = 0.0f;
+};
+
+float get_lattice_value(int x, int y)
+{
+    uint32_t h = uint32_t(x) * 0x8da6b343u ^ uint32_t(y) * 0xd8163841u;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return float(h & 0xffffff) / float(0x1000000);
+}
+
+float get_value_noise(float x, float y)
+{
+    const float x0 = std::floor(x);
+    const float y0 = std::floor(y);
+    const float tx = x - x0;
+    const float ty = y - y0;
+    const float sx = tx * tx * (3.0f - 2.0f * tx);
+    const float sy = ty * ty * (3.0f - 2.0f * ty);
+
+    const int ix = int(x0);
+    const int iy = int(y0);
+    const float a = get_lattice_value(ix, iy) + (get_lattice_value(ix + 1, iy) - get_lattice_value(ix, iy)) * sx;
+    const float b = get_lattice_value(ix, iy + 1) + (get_lattice_value(ix + 1, iy + 1) - get_lattice_value(ix, iy + 1)) * sx;
+    return a + (b - a) * sy;
+}
+
+float get_terrain_value(float x, float y)
+{
+    float result = 0.0f;
+    float amplitude = 0.5f;
+    for (int i = 0; i < 4; i++)
+    {
+        result += amplitude * get_value_noise(x, y);
+        x *= 2.0f;
+        y *= 2.0f;
+        amplitude *= 0.5f;
+    }
+    return result;
+}
+
+// grass and dirt, detailed enough that every texel of the finest level costs something
+void produce_terrain_page(const VirtualTextureBenchmarkSettings& settings, PageId id, int size, uint8_t* pixels)
+{
+    const auto& texture = settings.texture;
+    const float scale = float(1u << get_page_level(id));
+    const float meters_per_texel = settings.world_size / float(texture.page_count * uint32_t(texture.page_size));
+    const float x0 = float(get_page_x(id) * uint32_t(texture.page_size)) - float(texture.page_border);
+    const float y0 = float(get_page_y(id) * uint32_t(texture.page_size)) - float(texture.page_border);
+
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            const float world_x = (x0 + float(x) + 0.5f) * scale * meters_per_texel;
+            const float world_y = (y0 + float(y) + 0.5f) * scale * meters_per_texel;
+            const float t = std::clamp(get_terrain_value(world_x * 0.2f, world_y * 0.2f) * 1.5f - 0.25f, 0.0f, 1.0f);
+
+            uint8_t* pixel = pixels + (size_t(y) * size_t(size) + size_t(x)) * 4;
+            pixel[0] = uint8_t(40.0f + t * 30.0f);
+            pixel[1] = uint8_t(110.0f - t * 30.0f);
+            pixel[2] = uint8_t(50.0f + t * 80.0f);
+            pixel[3] = 255;
+        }
+    }
+}
+
+// Ray casts every feedback sample against the floor plane, the mip level follows the
+// footprint of one screen pixel like the sampler would pick it.
+void render_feedback(const VirtualTextureBenchmarkSettings& settings,
+                     const Camera& camera,
+                     uint32_t level_count,
+                     std::vector<PageId>& feedback)
+{
+    const float pitch = 0.45f;
+    const float vertical_fov = 1.0f;
+    const float aspect = float(settings.feedback_width) / float(settings.feedback_height);
+    const float horizontal_tan = std::tan(vertical_fov * 0.5f) * aspect;
+    const float texels_per_meter = float(settings.texture.page_count * uint32_t(settings.texture.page_size)) / settings.world_size;
+
+    const float forward_x = std::sin(camera.heading);
+    const float forward_z = std::cos(camera.heading);
+
+    feedback.assign(size_t(settings.feedback_width) * size_t(settings.feedback_height), invalid_page);
+    for (int row = 0; row < settings.feedback_height; row++)
+    {
+        // angle below the horizon, rows above it see no floor
+        const float angle = pitch + ((float(row) + 0.5f) / float(settings.feedback_height) - 0.5f) * vertical_fov;
+        if (angle < 0.02f)
+        {
+            continue;
+        }
+
+        const float range = settings.camera_height / std::sin(angle);
+        const float distance = settings.camera_height / std::tan(angle);
+        const float footprint = range * (vertical_fov / float(settings.screen_height)) / std::sin(angle);
+        const float level = std::floor(std::log2(std::max(footprint * texels_per_meter, 1.0f)));
+        const uint32_t page_level = std::min(uint32_t(level), level_count - 1);
+        const uint32_t page_count = settings.texture.page_count >> page_level;
+
+        for (int column = 0; column < settings.feedback_width; column++)
+        {
+            const float lateral = ((float(column) + 0.5f) / float(settings.feedback_width) * 2.0f - 1.0f) * horizontal_tan * range;
+            const float x = camera.x + forward_x * distance + forward_z * lateral;
+            const float z = camera.z + forward_z * distance - forward_x * lateral;
+
+            // the floor repeats past the area of the texture
+            const float u = x / settings.world_size - std::floor(x / settings.world_size);
+            const float v = z / settings.world_size - std::floor(z / settings.world_size);
+            const uint32_t page_x = std::min(uint32_t(u * float(page_count)), page_count - 1);
+            const uint32_t page_y = std::min(uint32_t(v * float(page_count)), page_count - 1);
+            feedback[size_t(row) * size_t(settings.feedback_width) + size_t(column)] = make_page_id(page_level, page_x, page_y);
+        }
+    }
+}
+
+}
+
+void angry::run_virtual_texture_benchmark(const VirtualTextureBenchmarkSettings& settings, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    output << "{\"page_count\": " << settings.texture.page_count
+        << ", \"page_size\": " << settings.texture.page_size
+        << ", \"frame_count\": " << settings.frame_count
+        << ", \"feedback_width\": " << settings.feedback_width
+        << ", \"feedback_height\": " << settings.feedback_height
+        << ", \"runs\": [";
+
+    for (size_t run = 0; run < settings.physical_page_counts.size(); run++)
+    {
+        auto texture_settings = settings.texture;
+        texture_settings.physical_page_count = settings.physical_page_counts[run];
+        VirtualTexture texture(texture_settings, [&settings](PageId id, int size, uint8_t* pixels) {
+            produce_terrain_page(settings, id, size, pixels);
+        });
+        texture.take_uploads();
+
+        const uint32_t level_count = texture.get_page_table().get_level_count();
+        const float radius = settings.world_size * 0.3f;
+        const float angular_speed = settings.camera_speed / radius;
+        const double frame_seconds = settings.frame_seconds > 0.0 ? settings.frame_seconds : 1.0 / 60.0;
+
+        std::vector<PageId> feedback;
+        double update_seconds = 0.0;
+        double max_update_seconds = 0.0;
+        size_t upload_bytes = 0;
+        for (size_t frame = 0; frame < settings.frame_count; frame++)
+        {
+            const auto frame_start = Clock::now();
+
+            // a circle around the middle of the floor, looking along the path
+            const float angle = angular_speed * float(double(frame) * frame_seconds);
+            Camera camera;
+            camera.x = settings.world_size * 0.5f + radius * std::cos(angle);
+            camera.z = settings.world_size * 0.5f + radius * std::sin(angle);
+            camera.heading = -angle;
+            render_feedback(settings, camera, level_count, feedback);
+
+            const auto update_start = Clock::now();
+            texture.update(feedback.data(), feedback.size());
+            for (const auto& upload : texture.take_uploads())
+            {
+                upload_bytes += upload.pixels.size();
+            }
+            const double seconds = std::chrono::duration<double>(Clock::now() - update_start).count();
+            update_seconds += seconds;
+            max_update_seconds = std::max(max_update_seconds, seconds);
+
+            if (settings.frame_seconds > 0.0)
+            {
+                std::this_thread::sleep_until(frame_start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(settings.frame_seconds)));
+            }
+        }
+
+        const auto& statistics = texture.get_statistics();
+        output << (run == 0 ? "" : ", ")
+            << "{\"physical_page_count\": " << texture_settings.physical_page_count
+            << ", \"update_ms_mean\": " << update_seconds * 1000.0 / double(std::max(settings.frame_count, size_t(1)))
+            << ", \"update_ms_max\": " << max_update_seconds * 1000.0
+            << ", \"requested_pages\": " << statistics.requested_count
+            << ", \"hit_rate\": " << statistics.get_hit_rate()
+            << ", \"loads\": " << statistics.load_count
+            << ", \"evictions\": " << statistics.eviction_count
+            << ", \"resident_pages\": " << statistics.resident_count
+            << ", \"pending_pages\": " << statistics.pending_count
+            << ", \"upload_bytes\": " << upload_bytes
+            << "}";
+    }
+
+    output << "]}\n";
+}
@@ -0,0 +1,43 @@
+//
+//  virtual_texture_benchmark.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "virtual_texture.hpp"
+
+namespace angry
+{
+
+struct VirtualTextureBenchmarkSettings
+{
+    VirtualTexture::Settings texture;
+    // every run uses its own physical page count, the rest of the settings is shared
+    std::vector<size_t> physical_page_counts = {256, 1024};
+
+    size_t frame_count = 600;
+    // the feedback pass renders at a fraction of the screen resolution
+    int feedback_width = 160;
+    int feedback_height = 90;
+    int screen_height = 1080;
+    // 0 runs frames back to back, loads then lag behind by more frames than in the game
+    double frame_seconds = 1.0 / 60.0;
+
+    // side of the floor area covered by the virtual texture, in meters
+    float world_size = 100.0f;
+    float camera_height = 12.0f;
+    float camera_speed = 5.0f;
+};
+
+// Flies a camera over the floor, turns its view into feedback buffers and drives a virtual
+// texture of procedural terrain with them. Writes update time and residency as JSON.
+void run_virtual_texture_benchmark(const VirtualTextureBenchmarkSettings& settings, std::ostream& output);
+
+}
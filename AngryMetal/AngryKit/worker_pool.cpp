@@ -0,0 +1,73 @@
+//
+//  worker_pool.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+using namespace angry;
+
+WorkerPool::WorkerPool(size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    _threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        _threads.emplace_back([this]() { run_worker(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _is_stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+size_t WorkerPool::get_thread_count() const
+{
+    return _threads.size();
+}
+
+void WorkerPool::run_worker()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return _is_stopping || !_tasks.empty(); });
+            // queued tasks still run when stopping, their owners wait for them
+            if (_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,52 @@
+//
+//  worker_pool.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace angry
+{
+
+// Fixed set of threads which run posted tasks in the order they came.
+class WorkerPool final
+{
+public:
+    // zero takes one thread per core
+    explicit WorkerPool(size_t thread_count = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    // `task` must not throw, nobody is there to get the exception
+    void post(std::function<void()> task);
+
+    size_t get_thread_count() const;
+
+private:
+    void run_worker();
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _is_stopping = false;
+
+    // last member, threads start after everything they read
+    std::vector<std::thread> _threads;
+};
+
+}
@@ -0,0 +1,381 @@
+//
+//  world_streaming_system.cpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include "world_streaming_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+#include "chunk_component.hpp"
+#include "matrix.hpp"
+#include "mesh_component.hpp"
+#include "scene.hpp"
+#include "transform_component.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+// chunk coordinates are in floor space, turned by ChunkComponent::rotation around the origin
+simd_float3 rotate(simd_float3 value, float angle)
+{
+    const auto result = simd_mul(matrix::make_rotation({0.0f, 1.0f, 0.0f}, angle), simd_make_float4(value, 0.0f));
+    return result.xyz;
+}
+
+}
+
+WorldStreamingSystem::WorldStreamingSystem(BufferManagerInterface& buffer_manager, const Settings& settings)
+    : _buffer_manager(buffer_manager),
+    _settings(settings),
+    _max_resident_count(get_max_chunk_count(settings))
+{
+    const auto side = 2 * _settings.load_radius + 1;
+    _missing.reserve(side * side);
+
+    _jobs.resize(side * side);
+    for (auto& job : _jobs)
+    {
+        job.data.positions.resize(ChunkComponent::vertex_count * 3);
+        job.data.uvs.resize(ChunkComponent::vertex_count * 2);
+        job.data.spawn_points.resize(_settings.spawns_per_chunk);
+    }
+    _finished.reserve(_jobs.size());
+    _queue.resize(_jobs.size());
+
+    _worker = std::thread([this]() { run_worker(); });
+}
+
+WorldStreamingSystem::~WorldStreamingSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _is_stopping = true;
+    }
+    _worker_condition.notify_one();
+    _worker.join();
+}
+
+void WorldStreamingSystem::load(Scene& scene)
+{
+    // chunk slots keep their spawn points, later chunks fit without allocating
+    auto& registry = scene.get_registry();
+    for (auto entity : registry.view<ChunkComponent>())
+    {
+        registry.get<ChunkComponent>(entity).spawn_points.reserve(_settings.spawns_per_chunk);
+    }
+
+    update(scene);
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done_condition.wait(lock, [this]() {
+            return std::all_of(_jobs.cbegin(), _jobs.cend(), [](const auto& job) {
+                return !job.is_used || job.is_done;
+            });
+        });
+    }
+    update(scene);
+}
+
+void WorldStreamingSystem::update(Scene& scene)
+{
+    const auto& player_transform_component = scene.get_registry().get<TransformComponent>(scene.get_player());
+    const auto center = get_chunk_coordinates(player_transform_component.position);
+
+    evict(scene, center);
+
+    _finished.clear();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < _jobs.size(); i++)
+        {
+            if (_jobs[i].is_done)
+            {
+                _jobs[i].is_done = false;
+                _finished.push_back(i);
+            }
+        }
+    }
+
+    for (size_t i : _finished)
+    {
+        auto& job = _jobs[i];
+        if (is_near(job.data.coordinates, center, _settings.unload_radius))
+        {
+            apply(scene, job.data);
+        }
+        job.is_used = false;
+    }
+
+    request(scene, center);
+}
+
+size_t WorldStreamingSystem::get_resident_bytes() const
+{
+    return _resident_count * get_chunk_bytes(_settings);
+}
+
+void WorldStreamingSystem::load_chunk(ChunkData& data, const Settings& settings)
+{
+    const auto coordinates = data.coordinates;
+    const float s = settings.chunk_size;
+    const float positions[] = {
+        0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, s,
+        s,    0.0f, s,
+        0.0f, 0.0f, 0.0f,
+        s,    0.0f, s,
+        s,    0.0f, 0.0f
+    };
+    std::copy(std::begin(positions), std::end(positions), data.positions.begin());
+
+    const float t = s / settings.tile_size;
+    const float uvs[] = {
+        0.0f, 0.0f,
+        t,    0.0f,
+        t,    t,
+        0.0f, 0.0f,
+        t,    t,
+        0.0f, t
+    };
+    std::copy(std::begin(uvs), std::end(uvs), data.uvs.begin());
+
+    // spawn data is stable for every chunk
+    const auto seed = static_cast<uint32_t>(coordinates.x) * 73856093u ^ static_cast<uint32_t>(coordinates.y) * 19349663u;
+    std::minstd_rand random(seed);
+    std::uniform_real_distribution<float> distribution(0.0f, s);
+    for (auto& spawn_point : data.spawn_points)
+    {
+        const float x = coordinates.x * s + distribution(random);
+        const float z = coordinates.y * s + distribution(random);
+        spawn_point = rotate(simd_float3{x, 0.0f, z}, ChunkComponent::rotation);
+    }
+}
+
+size_t WorldStreamingSystem::get_chunk_bytes(const Settings& settings)
+{
+    const size_t geometry = ChunkComponent::vertex_count * (3 + 2) * sizeof(float);
+    return geometry + settings.spawns_per_chunk * sizeof(simd_float3);
+}
+
+size_t WorldStreamingSystem::get_max_chunk_count(const Settings& settings)
+{
+    const auto load_side = size_t(2 * settings.load_radius + 1);
+    const auto unload_side = size_t(2 * settings.unload_radius + 1);
+    const auto count = std::min(settings.memory_budget / get_chunk_bytes(settings), unload_side * unload_side);
+    if (count < load_side * load_side)
+    {
+        throw std::runtime_error("WorldStreamingSystem::get_max_chunk_count() memory budget does not cover the load area");
+    }
+    return count;
+}
+
+simd_int2 WorldStreamingSystem::get_chunk_coordinates(simd_float3 position) const
+{
+    position = rotate(position, -ChunkComponent::rotation);
+    return simd_int2{
+        static_cast<int>(std::floor(position.x / _settings.chunk_size)),
+        static_cast<int>(std::floor(position.z / _settings.chunk_size))
+    };
+}
+
+bool WorldStreamingSystem::is_known(Scene& scene, simd_int2 coordinates) const
+{
+    const auto p = std::find_if(_jobs.cbegin(), _jobs.cend(), [&](const auto& job) {
+        return job.is_used && simd_all(job.data.coordinates == coordinates);
+    });
+    if (p != _jobs.cend())
+    {
+        return true;
+    }
+
+    auto& registry = scene.get_registry();
+    const auto entity = scene.get_chunk_pool().find_first_if([&](auto entity) {
+        return simd_all(registry.get<ChunkComponent>(entity).coordinates == coordinates);
+    });
+    return entity.has_value();
+}
+
+bool WorldStreamingSystem::is_near(simd_int2 coordinates, simd_int2 center, int radius) const
+{
+    return simd_reduce_max(simd_abs(coordinates - center)) <= radius;
+}
+
+void WorldStreamingSystem::evict(Scene& scene, simd_int2 center)
+{
+    auto& registry = scene.get_registry();
+    scene.get_chunk_pool().release_if([&](auto entity) {
+        if (is_near(registry.get<ChunkComponent>(entity).coordinates, center, _settings.unload_radius))
+        {
+            return false;
+        }
+
+        unload(scene, entity);
+        return true;
+    });
+}
+
+bool WorldStreamingSystem::evict_farthest(Scene& scene, simd_int2 center)
+{
+    auto& registry = scene.get_registry();
+    std::optional<entt::entity> farthest;
+    int farthest_distance = _settings.load_radius;
+    for (auto entity : scene.get_chunk_pool().get_active())
+    {
+        const auto distance = simd_reduce_max(simd_abs(registry.get<ChunkComponent>(entity).coordinates - center));
+        if (distance > farthest_distance)
+        {
+            farthest = entity;
+            farthest_distance = distance;
+        }
+    }
+
+    if (!farthest)
+    {
+        return false;
+    }
+
+    scene.get_chunk_pool().release_first_if([&](auto entity) { return entity == *farthest; });
+    unload(scene, *farthest);
+    return true;
+}
+
+void WorldStreamingSystem::unload(Scene& scene, entt::entity entity)
+{
+    auto& registry = scene.get_registry();
+    auto& chunk_component = registry.get<ChunkComponent>(entity);
+    chunk_component.is_resident = false;
+    chunk_component.spawn_points.clear();
+    registry.get<MeshComponent>(entity).is_visible = false;
+    _resident_count -= 1;
+}
+
+void WorldStreamingSystem::request(Scene& scene, simd_int2 center)
+{
+    const auto r = _settings.load_radius;
+    _missing.clear();
+    for (int z = -r; z <= r; z++)
+    {
+        for (int x = -r; x <= r; x++)
+        {
+            const auto coordinates = center + simd_int2{x, z};
+            if (!is_known(scene, coordinates))
+            {
+                _missing.push_back(coordinates);
+            }
+        }
+    }
+
+    std::sort(_missing.begin(), _missing.end(), [center](auto a, auto b) {
+        const auto da = a - center;
+        const auto db = b - center;
+        return simd_reduce_add(da * da) < simd_reduce_add(db * db);
+    });
+
+    size_t pending_count = std::count_if(_jobs.cbegin(), _jobs.cend(), [](const auto& job) {
+        return job.is_used;
+    });
+    for (auto coordinates : _missing)
+    {
+        // the budget is spent, a chunk of the load area takes the slot of a far one
+        const auto slot_count = std::min(_max_resident_count, _resident_count + scene.get_chunk_pool().get_idle().size());
+        if (_resident_count + pending_count >= slot_count && !evict_farthest(scene, center))
+        {
+            break;
+        }
+        if (!enqueue(coordinates))
+        {
+            break;
+        }
+        pending_count += 1;
+    }
+}
+
+void WorldStreamingSystem::run_worker()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _worker_condition.wait(lock, [this]() { return _is_stopping || _queue_size > 0; });
+        if (_is_stopping)
+        {
+            return;
+        }
+
+        const size_t index = _queue[_queue_head];
+        _queue_head = (_queue_head + 1) % _queue.size();
+        _queue_size -= 1;
+
+        lock.unlock();
+        load_chunk(_jobs[index].data, _settings);
+        lock.lock();
+
+        _jobs[index].is_done = true;
+        _done_condition.notify_all();
+    }
+}
+
+bool WorldStreamingSystem::enqueue(simd_int2 coordinates)
+{
+    const auto job = std::find_if(_jobs.begin(), _jobs.end(), [](const auto& job) {
+        return !job.is_used;
+    });
+    if (job == _jobs.end())
+    {
+        return false;
+    }
+
+    job->is_used = true;
+    job->data.coordinates = coordinates;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue[(_queue_head + _queue_size) % _queue.size()] = size_t(job - _jobs.begin());
+        _queue_size += 1;
+    }
+    _worker_condition.notify_one();
+    return true;
+}
+
+void WorldStreamingSystem::apply(Scene& scene, ChunkData& data)
+{
+    auto entity = scene.get_chunk_pool().get_entity();
+    if (!entity)
+    {
+        return;
+    }
+
+    auto& registry = scene.get_registry();
+    auto& mesh_component = registry.get<MeshComponent>(*entity);
+    auto& mesh = mesh_component.mesh;
+
+    auto position = _buffer_manager.get_buffer_view<float>(mesh.vertex_buffer[VertexAttribute::position]);
+    std::copy(data.positions.cbegin(), data.positions.cend(), position.data);
+
+    auto uv = _buffer_manager.get_buffer_view<float>(mesh.vertex_buffer[VertexAttribute::uv]);
+    std::copy(data.uvs.cbegin(), data.uvs.cend(), uv.data);
+    mesh_component.is_visible = true;
+
+    auto& transform_component = registry.get<TransformComponent>(*entity);
+    const auto origin = simd_float3{
+        data.coordinates.x * _settings.chunk_size,
+        0.0f,
+        data.coordinates.y * _settings.chunk_size
+    };
+    transform_component.position = rotate(origin, ChunkComponent::rotation);
+
+    auto& chunk_component = registry.get<ChunkComponent>(*entity);
+    chunk_component.coordinates = data.coordinates;
+    chunk_component.is_resident = true;
+    chunk_component.spawn_points.assign(data.spawn_points.cbegin(), data.spawn_points.cend());
+
+    _resident_count += 1;
+}
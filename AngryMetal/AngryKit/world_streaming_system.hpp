@@ -0,0 +1,122 @@
+//
+//  world_streaming_system.hpp
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+#include <simd/simd.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "buffer_manager_interface.hpp"
+
+namespace angry
+{
+
+class Scene;
+
+// Keeps floor chunks around the player resident. Chunk content is prepared on
+// a worker thread and copied into one of the preallocated chunk slots of the scene,
+// so memory does not depend on the size of the playable area. Jobs and their chunk
+// data are allocated once, requesting and applying chunks does not allocate.
+class WorldStreamingSystem final
+{
+public:
+    struct Settings
+    {
+        float chunk_size = 10.0f;
+        float tile_size = 1.0f;
+        int load_radius = 2;   // in chunks
+        int unload_radius = 3; // in chunks, bigger than load radius to avoid thrashing
+        size_t memory_budget = 8 * 1024; // bytes, sizes the chunk pool of the scene
+        int spawns_per_chunk = 4;
+    };
+
+public:
+    WorldStreamingSystem(BufferManagerInterface& buffer_manager, const Settings& settings);
+    ~WorldStreamingSystem();
+
+    WorldStreamingSystem(const WorldStreamingSystem&) = delete;
+    WorldStreamingSystem(WorldStreamingSystem&&) = delete;
+    WorldStreamingSystem& operator=(const WorldStreamingSystem&) = delete;
+    WorldStreamingSystem& operator=(WorldStreamingSystem&&) = delete;
+
+    // blocks until chunks around the player are resident
+    void load(Scene& scene);
+    void update(Scene& scene);
+
+    size_t get_resident_bytes() const;
+
+    // chunks that fit into the memory budget, never more than the unload area holds;
+    // throws when the budget does not cover the load area
+    static size_t get_max_chunk_count(const Settings& settings);
+
+private:
+    struct ChunkData
+    {
+        simd_int2 coordinates;
+        std::vector<float> positions;
+        std::vector<float> uvs;
+        std::vector<simd_float3> spawn_points;
+    };
+
+    struct ChunkJob
+    {
+        // game thread only, from `enqueue` until the chunk is applied
+        bool is_used = false;
+        // guarded by the mutex, the worker owns `data` while the job is queued and not done
+        bool is_done = false;
+        ChunkData data;
+    };
+
+    // fills preallocated `data` for `data.coordinates`
+    static void load_chunk(ChunkData& data, const Settings& settings);
+    static size_t get_chunk_bytes(const Settings& settings);
+
+    void run_worker();
+    // false when every job is in use
+    bool enqueue(simd_int2 coordinates);
+
+    simd_int2 get_chunk_coordinates(simd_float3 position) const;
+    bool is_known(Scene& scene, simd_int2 coordinates) const;
+    bool is_near(simd_int2 coordinates, simd_int2 center, int radius) const;
+    void evict(Scene& scene, simd_int2 center);
+    // frees the slot of the farthest resident chunk outside the load area, false when there is none
+    bool evict_farthest(Scene& scene, simd_int2 center);
+    void unload(Scene& scene, entt::entity entity);
+    void request(Scene& scene, simd_int2 center);
+    void apply(Scene& scene, ChunkData& data);
+
+private:
+    BufferManagerInterface& _buffer_manager;
+    const Settings _settings;
+    const size_t _max_resident_count;
+
+    std::vector<simd_int2> _missing;
+    size_t _resident_count = 0;
+
+    // one per chunk of the load area
+    std::vector<ChunkJob> _jobs;
+    std::vector<size_t> _finished;
+    // ring of queued job indices as big as `_jobs`, guarded by the mutex
+    std::vector<size_t> _queue;
+    size_t _queue_head = 0;
+    size_t _queue_size = 0;
+    bool _is_stopping = false;
+    std::mutex _mutex;
+    std::condition_variable _worker_condition;
+    std::condition_variable _done_condition;
+
+    // last member, it starts after everything it reads
+    std::thread _worker;
+};
+
+}
@@ -0,0 +1,165 @@
+//
+//  FrameRingTests.mm
+//  AngryKitTests
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "cpu_buffer_manager.hpp"
+#include "frame_ring.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+FrameRing::Settings make_settings(size_t frame_count, size_t frame_capacity)
+{
+    FrameRing::Settings settings;
+    settings.frame_count = frame_count;
+    settings.frame_capacity = frame_capacity;
+    return settings;
+}
+
+}
+
+@interface FrameRingTests : XCTestCase
+
+@end
+
+@implementation FrameRingTests
+
+- (void)testEveryFrameStartsAtItsRegion {
+    FrameRing ring(make_settings(3, 1024));
+    XCTAssertEqual(ring.get_size(), 3 * 1024);
+
+    ring.begin_frame();
+    const size_t region = ring.get_frame_offset();
+    XCTAssertEqual(*ring.allocate(100), region);
+    // offsets are aligned for Metal
+    XCTAssertEqual(*ring.allocate(1), region + 256);
+    XCTAssertEqual(ring.get_frame_used(), 512);
+
+    ring.begin_frame();
+    XCTAssertNotEqual(ring.get_frame_offset(), region);
+    XCTAssertEqual(ring.get_frame_used(), 0);
+    ring.begin_frame();
+
+    // the region is used again from the start
+    ring.begin_frame();
+    XCTAssertEqual(ring.get_frame_offset(), region);
+    XCTAssertEqual(*ring.allocate(100), region);
+    XCTAssertEqual(ring.get_statistics().frame_count, 4);
+    XCTAssertEqual(ring.get_statistics().max_frame_used, 512);
+}
+
+- (void)testFullRegionGrows {
+    FrameRing ring(make_settings(2, 512));
+    ring.begin_frame();
+
+    XCTAssertTrue(ring.allocate(256).has_value());
+    XCTAssertTrue(ring.allocate(256).has_value());
+    XCTAssertFalse(ring.allocate(1).has_value());
+
+    ring.grow(1);
+    XCTAssertEqual(ring.get_size(), 2 * 1024);
+    XCTAssertEqual(ring.get_frame_offset(), ring.get_frame_index() * 1024);
+    XCTAssertEqual(ring.get_statistics().grow_count, 1);
+    XCTAssertTrue(ring.allocate(1).has_value());
+}
+
+- (void)testEmptyRingThrows {
+    XCTAssertThrows(FrameRing{make_settings(0, 1024)});
+    XCTAssertThrows(FrameRing{make_settings(3, 0)});
+}
+
+- (void)testDynamicBufferMovesWithFrame {
+    CpuBufferManager manager(SlabAllocator::Settings(), make_settings(2, 1024));
+    const size_t buffer = manager.create_dynamic_buffer(64, BufferUsage::instance);
+
+    manager.begin_frame();
+    const size_t first = manager.get_buffer_offset(buffer);
+    manager.end_frame();
+
+    manager.begin_frame();
+    const size_t second = manager.get_buffer_offset(buffer);
+    XCTAssertNotEqual(first, second);
+    manager.end_frame();
+    manager.complete_frame();
+
+    manager.begin_frame();
+    XCTAssertEqual(manager.get_buffer_offset(buffer), first);
+    manager.end_frame();
+    manager.complete_frame();
+    manager.complete_frame();
+}
+
+- (void)testRingGrowsAndKeepsFrameData {
+    CpuBufferManager manager(SlabAllocator::Settings(), make_settings(3, 512));
+    manager.begin_frame();
+
+    const size_t a = manager.create_dynamic_buffer(256, BufferUsage::instance);
+    std::memset(manager.get_buffer_view<uint8_t>(a).data, 7, 256);
+
+    // does not fit in the rest of the region
+    const size_t b = manager.create_dynamic_buffer(1024, BufferUsage::instance);
+    const auto& frame_ring = manager.get_frame_ring();
+    XCTAssertEqual(frame_ring.get_statistics().grow_count, 1);
+    XCTAssertGreaterThanOrEqual(frame_ring.get_size(), 3 * (256 + 1024));
+
+    const auto view = manager.get_buffer_view<uint8_t>(a);
+    XCTAssertEqual(view.size, 256);
+    XCTAssertEqual(view.data[0], 7);
+    XCTAssertEqual(view.data[255], 7);
+    XCTAssertEqual(manager.get_buffer_offset(b), manager.get_buffer_offset(a) + 256);
+    manager.end_frame();
+    manager.complete_frame();
+
+    // later frames fit without growing
+    manager.begin_frame();
+    XCTAssertEqual(frame_ring.get_statistics().grow_count, 1);
+    manager.end_frame();
+    manager.complete_frame();
+}
+
+- (void)testBeginFrameWaitsForCompletedFrame {
+    CpuBufferManager manager(SlabAllocator::Settings(), make_settings(2, 1024));
+    for (int i = 0; i < 2; i++)
+    {
+        manager.begin_frame();
+        manager.end_frame();
+    }
+
+    std::atomic<bool> is_started(false);
+    std::thread thread([&]() {
+        manager.begin_frame();
+        is_started = true;
+    });
+
+    // both frames are still in flight
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    XCTAssertFalse(is_started);
+
+    manager.complete_frame();
+    thread.join();
+    XCTAssertTrue(is_started);
+    XCTAssertEqual(manager.get_frame_ring().get_statistics().frame_count, 3);
+
+    manager.end_frame();
+    manager.complete_frame();
+    manager.complete_frame();
+}
+
+- (void)testCompletingWithoutFrameThrows {
+    CpuBufferManager manager;
+    XCTAssertThrows(manager.complete_frame());
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  SimulationBenchmarkTests.mm
+//  AngryKitTests
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "allocation_counter.hpp"
+#include "simulation_benchmark.hpp"
+
+using namespace angry;
+
+@interface SimulationBenchmarkTests : XCTestCase
+
+@end
+
+@implementation SimulationBenchmarkTests
+
+- (void)testSteadyStateDoesNotAllocate {
+    XCTSkipUnless(is_allocation_counting_enabled(), @"allocations are counted in Debug builds only");
+
+    // the test host is the app, its bundle has the assets
+    NSURL *assetsURL = [NSBundle.mainBundle.bundleURL URLByAppendingPathComponent:@"Assets"];
+
+    SimulationBenchmarkSettings settings;
+    settings.assets_path = assetsURL.path.UTF8String;
+    // long enough for restarts and chunks streamed in and out after warmup
+    settings.frame_count = 1800;
+    settings.require_zero_allocations = true;
+
+    std::stringstream output;
+    std::string error;
+    try
+    {
+        run_simulation_benchmark(settings, output);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+
+    XCTAssertTrue(error.empty(), @"%s", error.c_str());
+    const std::string report = output.str();
+    XCTAssertNotEqual(report.find("\"steady_state\": {\"frames\": 1680, \"allocating_frames\": 0, \"allocations\": 0"),
+                      std::string::npos, @"%s", report.c_str());
+}
+
+@end
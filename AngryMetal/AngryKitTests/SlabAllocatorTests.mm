@@ -0,0 +1,180 @@
+//
+//  SlabAllocatorTests.mm
+//  AngryKitTests
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "cpu_buffer_manager.hpp"
+#include "slab_allocator.hpp"
+
+using namespace angry;
+
+namespace
+{
+
+SlabAllocator::Settings make_settings()
+{
+    SlabAllocator::Settings settings;
+    settings.slab_size = 16 * 1024;
+    settings.min_class_size = 256;
+    settings.max_class_size = 4 * 1024;
+    return settings;
+}
+
+}
+
+@interface SlabAllocatorTests : XCTestCase
+
+@end
+
+@implementation SlabAllocatorTests
+
+- (void)testSizesRoundUpToClass {
+    SlabAllocator allocator(make_settings());
+    bool is_new_slab = false;
+
+    const auto a = allocator.allocate(1, is_new_slab);
+    XCTAssertTrue(is_new_slab);
+    XCTAssertEqual(a.capacity, 256);
+
+    const auto b = allocator.allocate(257, is_new_slab);
+    XCTAssertTrue(is_new_slab);
+    XCTAssertEqual(b.capacity, 512);
+    XCTAssertNotEqual(a.slab, b.slab);
+
+    // same class shares the slab, offsets follow each other
+    const auto c = allocator.allocate(512, is_new_slab);
+    XCTAssertFalse(is_new_slab);
+    XCTAssertEqual(c.slab, b.slab);
+    XCTAssertEqual(c.offset, b.offset + 512);
+
+    const auto d = allocator.allocate(4 * 1024, is_new_slab);
+    XCTAssertEqual(d.capacity, 4 * 1024);
+    XCTAssertEqual(d.offset % 256, 0);
+
+    const auto& statistics = allocator.get_statistics();
+    XCTAssertEqual(statistics.allocation_count, 4);
+    XCTAssertEqual(statistics.allocated_bytes, 256 + 512 + 512 + 4 * 1024);
+    XCTAssertEqual(statistics.slab_count, 3);
+    XCTAssertEqual(statistics.slab_bytes, 3 * 16 * 1024);
+}
+
+- (void)testFullClassSlabTakesAnotherOne {
+    SlabAllocator allocator(make_settings());
+    bool is_new_slab = false;
+
+    const auto first = allocator.allocate(4 * 1024, is_new_slab);
+    for (int i = 1; i < 4; i++)
+    {
+        allocator.allocate(4 * 1024, is_new_slab);
+        XCTAssertFalse(is_new_slab);
+    }
+
+    const auto fifth = allocator.allocate(4 * 1024, is_new_slab);
+    XCTAssertTrue(is_new_slab);
+    XCTAssertNotEqual(fifth.slab, first.slab);
+    XCTAssertEqual(fifth.offset, 0);
+}
+
+- (void)testReleasedBlockIsReused {
+    SlabAllocator allocator(make_settings());
+    bool is_new_slab = false;
+
+    const auto a = allocator.allocate(300, is_new_slab);
+    const auto b = allocator.allocate(300, is_new_slab);
+    XCTAssertFalse(allocator.release(a));
+    XCTAssertEqual(allocator.get_statistics().allocated_bytes, 512);
+
+    // the class slab is kept and the block comes back before untouched space
+    const auto c = allocator.allocate(400, is_new_slab);
+    XCTAssertFalse(is_new_slab);
+    XCTAssertEqual(c.slab, a.slab);
+    XCTAssertEqual(c.offset, a.offset);
+
+    const auto d = allocator.allocate(400, is_new_slab);
+    XCTAssertEqual(d.offset, b.offset + 512);
+    XCTAssertEqual(allocator.get_statistics().slab_count, 1);
+}
+
+- (void)testDedicatedSlabIsReleased {
+    SlabAllocator allocator(make_settings());
+    bool is_new_slab = false;
+
+    const auto a = allocator.allocate(5000, is_new_slab);
+    XCTAssertTrue(is_new_slab);
+    XCTAssertEqual(a.offset, 0);
+    XCTAssertEqual(a.capacity, 5120);
+    XCTAssertEqual(allocator.get_slab_size(a.slab), 5120);
+    XCTAssertEqual(allocator.get_statistics().slab_bytes, 5120);
+    XCTAssertEqual(allocator.get_statistics().dedicated_slab_count, 1);
+    XCTAssertEqual(allocator.get_statistics().dedicated_bytes, 5120);
+
+    XCTAssertTrue(allocator.release(a));
+    XCTAssertEqual(allocator.get_statistics().slab_count, 0);
+    XCTAssertEqual(allocator.get_statistics().slab_bytes, 0);
+    XCTAssertEqual(allocator.get_statistics().allocated_bytes, 0);
+    XCTAssertEqual(allocator.get_statistics().dedicated_slab_count, 0);
+    XCTAssertEqual(allocator.get_statistics().dedicated_bytes, 0);
+
+    // the slab index is taken again with the new size
+    const auto b = allocator.allocate(64 * 1024, is_new_slab);
+    XCTAssertTrue(is_new_slab);
+    XCTAssertEqual(b.slab, a.slab);
+    XCTAssertEqual(allocator.get_slab_size(b.slab), 64 * 1024);
+}
+
+- (void)testBadClassSizesThrow {
+    auto settings = make_settings();
+    settings.min_class_size = 300;
+    XCTAssertThrows(SlabAllocator{settings});
+
+    settings = make_settings();
+    settings.max_class_size = 32 * 1024;
+    XCTAssertThrows(SlabAllocator{settings});
+}
+
+- (void)testReleasedBufferWaitsForFramesInFlight {
+    FrameRing::Settings frame_settings;
+    frame_settings.frame_count = 2;
+    CpuBufferManager manager(make_settings(), frame_settings);
+
+    manager.begin_frame();
+    const size_t a = manager.create_buffer(300, BufferUsage::vertex);
+    const size_t a_offset = manager.get_buffer_offset(a);
+    manager.release_buffer(a);
+
+    // the frame being recorded may still draw from the block
+    const size_t b = manager.create_buffer(300, BufferUsage::vertex);
+    XCTAssertNotEqual(manager.get_buffer_offset(b), a_offset);
+    manager.end_frame();
+
+    manager.complete_frame();
+    manager.begin_frame();
+    const size_t c = manager.create_buffer(300, BufferUsage::vertex);
+    XCTAssertNotEqual(manager.get_buffer_offset(c), a_offset);
+    manager.end_frame();
+
+    // two frames later the first one is known to be done
+    manager.complete_frame();
+    manager.begin_frame();
+    const size_t d = manager.create_buffer(300, BufferUsage::vertex);
+    XCTAssertEqual(manager.get_buffer_offset(d), a_offset);
+    manager.end_frame();
+    manager.complete_frame();
+}
+
+- (void)testBufferReleasedBeforeFirstFrameIsFreeAtOnce {
+    CpuBufferManager manager(make_settings());
+
+    const size_t a = manager.create_buffer(300, BufferUsage::vertex);
+    const size_t a_offset = manager.get_buffer_offset(a);
+    manager.release_buffer(a);
+
+    const size_t b = manager.create_buffer(300, BufferUsage::vertex);
+    XCTAssertEqual(manager.get_buffer_offset(b), a_offset);
+}
+
+@end
@@ -0,0 +1,211 @@
+//
+//  VirtualTextureTests.mm
+//  AngryKitTests
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "virtual_texture.hpp"
+
+using namespace angry;
+
+@interface VirtualTextureTests : XCTestCase
+
+@end
+
+@implementation VirtualTextureTests
+
+- (void)testPageIdParts {
+    const PageId id = make_page_id(3, 100, 200);
+    XCTAssertEqual(get_page_level(id), 3);
+    XCTAssertEqual(get_page_x(id), 100);
+    XCTAssertEqual(get_page_y(id), 200);
+    XCTAssertEqual(get_parent_page(id), make_page_id(4, 50, 100));
+}
+
+- (void)testPageTableFallsBackToCoarserPage {
+    PageTable table(8);
+    XCTAssertEqual(table.get_level_count(), 4);
+    XCTAssertEqual(table.get_page_count(1), 4);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 5, 5)).slot, invalid_slot);
+
+    table.map(make_page_id(3, 0, 0), 0);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 7, 7)).slot, 0);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 7, 7)).level, 3);
+
+    table.map(make_page_id(1, 1, 1), 5);
+    table.map(make_page_id(0, 2, 2), 7);
+    XCTAssertEqual(table.get_entry(make_page_id(1, 1, 1)).slot, 5);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 3, 3)).slot, 5);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 2, 2)).slot, 7);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 0, 0)).slot, 0);
+
+    // a coarser page mapped later does not hide a finer one
+    table.map(make_page_id(2, 0, 0), 9);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 2, 2)).slot, 7);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 3, 3)).slot, 5);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 0, 0)).slot, 9);
+
+    table.unmap(make_page_id(1, 1, 1));
+    XCTAssertEqual(table.get_entry(make_page_id(1, 1, 1)).slot, 9);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 3, 3)).slot, 9);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 2, 2)).slot, 7);
+
+    table.unmap(make_page_id(0, 2, 2));
+    XCTAssertEqual(table.get_entry(make_page_id(0, 2, 2)).slot, 9);
+    XCTAssertEqual(table.get_entry(make_page_id(0, 2, 2)).level, 2);
+}
+
+- (void)testPageTableNeedsPowerOfTwo {
+    XCTAssertThrows(PageTable{6});
+}
+
+- (void)testCacheEvictsLeastRecentlyUsed {
+    PhysicalPageCache cache(3);
+    const PageId a = make_page_id(0, 0, 0);
+    const PageId b = make_page_id(0, 1, 0);
+    const PageId c = make_page_id(0, 2, 0);
+    const PageId d = make_page_id(0, 3, 0);
+
+    PageId evicted = invalid_page;
+    for (PageId id : {a, b, c})
+    {
+        const auto slot = cache.reserve(1, evicted);
+        XCTAssertTrue(slot.has_value());
+        XCTAssertEqual(evicted, invalid_page);
+        cache.commit(*slot, id, 1, false);
+    }
+    XCTAssertEqual(cache.get_resident_count(), 3);
+
+    cache.touch(*cache.find(a), 2);
+    const auto slot = cache.reserve(2, evicted);
+    XCTAssertEqual(evicted, b);
+    XCTAssertFalse(cache.find(b).has_value());
+    // a reserved slot belongs to no page until the load is done
+    XCTAssertEqual(cache.get_page(*slot), invalid_page);
+    XCTAssertEqual(cache.get_resident_count(), 2);
+
+    cache.commit(*slot, d, 2, false);
+    XCTAssertEqual(*cache.find(d), *slot);
+
+    // c is the only page not used in frame 2
+    cache.reserve(2, evicted);
+    XCTAssertEqual(evicted, c);
+    XCTAssertTrue(cache.find(a).has_value());
+}
+
+- (void)testCacheKeepsPinnedAndCurrentPages {
+    PhysicalPageCache cache(3);
+    const PageId root = make_page_id(3, 0, 0);
+    const PageId a = make_page_id(0, 0, 0);
+
+    PageId evicted = invalid_page;
+    cache.commit(*cache.reserve(1, evicted), root, 1, true);
+    cache.commit(*cache.reserve(1, evicted), a, 1, false);
+
+    // the last slot waits for a load
+    XCTAssertTrue(cache.reserve(1, evicted).has_value());
+    XCTAssertFalse(cache.can_reserve(1));
+    XCTAssertFalse(cache.reserve(1, evicted).has_value());
+
+    XCTAssertTrue(cache.can_reserve(2));
+    cache.reserve(2, evicted);
+    XCTAssertEqual(evicted, a);
+
+    XCTAssertFalse(cache.reserve(3, evicted).has_value());
+    XCTAssertEqual(*cache.find(root), 0);
+}
+
+- (void)testFeedbackIsMergedWithAncestors {
+    const PageId a = make_page_id(0, 1, 1);
+    const PageId b = make_page_id(0, 2, 2);
+    const std::vector<PageId> feedback = {a, a, a, invalid_page, a, b, make_page_id(0, 9, 0), make_page_id(5, 0, 0)};
+
+    std::vector<PageRequest> requests;
+    analyze_feedback(feedback.data(), feedback.size(), 4, requests);
+
+    XCTAssertEqual(requests.size(), 6);
+    for (size_t i = 1; i < requests.size(); i++)
+    {
+        XCTAssertLessThan(requests[i - 1].id, requests[i].id);
+    }
+
+    const auto find = [&](PageId id) {
+        for (const auto& request : requests)
+        {
+            if (request.id == id)
+            {
+                return request;
+            }
+        }
+        return PageRequest();
+    };
+
+    XCTAssertEqual(find(a).count, 4);
+    XCTAssertTrue(find(a).is_requested);
+    XCTAssertEqual(find(b).count, 1);
+    XCTAssertEqual(find(make_page_id(1, 0, 0)).count, 4);
+    XCTAssertFalse(find(make_page_id(1, 0, 0)).is_requested);
+    XCTAssertEqual(find(make_page_id(1, 1, 1)).count, 1);
+    XCTAssertEqual(find(make_page_id(2, 0, 0)).count, 5);
+    XCTAssertEqual(find(make_page_id(3, 0, 0)).count, 5);
+}
+
+- (void)testEveryStartedLoadIsApplied {
+    VirtualTexture::Settings settings;
+    settings.page_count = 8;
+    settings.page_size = 4;
+    settings.page_border = 1;
+    settings.physical_page_count = 6;
+    settings.max_pending_count = 16;
+
+    std::atomic<size_t> produced_count(0);
+    VirtualTexture texture(settings, [&](PageId id, int size, uint8_t* pixels) {
+        std::memset(pixels, int(id & 0xff), size_t(size) * size_t(size) * 4);
+        produced_count += 1;
+    });
+    texture.take_uploads();
+
+    // far more pages than slots, every frame asks for another part of the finest level
+    std::vector<PageId> feedback;
+    for (uint32_t frame = 0; frame < 32; frame++)
+    {
+        feedback.clear();
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            const uint32_t page = (frame * 4 + i) % 64;
+            feedback.push_back(make_page_id(0, page % 8, page / 8));
+        }
+        texture.update(feedback.data(), feedback.size());
+
+        const auto& statistics = texture.get_statistics();
+        XCTAssertLessThanOrEqual(statistics.resident_count + statistics.pending_count, settings.physical_page_count);
+    }
+    texture.flush();
+
+    const auto& statistics = texture.get_statistics();
+    XCTAssertEqual(statistics.pending_count, 0);
+    XCTAssertGreaterThan(statistics.eviction_count, 0);
+    // the coarsest page is loaded by the constructor
+    XCTAssertEqual(statistics.load_count, produced_count.load());
+    XCTAssertEqual(statistics.load_count, statistics.resident_count + statistics.eviction_count);
+
+    // the page table points to the slots the pages went to
+    for (const auto& upload : texture.take_uploads())
+    {
+        const auto& entry = texture.get_page_table().get_entry(upload.id);
+        if (entry.level == get_page_level(upload.id))
+        {
+            XCTAssertEqual(entry.slot, upload.slot);
+        }
+        XCTAssertEqual(upload.pixels[0], uint8_t(upload.id & 0xff));
+    }
+}
+
+@end
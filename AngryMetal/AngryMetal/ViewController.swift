@@ -22,8 +22,10 @@ final class ViewController: UIViewController {
         return view
     }()
 
+    private let assetsURL = Bundle.main.bundleURL.appendingPathComponent("Assets")
+
     private lazy var game: Game = {
-        return Game(assetsURL: Bundle.main.bundleURL.appendingPathComponent("Assets"))
+        return Game(assetsURL: assetsURL)
     }()
 
     private var touchState: [UITouch: CGPoint] = [:]
@@ -36,7 +38,51 @@ final class ViewController: UIViewController {
         super.viewDidLoad()
 
         DispatchQueue.global().async {
-            self.setup()
+            // launch with -load-benchmark [-cold] to print the load report instead of playing,
+            // -compression-report [-quality] prints texture compression results,
+            // -virtual-texture-benchmark prints page residency of a simulated floor flyover,
+            // -texture-streaming-benchmark prints mip levels streamed for cooked textures,
+            // -simulation-benchmark [-soak] [-zero-allocations] runs the game systems with scripted input,
+            // -cook-textures cooks the bundled textures first and plays with them, -build-pack packs the
+            // bundled assets first and plays from assets.pack, a simulator bundle is writable
+            let arguments = ProcessInfo.processInfo.arguments
+            if arguments.contains("-cook-textures") || arguments.contains("-build-pack") {
+                if arguments.contains("-cook-textures") {
+                    self.cookTextures()
+                }
+                if arguments.contains("-build-pack") {
+                    self.buildPack()
+                }
+                self.setup()
+            } else if arguments.contains("-load-benchmark") {
+                self.runLoadBenchmark()
+            } else if arguments.contains("-compression-report") {
+                self.runCompressionReport()
+            } else if arguments.contains("-virtual-texture-benchmark") {
+                self.runVirtualTextureBenchmark()
+            } else if arguments.contains("-texture-streaming-benchmark") {
+                self.runTextureStreamingBenchmark()
+            } else if arguments.contains("-simulation-benchmark") {
+                self.runSimulationBenchmark()
+            } else {
+                self.setup()
+            }
+        }
+    }
+
+    override func didReceiveMemoryWarning() {
+        super.didReceiveMemoryWarning()
+
+        // what was live when the system asked for memory back, only once the game runs
+        guard !metalView.isPaused,
+              let cachesURL = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else {
+            return
+        }
+
+        do {
+            try game.writeMemoryReport(to: cachesURL.appendingPathComponent("memory_report.json"))
+        } catch {
+            print("ERROR: \(error)")
         }
     }
 
@@ -84,6 +130,70 @@ final class ViewController: UIViewController {
         }
     }
 
+    private func runLoadBenchmark() {
+        let isCold = ProcessInfo.processInfo.arguments.contains("-cold")
+        do {
+            print(try Game.runLoadBenchmark(withAssetsURL: assetsURL, cold: isCold, runCount: 5))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func buildPack() {
+        do {
+            print(try Game.buildPack(withAssetsURL: assetsURL))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func cookTextures() {
+        do {
+            print(try Game.cookTextures(withAssetsURL: assetsURL))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func runCompressionReport() {
+        let isQuality = ProcessInfo.processInfo.arguments.contains("-quality")
+        do {
+            print(try Game.runCompressionReport(withAssetsURL: assetsURL, quality: isQuality))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func runSimulationBenchmark() {
+        // an hour of game time instead of a minute
+        let isSoak = ProcessInfo.processInfo.arguments.contains("-soak")
+        // fails the run if gameplay allocates after warmup, debug builds count allocations
+        let requireZeroAllocations = ProcessInfo.processInfo.arguments.contains("-zero-allocations")
+        do {
+            print(try Game.runSimulationBenchmark(withAssetsURL: assetsURL,
+                                                  frameCount: isSoak ? 216_000 : 3_600,
+                                                  requireZeroAllocations: requireZeroAllocations))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func runVirtualTextureBenchmark() {
+        do {
+            print(try Game.runVirtualTextureBenchmark())
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
+    private func runTextureStreamingBenchmark() {
+        do {
+            print(try Game.runTextureStreamingBenchmark(withAssetsURL: assetsURL))
+        } catch {
+            print("ERROR: \(error)")
+        }
+    }
+
     private func start() {
         metalView.isPaused = false
     }
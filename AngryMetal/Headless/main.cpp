@@ -0,0 +1,179 @@
+//
+//  main.cpp
+//  AngryMetal
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "asset_storage.hpp"
+#include "component_storage_benchmark.hpp"
+#include "meshlet_culling_benchmark.hpp"
+#include "texture_streaming_benchmark.hpp"
+#include "virtual_texture_benchmark.hpp"
+
+#if defined(ANGRY_HAS_IMAGE)
+#include "compression_report.hpp"
+#include "texture_cooker.hpp"
+#endif
+
+#if defined(ANGRY_HAS_GAME)
+#include "simulation_benchmark.hpp"
+#endif
+
+using namespace angry;
+
+namespace
+{
+
+// same launch arguments as the app, plus -frame-count and -assets which the app doesn't need
+class Arguments
+{
+public:
+    Arguments(int argc, char* argv[]) : _values(argv + 1, argv + argc)
+    {
+    }
+
+    bool contains(const std::string& name) const
+    {
+        for (const auto& value : _values)
+        {
+            if (value == name)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string get(const std::string& name, const std::string& fallback) const
+    {
+        for (size_t i = 0; i + 1 < _values.size(); i++)
+        {
+            if (_values[i] == name)
+            {
+                return _values[i + 1];
+            }
+        }
+        return fallback;
+    }
+
+private:
+    std::vector<std::string> _values;
+};
+
+void run(const Arguments& arguments)
+{
+    const auto assets_path = arguments.get("-assets", "AngryMetal/Assets");
+
+    if (arguments.contains("-virtual-texture-benchmark"))
+    {
+        VirtualTextureBenchmarkSettings settings;
+        settings.frame_count = std::stoul(arguments.get("-frame-count", std::to_string(settings.frame_count)));
+        run_virtual_texture_benchmark(settings, std::cout);
+        return;
+    }
+
+    if (arguments.contains("-component-storage-benchmark"))
+    {
+        ComponentStorageBenchmarkSettings settings;
+        settings.entity_count = std::stoul(arguments.get("-entity-count", std::to_string(settings.entity_count)));
+        settings.frame_count = std::stoul(arguments.get("-frame-count", std::to_string(settings.frame_count)));
+        run_component_storage_benchmark(settings, std::cout);
+        return;
+    }
+
+    if (arguments.contains("-meshlet-culling-benchmark"))
+    {
+        MeshletCullingBenchmarkSettings settings;
+        settings.frame_count = std::stoul(arguments.get("-frame-count", std::to_string(settings.frame_count)));
+        run_meshlet_culling_benchmark(settings, std::cout);
+        return;
+    }
+
+    if (arguments.contains("-build-pack"))
+    {
+        build_asset_pack(assets_path, std::cout);
+        return;
+    }
+
+    if (arguments.contains("-texture-streaming-benchmark"))
+    {
+        TextureStreamingBenchmarkSettings settings;
+        settings.assets_path = assets_path;
+        settings.frame_count = std::stoul(arguments.get("-frame-count", std::to_string(settings.frame_count)));
+        run_texture_streaming_benchmark(settings, std::cout);
+        return;
+    }
+
+    if (arguments.contains("-compression-report"))
+    {
+#if defined(ANGRY_HAS_IMAGE)
+        CompressionReportSettings settings;
+        settings.assets_path = assets_path;
+        settings.preset = arguments.contains("-quality") ? CompressionPreset::quality : CompressionPreset::fast;
+        run_compression_report(settings, std::cout);
+        return;
+#else
+        throw std::runtime_error("run() built without stb, no compression report");
+#endif
+    }
+
+    if (arguments.contains("-cook-textures"))
+    {
+#if defined(ANGRY_HAS_IMAGE)
+        // ASTC for the device unless -desktop is given
+        TextureCookSettings settings;
+        settings.is_desktop = arguments.contains("-desktop");
+        settings.preset = arguments.contains("-fast") ? CompressionPreset::fast : CompressionPreset::quality;
+        run_texture_cooker(assets_path, settings, std::cout);
+        return;
+#else
+        throw std::runtime_error("run() built without stb, no texture cooker");
+#endif
+    }
+
+    if (arguments.contains("-simulation-benchmark"))
+    {
+#if defined(ANGRY_HAS_GAME)
+        SimulationBenchmarkSettings settings;
+        settings.assets_path = assets_path;
+        // an hour of game time instead of a minute
+        settings.frame_count = arguments.contains("-soak") ? 216000 : 3600;
+        settings.frame_count = std::stoul(arguments.get("-frame-count", std::to_string(settings.frame_count)));
+        settings.require_zero_allocations = arguments.contains("-zero-allocations");
+        run_simulation_benchmark(settings, std::cout);
+        return;
+#else
+        throw std::runtime_error("run() built without the third party libraries, no simulation benchmark");
+#endif
+    }
+
+    throw std::runtime_error("run() usage: angry_headless -build-pack [-assets PATH] | -virtual-texture-benchmark | "
+                             "-component-storage-benchmark [-entity-count N] [-frame-count N] | "
+                             "-meshlet-culling-benchmark [-frame-count N] | "
+                             "-texture-streaming-benchmark [-frame-count N] [-assets PATH] | -compression-report [-quality] | "
+                             "-cook-textures [-desktop] [-fast] [-assets PATH] | "
+                             "-simulation-benchmark [-soak] [-zero-allocations] [-frame-count N] [-assets PATH]");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        run(Arguments(argc, argv));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
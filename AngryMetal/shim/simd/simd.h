@@ -0,0 +1,248 @@
+//
+//  simd.h
+//  AngryKit
+//
+//  Created by  Ivan Ushakov on 19.10.2026.
+//
+
+#pragma once
+
+// Portable stand-in for the part of Apple <simd/simd.h> AngryKit uses, so the platform
+// independent code builds with CMake on other systems. Only for host builds, Xcode targets
+// use the real header. Vectors are plain structs, not clang vector extensions.
+
+#include <math.h>
+#include <stdint.h>
+
+namespace angry::simd_shim
+{
+
+// read only swizzle which lives in the same union as the vector
+template<typename V, int N, int... I>
+struct Swizzle
+{
+    float data[N];
+
+    operator V() const
+    {
+        return V{data[I]...};
+    }
+};
+
+}
+
+struct simd_float2
+{
+    float x, y;
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+};
+
+union alignas(16) simd_float3
+{
+    struct
+    {
+        float x, y, z;
+    };
+    angry::simd_shim::Swizzle<simd_float2, 4, 0, 2> xz;
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+};
+
+union alignas(16) simd_float4
+{
+    struct
+    {
+        float x, y, z, w;
+    };
+    angry::simd_shim::Swizzle<simd_float3, 4, 0, 1, 2> xyz;
+    angry::simd_shim::Swizzle<simd_float2, 4, 0, 2> xz;
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+};
+
+struct simd_int2
+{
+    int x, y;
+
+    int& operator[](int i) { return (&x)[i]; }
+    int operator[](int i) const { return (&x)[i]; }
+};
+
+struct simd_float3x3
+{
+    simd_float3 columns[3];
+};
+
+struct simd_float4x4
+{
+    simd_float4 columns[4];
+};
+
+static const simd_float4x4 matrix_identity_float4x4 = {{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 0.0f, 1.0f}
+}};
+
+// float2
+
+inline simd_float2 operator+(simd_float2 a, simd_float2 b) { return {a.x + b.x, a.y + b.y}; }
+inline simd_float2 operator-(simd_float2 a, simd_float2 b) { return {a.x - b.x, a.y - b.y}; }
+inline simd_float2 operator*(simd_float2 a, simd_float2 b) { return {a.x * b.x, a.y * b.y}; }
+inline simd_float2 operator*(simd_float2 a, float s) { return {a.x * s, a.y * s}; }
+inline simd_float2 operator*(float s, simd_float2 a) { return a * s; }
+inline simd_float2 operator/(simd_float2 a, float s) { return {a.x / s, a.y / s}; }
+inline simd_float2 operator-(simd_float2 a) { return {-a.x, -a.y}; }
+inline simd_float2& operator+=(simd_float2& a, simd_float2 b) { return a = a + b; }
+inline simd_float2& operator-=(simd_float2& a, simd_float2 b) { return a = a - b; }
+inline simd_float2& operator*=(simd_float2& a, float s) { return a = a * s; }
+
+inline float simd_dot(simd_float2 a, simd_float2 b) { return a.x * b.x + a.y * b.y; }
+inline float simd_length(simd_float2 a) { return sqrtf(simd_dot(a, a)); }
+inline float simd_distance(simd_float2 a, simd_float2 b) { return simd_length(a - b); }
+inline simd_float2 simd_normalize(simd_float2 a) { return a / simd_length(a); }
+
+// float3
+
+inline simd_float3 operator+(simd_float3 a, simd_float3 b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline simd_float3 operator-(simd_float3 a, simd_float3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline simd_float3 operator*(simd_float3 a, simd_float3 b) { return {a.x * b.x, a.y * b.y, a.z * b.z}; }
+inline simd_float3 operator/(simd_float3 a, simd_float3 b) { return {a.x / b.x, a.y / b.y, a.z / b.z}; }
+inline simd_float3 operator*(simd_float3 a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+inline simd_float3 operator*(float s, simd_float3 a) { return a * s; }
+inline simd_float3 operator/(simd_float3 a, float s) { return {a.x / s, a.y / s, a.z / s}; }
+inline simd_float3 operator-(simd_float3 a) { return {-a.x, -a.y, -a.z}; }
+inline simd_float3& operator+=(simd_float3& a, simd_float3 b) { return a = a + b; }
+inline simd_float3& operator-=(simd_float3& a, simd_float3 b) { return a = a - b; }
+inline simd_float3& operator*=(simd_float3& a, simd_float3 b) { return a = a * b; }
+inline simd_float3& operator*=(simd_float3& a, float s) { return a = a * s; }
+inline simd_float3& operator/=(simd_float3& a, float s) { return a = a / s; }
+
+inline float simd_dot(simd_float3 a, simd_float3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline float simd_length(simd_float3 a) { return sqrtf(simd_dot(a, a)); }
+inline float simd_distance(simd_float3 a, simd_float3 b) { return simd_length(a - b); }
+inline simd_float3 simd_normalize(simd_float3 a) { return a / simd_length(a); }
+inline simd_float3 vector_normalize(simd_float3 a) { return simd_normalize(a); }
+
+inline simd_float3 simd_cross(simd_float3 a, simd_float3 b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+inline simd_float3 simd_min(simd_float3 a, simd_float3 b) { return {fminf(a.x, b.x), fminf(a.y, b.y), fminf(a.z, b.z)}; }
+inline simd_float3 simd_max(simd_float3 a, simd_float3 b) { return {fmaxf(a.x, b.x), fmaxf(a.y, b.y), fmaxf(a.z, b.z)}; }
+
+// float4
+
+inline simd_float4 operator+(simd_float4 a, simd_float4 b) { return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w}; }
+inline simd_float4 operator-(simd_float4 a, simd_float4 b) { return {a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w}; }
+inline simd_float4 operator*(simd_float4 a, float s) { return {a.x * s, a.y * s, a.z * s, a.w * s}; }
+inline simd_float4 operator*(float s, simd_float4 a) { return a * s; }
+inline simd_float4 operator/(simd_float4 a, float s) { return {a.x / s, a.y / s, a.z / s, a.w / s}; }
+inline simd_float4 operator-(simd_float4 a) { return {-a.x, -a.y, -a.z, -a.w}; }
+inline simd_float4& operator+=(simd_float4& a, simd_float4 b) { return a = a + b; }
+inline simd_float4& operator*=(simd_float4& a, float s) { return a = a * s; }
+inline simd_float4& operator/=(simd_float4& a, float s) { return a = a / s; }
+
+inline float simd_dot(simd_float4 a, simd_float4 b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+inline float simd_length(simd_float4 a) { return sqrtf(simd_dot(a, a)); }
+
+inline simd_float4 simd_make_float4(simd_float3 a, float w) { return {a.x, a.y, a.z, w}; }
+inline simd_float4 simd_make_float4(float x, float y, float z, float w) { return {x, y, z, w}; }
+
+// int2, comparisons give -1 for true like clang vectors
+
+inline simd_int2 operator+(simd_int2 a, simd_int2 b) { return {a.x + b.x, a.y + b.y}; }
+inline simd_int2 operator-(simd_int2 a, simd_int2 b) { return {a.x - b.x, a.y - b.y}; }
+inline simd_int2 operator*(simd_int2 a, simd_int2 b) { return {a.x * b.x, a.y * b.y}; }
+inline simd_int2 operator==(simd_int2 a, simd_int2 b) { return {a.x == b.x ? -1 : 0, a.y == b.y ? -1 : 0}; }
+inline simd_int2 operator!=(simd_int2 a, simd_int2 b) { return {a.x != b.x ? -1 : 0, a.y != b.y ? -1 : 0}; }
+
+inline bool simd_all(simd_int2 a) { return a.x < 0 && a.y < 0; }
+inline bool simd_any(simd_int2 a) { return a.x < 0 || a.y < 0; }
+inline simd_int2 simd_abs(simd_int2 a) { return {a.x < 0 ? -a.x : a.x, a.y < 0 ? -a.y : a.y}; }
+inline int simd_reduce_add(simd_int2 a) { return a.x + a.y; }
+inline int simd_reduce_max(simd_int2 a) { return a.x > a.y ? a.x : a.y; }
+
+// scalar
+
+inline float simd_clamp(float x, float min, float max) { return fminf(fmaxf(x, min), max); }
+inline float simd_mix(float x, float y, float t) { return x + t * (y - x); }
+
+// matrices, column major like the real header
+
+inline float simd_determinant(simd_float3x3 m)
+{
+    return simd_dot(m.columns[0], simd_cross(m.columns[1], m.columns[2]));
+}
+
+inline simd_float4 simd_mul(simd_float4x4 m, simd_float4 v)
+{
+    return m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z + m.columns[3] * v.w;
+}
+
+inline simd_float4x4 simd_mul(simd_float4x4 a, simd_float4x4 b)
+{
+    return {{simd_mul(a, b.columns[0]), simd_mul(a, b.columns[1]), simd_mul(a, b.columns[2]), simd_mul(a, b.columns[3])}};
+}
+
+inline simd_float4x4 simd_transpose(simd_float4x4 m)
+{
+    simd_float4x4 r;
+    for (int c = 0; c < 4; c++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            r.columns[c][i] = m.columns[i][c];
+        }
+    }
+    return r;
+}
+
+inline simd_float4x4 simd_inverse(simd_float4x4 m)
+{
+    // cofactors, m[c][r] is column c and row r
+    float a[16];
+    for (int c = 0; c < 4; c++)
+    {
+        for (int r = 0; r < 4; r++)
+        {
+            a[c * 4 + r] = m.columns[c][r];
+        }
+    }
+
+    float b[16];
+    b[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    b[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    b[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    b[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    b[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    b[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    b[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    b[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    b[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    b[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    b[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    b[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    b[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    b[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    b[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    b[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    const float d = 1.0f / (a[0] * b[0] + a[1] * b[4] + a[2] * b[8] + a[3] * b[12]);
+
+    simd_float4x4 r;
+    for (int c = 0; c < 4; c++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            r.columns[c][i] = b[c * 4 + i] * d;
+        }
+    }
+    return r;
+}